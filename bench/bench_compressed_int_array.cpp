@@ -0,0 +1,110 @@
+// Бенчмарк: CompressedIntArray против несжатого DynamicArray.
+// Для трёх колонок (ID из узкого диапазона, монотонные метки времени,
+// случайные 64-битные значения) выводит степень сжатия, скорость полного
+// прохода с суммированием и время доступа по случайному индексу.
+//
+// Запуск: lab5_bench_compressed_int_array [значений] [случайных_обращений]
+// По умолчанию 10M значений и 1M обращений.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "compressed_int_array.h"
+#include "custom_memory_resource.h"
+
+template <typename Fn>
+static double elapsed_ms(Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T, typename Gen>
+static void run(const char *name, size_t n, size_t lookups, Gen gen)
+{
+    CustomMemoryResource mr;
+    DynamicArray<T> plain(&mr);
+    plain.resize_uninitialized(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        plain[i] = gen();
+    }
+    CompressedIntArray<T> packed(&mr);
+    double build_ms = elapsed_ms([&]
+                                 { packed.append(plain); });
+
+    uint64_t plain_sum = 0;
+    uint64_t packed_sum = 0;
+    double plain_scan = elapsed_ms([&]
+                                   {
+                                       for (T value : plain)
+                                       {
+                                           plain_sum += value;
+                                       } });
+    double packed_scan = elapsed_ms([&]
+                                    { packed.for_each_block([&packed_sum](const T *values, size_t count)
+                                                            {
+                                                                for (size_t i = 0; i < count; ++i)
+                                                                {
+                                                                    packed_sum += values[i];
+                                                                } }); });
+    if (plain_sum != packed_sum)
+    {
+        std::cerr << "Суммы не совпали!\n";
+        std::exit(1);
+    }
+
+    std::mt19937_64 rng(n);
+    std::vector<size_t> indices(lookups);
+    for (size_t &index : indices)
+    {
+        index = rng() % n;
+    }
+    uint64_t sink = 0;
+    double plain_lookup = elapsed_ms([&]
+                                     {
+                                         for (size_t index : indices)
+                                         {
+                                             sink += plain[index];
+                                         } });
+    double packed_lookup = elapsed_ms([&]
+                                      {
+                                          for (size_t index : indices)
+                                          {
+                                              sink += packed[index];
+                                          } });
+
+    const double bytes = static_cast<double>(n * sizeof(T));
+    std::cout << name << " | " << packed.get_compression_ratio()
+              << " | " << bytes / plain_scan / 1e6 << " | " << bytes / packed_scan / 1e6
+              << " | " << plain_lookup * 1e6 / static_cast<double>(lookups)
+              << " | " << packed_lookup * 1e6 / static_cast<double>(lookups)
+              << " | " << build_ms << (sink == 42 ? " " : "") << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 10000000;
+    size_t lookups = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 1000000;
+
+    std::cout << "Значений: " << n << "\n";
+    std::cout << "колонка | сжатие, раз | проход DynamicArray, ГБ/с | проход сжатого, ГБ/с"
+              << " | доступ DynamicArray, нс | доступ сжатого, нс | сжатие, мс\n";
+
+    std::mt19937 rng(1);
+    run<uint32_t>("ID uint32_t (0..1023)", n, lookups, [&rng]
+                  { return static_cast<uint32_t>(rng() % 1024); });
+
+    uint64_t now = 1700000000000000ull;
+    run<uint64_t>("метки времени uint64_t", n, lookups, [&rng, &now]
+                  { return now += 1000 + rng() % 100; });
+
+    std::mt19937_64 rng64(2);
+    run<uint64_t>("случайные uint64_t", n, lookups, [&rng64]
+                  { return rng64(); });
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Бенчмарк: добавление из N потоков в общий массив.
+// Сравниваются DynamicArray под мьютексом, ConcurrentAppendArray::push_back
+// и ConcurrentAppendArray::append пачками.
+//
+// Запуск: lab5_bench_concurrent_append [максимум_потоков] [элементов_на_поток]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "concurrent_append_array.h"
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+
+template <typename Body>
+static double measure(int threads, Body body)
+{
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(body, t);
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    unsigned hardware = std::thread::hardware_concurrency();
+    int max_threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(hardware == 0 ? 4 : hardware);
+    size_t per_thread = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+    const size_t batch = 256;
+
+    std::cout << "Элементов на поток: " << per_thread << "\n";
+    std::cout << "потоки | мьютекс, M/с | push_back, M/с | append(" << batch << "), M/с\n";
+
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        const double total = static_cast<double>(per_thread) * threads;
+
+        double locked_time;
+        {
+            CustomMemoryResource mr;
+            DynamicArray<uint64_t> arr(&mr);
+            std::mutex mutex;
+            locked_time = measure(threads, [&](int t)
+                                  {
+                                      for (size_t i = 0; i < per_thread; ++i)
+                                      {
+                                          std::lock_guard<std::mutex> lock(mutex);
+                                          arr.push_back(t * per_thread + i);
+                                      }
+                                  });
+        }
+
+        double push_time;
+        {
+            CustomMemoryResource mr;
+            ConcurrentAppendArray<uint64_t> arr(&mr);
+            push_time = measure(threads, [&](int t)
+                                {
+                                    for (size_t i = 0; i < per_thread; ++i)
+                                    {
+                                        arr.push_back(t * per_thread + i);
+                                    }
+                                });
+        }
+
+        double batch_time;
+        {
+            CustomMemoryResource mr;
+            ConcurrentAppendArray<uint64_t> arr(&mr);
+            batch_time = measure(threads, [&](int t)
+                                 {
+                                     uint64_t buffer[batch];
+                                     for (size_t i = 0; i < per_thread; i += batch)
+                                     {
+                                         size_t count = per_thread - i < batch ? per_thread - i : batch;
+                                         for (size_t j = 0; j < count; ++j)
+                                         {
+                                             buffer[j] = t * per_thread + i + j;
+                                         }
+                                         arr.append(buffer, count);
+                                     }
+                                 });
+        }
+
+        std::cout << threads << " | "
+                  << total / locked_time / 1e6 << " | "
+                  << total / push_time / 1e6 << " | "
+                  << total / batch_time / 1e6 << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+// Бенчмарк: раздача снимка конфигурации потребителям.
+// Сравнивает глубокое копирование DynamicArray с копированием CowDynamicArray,
+// когда каждый потребитель только читает снимок, а каждый сотый его меняет.
+//
+// Запуск: lab5_bench_cow_dynamic_array [элементов] [потребителей]
+// По умолчанию 100K элементов и 10K потребителей.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include "cow_dynamic_array.h"
+#include "custom_memory_resource.h"
+
+template <typename Fn>
+static double elapsed_ms(Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    size_t consumers = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 10000;
+
+    CustomMemoryResource mr;
+    DynamicArray<uint64_t> plain(&mr);
+    CowDynamicArray<uint64_t> shared(&mr);
+    for (size_t i = 0; i < n; ++i)
+    {
+        plain.push_back(i);
+        shared.push_back(i);
+    }
+
+    uint64_t plain_sum = 0;
+    double plain_ms = elapsed_ms([&]
+                                 {
+                                     for (size_t c = 0; c < consumers; ++c)
+                                     {
+                                         DynamicArray<uint64_t> snapshot(plain);
+                                         if (c % 100 == 0)
+                                         {
+                                             snapshot[0] = c;
+                                         }
+                                         plain_sum += snapshot[c % n];
+                                     } });
+
+    uint64_t cow_sum = 0;
+    double cow_ms = elapsed_ms([&]
+                               {
+                                   for (size_t c = 0; c < consumers; ++c)
+                                   {
+                                       CowDynamicArray<uint64_t> snapshot(shared);
+                                       if (c % 100 == 0)
+                                       {
+                                           snapshot[0] = c;
+                                       }
+                                       cow_sum += snapshot.get(c % n);
+                                   } });
+
+    if (plain_sum != cow_sum)
+    {
+        std::cerr << "Суммы не совпали!\n";
+        return 1;
+    }
+
+    std::cout << "Элементов: " << n << ", потребителей: " << consumers << "\n";
+    std::cout << "DynamicArray (глубокая копия): " << plain_ms << " мс\n";
+    std::cout << "CowDynamicArray:               " << cow_ms << " мс\n";
+    std::cout << "Ускорение: " << plain_ms / cow_ms << "x\n";
+    return 0;
+}
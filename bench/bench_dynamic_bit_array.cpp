@@ -0,0 +1,129 @@
+// Бенчмарк: маски фильтров в DynamicArray<bool> и в DynamicBitArray.
+// Сравнивает занимаемую память, подсчёт единиц и пересечение двух масок,
+// а также скорость каждого доступного способа подсчёта единиц.
+//
+// Запуск: lab5_bench_dynamic_bit_array [битов] [повторов]
+// По умолчанию 64M битов и 20 повторов.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "custom_memory_resource.h"
+#include "dynamic_bit_array.h"
+
+template <typename Fn>
+static double elapsed_ms(Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static const char *path_name(PopcountPath path)
+{
+    switch (path)
+    {
+    case PopcountPath::Portable:
+        return "переносимый";
+    case PopcountPath::Popcnt:
+        return "POPCNT";
+    case PopcountPath::Avx2:
+        return "AVX2";
+    case PopcountPath::Avx512:
+        return "AVX-512";
+    }
+    return "?";
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 64 * 1024 * 1024;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    CustomMemoryResource mr;
+    DynamicArray<bool> bytes_a(&mr);
+    DynamicArray<bool> bytes_b(&mr);
+    DynamicBitArray bits_a(&mr);
+    DynamicBitArray bits_b(&mr);
+    std::mt19937_64 rng(1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const uint64_t r = rng();
+        bytes_a.push_back(r & 1);
+        bytes_b.push_back((r >> 1) & 1);
+        bits_a.push_back(r & 1);
+        bits_b.push_back((r >> 1) & 1);
+    }
+
+    std::cout << "Битов: " << n << "\n";
+    std::cout << "Память: DynamicArray<bool> " << bytes_a.capacity() / 1024 << " КБ, DynamicBitArray "
+              << bits_a.words_count() * sizeof(uint64_t) / 1024 << " КБ\n\n";
+
+    size_t byte_count = 0;
+    size_t bit_count = 0;
+    double byte_count_ms = elapsed_ms([&]
+                                      {
+                                          for (int r = 0; r < repeats; ++r)
+                                          {
+                                              for (bool value : bytes_a)
+                                              {
+                                                  byte_count += value;
+                                              }
+                                          } });
+    double bit_count_ms = elapsed_ms([&]
+                                     {
+                                         for (int r = 0; r < repeats; ++r)
+                                         {
+                                             bit_count += bits_a.count();
+                                         } });
+
+    double byte_and_ms = elapsed_ms([&]
+                                    {
+                                        for (int r = 0; r < repeats; ++r)
+                                        {
+                                            for (size_t i = 0; i < n; ++i)
+                                            {
+                                                bytes_a[i] = bytes_a[i] && bytes_b[i];
+                                            }
+                                        } });
+    double bit_and_ms = elapsed_ms([&]
+                                   {
+                                       for (int r = 0; r < repeats; ++r)
+                                       {
+                                           bits_a &= bits_b;
+                                       } });
+    if (byte_count != bit_count || bytes_a[n / 2] != bits_a[n / 2])
+    {
+        std::cerr << "Результаты не совпали!\n";
+        return 1;
+    }
+
+    std::cout << "операция | DynamicArray<bool>, мс | DynamicBitArray, мс | ускорение\n";
+    std::cout << "count | " << byte_count_ms / repeats << " | " << bit_count_ms / repeats << " | "
+              << byte_count_ms / bit_count_ms << "x\n";
+    std::cout << "&= | " << byte_and_ms / repeats << " | " << bit_and_ms / repeats << " | "
+              << byte_and_ms / bit_and_ms << "x\n\n";
+
+    std::cout << "Подсчёт единиц (выбран: " << path_name(bit_array_detail::best_popcount_path()) << ")\n";
+    std::cout << "способ | ГБ/с\n";
+    for (PopcountPath path : {PopcountPath::Portable, PopcountPath::Popcnt, PopcountPath::Avx2, PopcountPath::Avx512})
+    {
+        if (!bit_array_detail::popcount_supported(path))
+        {
+            std::cout << path_name(path) << " | не поддерживается\n";
+            continue;
+        }
+        size_t sink = 0;
+        double ms = elapsed_ms([&]
+                               {
+                                   for (int r = 0; r < repeats; ++r)
+                                   {
+                                       sink += bit_array_detail::popcount_words(path, bits_b.words(), bits_b.words_count());
+                                   } });
+        const double total_bytes = static_cast<double>(bits_b.words_count() * sizeof(uint64_t)) * repeats;
+        std::cout << path_name(path) << " | " << total_bytes / ms / 1e6 << (sink == 1 ? " " : "") << "\n";
+    }
+    return 0;
+}
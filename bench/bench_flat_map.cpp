@@ -0,0 +1,129 @@
+// Бенчмарк: поиск в FlatMap (отсортированный массив и Eytzinger, одиночный и
+// пакетный поиск) против std::map и std::unordered_map.
+// Число ключей растёт в 10 раз от 1K до заданного максимума; ключи случайные
+// uint64_t, запросы - случайные существующие ключи.
+//
+// Запуск: lab5_bench_flat_map [макс_ключей] [запросов]
+// По умолчанию до 1M ключей; 100M требует порядка 10 ГБ памяти (из-за std::map).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "custom_memory_resource.h"
+#include "flat_map.h"
+
+// Время одного поиска в наносекундах; sink не даёт компилятору выбросить поиск
+template <typename Lookup>
+static double measure(const std::vector<uint64_t> &queries, Lookup lookup, uint64_t &sink)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t key : queries)
+    {
+        sink += lookup(key);
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / static_cast<double>(queries.size());
+}
+
+template <typename Map>
+static double measure_batch(const Map &map, const std::vector<uint64_t> &queries, uint64_t &sink)
+{
+    constexpr size_t kChunk = 256;
+    const uint64_t *results[kChunk];
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < queries.size(); i += kChunk)
+    {
+        const size_t count = std::min(kChunk, queries.size() - i);
+        map.find_batch(queries.data() + i, count, results);
+        for (size_t j = 0; j < count; ++j)
+        {
+            sink += *results[j];
+        }
+    }
+    double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / static_cast<double>(queries.size());
+}
+
+static void run(size_t key_count, size_t query_count)
+{
+    std::mt19937_64 rng(key_count);
+    std::vector<uint64_t> keys(key_count);
+    for (uint64_t &key : keys)
+    {
+        key = rng();
+    }
+    std::vector<uint64_t> queries(query_count);
+    for (uint64_t &query : queries)
+    {
+        query = keys[rng() % key_count];
+    }
+
+    uint64_t sink = 0;
+    double tree;
+    {
+        std::map<uint64_t, uint64_t> map;
+        for (uint64_t key : keys)
+        {
+            map.emplace(key, key);
+        }
+        tree = measure(queries, [&map](uint64_t key)
+                       { return map.find(key)->second; }, sink);
+    }
+
+    double hash;
+    {
+        std::unordered_map<uint64_t, uint64_t> map;
+        map.reserve(key_count);
+        for (uint64_t key : keys)
+        {
+            map.emplace(key, key);
+        }
+        hash = measure(queries, [&map](uint64_t key)
+                       { return map.find(key)->second; }, sink);
+    }
+
+    CustomMemoryResource mr;
+    FlatMap<uint64_t, uint64_t> flat(&mr, FlatMapLayout::Sorted);
+    for (uint64_t key : keys)
+    {
+        flat.insert(key, key);
+    }
+    auto build_start = std::chrono::steady_clock::now();
+    flat.build();
+    double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+
+    double sorted = measure(queries, [&flat](uint64_t key)
+                            { return *flat.find(key); }, sink);
+    double sorted_batch = measure_batch(flat, queries, sink);
+
+    flat.set_layout(FlatMapLayout::Eytzinger);
+    double eytzinger = measure(queries, [&flat](uint64_t key)
+                               { return *flat.find(key); }, sink);
+    double eytzinger_batch = measure_batch(flat, queries, sink);
+
+    std::cout << key_count << " | " << tree << " | " << hash << " | "
+              << sorted << " | " << sorted_batch << " | "
+              << eytzinger << " | " << eytzinger_batch << " | "
+              << build_ms << (sink == 42 ? " " : "") << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    size_t max_keys = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+    size_t query_count = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 1000000;
+
+    std::cout << "Запросов: " << query_count << ", время одного поиска в нс\n";
+    std::cout << "ключей | std::map | std::unordered_map | flat | flat пакетом"
+              << " | eytzinger | eytzinger пакетом | build, мс\n";
+    for (size_t keys = 1000; keys <= max_keys; keys *= 10)
+    {
+        run(keys, query_count);
+    }
+    return 0;
+}
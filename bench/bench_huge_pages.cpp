@@ -0,0 +1,159 @@
+// Бенчмарк: случайная выборка (random gather) из большого DynamicArray<uint64_t>
+// с обычными 4 КБ страницами и с путём для больших выделений (2 МБ страницы).
+//
+// Запуск: lab5_bench_huge_pages [размер_массива_МБ] [число_обращений] [hugetlb]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Счётчик промахов dTLB через perf_event_open (только Linux).
+// Если счётчик недоступен (нет прав, виртуализация), read() возвращает -1
+class TlbMissCounter
+{
+public:
+    TlbMissCounter()
+    {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~TlbMissCounter()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+#endif
+    }
+
+    void start()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0)
+        {
+            ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    long long stop()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0)
+        {
+            ::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            long long value = 0;
+            if (::read(fd_, &value, sizeof(value)) == sizeof(value))
+            {
+                return value;
+            }
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int fd_{-1};
+};
+
+static uint64_t xorshift(uint64_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static void run(const char *name, CustomMemoryResource &mr, size_t elements,
+                const DynamicArray<uint32_t> &indices)
+{
+    DynamicArray<uint64_t> data(elements, &mr);
+    for (size_t i = 0; i < elements; ++i)
+    {
+        data[i] = i;
+    }
+
+    TlbMissCounter counter;
+    uint64_t sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    counter.start();
+    for (uint32_t index : indices)
+    {
+        sum += data[index];
+    }
+    long long misses = counter.stop();
+    auto finish = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(finish - start).count();
+    std::cout << name << ": "
+              << indices.size() / seconds / 1e6 << " M обращений/с, "
+              << "dTLB промахов: ";
+    if (misses >= 0)
+    {
+        std::cout << misses;
+    }
+    else
+    {
+        std::cout << "n/a";
+    }
+    std::cout << ", mmap-блоков: " << mr.get_mapped_blocks_count()
+              << " (контрольная сумма " << sum << ")\n";
+}
+
+int main(int argc, char **argv)
+{
+    size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512;
+    size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000000;
+    bool hugetlb = argc > 3 && std::strcmp(argv[3], "hugetlb") == 0;
+
+    size_t elements = megabytes * 1024 * 1024 / sizeof(uint64_t);
+
+    // Индексы генерируем заранее, чтобы в замер попадала только выборка
+    DynamicArray<uint32_t> indices;
+    indices.reserve(lookups);
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < lookups; ++i)
+    {
+        indices.push_back(static_cast<uint32_t>(xorshift(state) % elements));
+    }
+
+    std::cout << "Массив: " << megabytes << " МБ, обращений: " << lookups << "\n";
+
+    {
+        CustomMemoryResource mr;
+        run("4 КБ страницы   ", mr, elements, indices);
+    }
+    {
+        CustomMemoryResource mr;
+        mr.set_large_allocation_threshold(PageAllocator::kHugePageSize, hugetlb);
+        run("2 МБ страницы   ", mr, elements, indices);
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Бенчмарк: политики размещения CustomMemoryResource на журнале выделений.
+// Журнал (формат TraceRecorder, см. allocation_trace.h) проигрывается одинаково
+// для FirstFit, BestFit и GoodFit; сравниваются время, объём памяти, взятой
+// у ОС, число блоков и внутренняя фрагментация.
+//
+// Запуск: lab5_bench_placement_policies [журнал] [waste_ratio]
+// Журнал можно записать TraceRecorder'ом или командой lab5_replay --record-demo.
+// Без журнала записывается синтетическая нагрузка со смесью мелких и крупных блоков.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "allocation_trace.h"
+#include "custom_memory_resource.h"
+
+struct LiveBlock
+{
+    void *ptr;
+    size_t bytes;
+};
+
+// Синтетическая нагрузка: 70% мелких, 25% средних, 5% крупных блоков, случайное время жизни
+static void record_synthetic(std::ostream &out, size_t operations)
+{
+    CustomMemoryResource mr;
+    TraceRecorder recorder(out);
+    mr.add_observer(&recorder);
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<LiveBlock> live;
+
+    for (size_t i = 0; i < operations; ++i)
+    {
+        if (!live.empty() && unit(rng) < 0.45)
+        {
+            size_t index = static_cast<size_t>(unit(rng) * live.size());
+            mr.deallocate(live[index].ptr, live[index].bytes);
+            live[index] = live.back();
+            live.pop_back();
+            continue;
+        }
+
+        double kind = unit(rng);
+        size_t bytes;
+        if (kind < 0.70)
+        {
+            bytes = 16 + static_cast<size_t>(unit(rng) * 240);
+        }
+        else if (kind < 0.95)
+        {
+            bytes = 256 + static_cast<size_t>(unit(rng) * 3840);
+        }
+        else
+        {
+            bytes = 4096 + static_cast<size_t>(unit(rng) * 61440);
+        }
+        live.push_back({mr.allocate(bytes), bytes});
+    }
+
+    // Оставшиеся блоки в журнале остаются живыми до конца
+    mr.remove_observer(&recorder);
+    for (const LiveBlock &block : live)
+    {
+        mr.deallocate(block.ptr, block.bytes);
+    }
+}
+
+static void replay(const char *name, PlacementPolicy policy, double waste_ratio, const TraceProgram &program)
+{
+    CustomMemoryResource mr;
+    mr.set_placement_policy(policy, waste_ratio);
+    size_t peak_waste = 0;
+
+    TraceReplayStats stats = replay_trace(program, mr,
+                                          [&mr, &peak_waste](const TraceReplayStats &progress)
+                                          {
+                                              // Потери считаются обходом всех блоков, поэтому только изредка
+                                              if ((progress.allocations + progress.deallocations) % 1024 == 0)
+                                              {
+                                                  peak_waste = std::max(peak_waste, mr.get_internal_waste_bytes());
+                                              }
+                                          });
+
+    // Ресурс не возвращает память до release_free_blocks: текущий объём и есть пик
+    std::cout << name << " | " << stats.seconds * 1000.0 << " | "
+              << mr.get_footprint_bytes() / 1024 << " | "
+              << mr.get_allocated_blocks_count() + mr.get_free_blocks_count() << " | "
+              << peak_waste / 1024 << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::stringstream synthetic;
+    std::ifstream file;
+    std::istream *in = &synthetic;
+    if (argc > 1)
+    {
+        file.open(argv[1], std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Не удалось открыть журнал " << argv[1] << "\n";
+            return 1;
+        }
+        in = &file;
+    }
+    else
+    {
+        record_synthetic(synthetic, 20000);
+    }
+    double waste_ratio = argc > 2 ? std::atof(argv[2]) : 0.25;
+
+    try
+    {
+        TraceReader reader(*in);
+        TraceProgram program(reader);
+
+        std::cout << "Операций в журнале: " << program.steps().size() << "\n";
+        std::cout << "политика | время, мс | взято у ОС, КБ | блоков | пиковые потери, КБ\n";
+        replay("first-fit", PlacementPolicy::FirstFit, waste_ratio, program);
+        replay("best-fit", PlacementPolicy::BestFit, waste_ratio, program);
+        replay("good-fit", PlacementPolicy::GoodFit, waste_ratio, program);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Бенчмарк: задержки первых запросов после запуска с прогревом ресурса и без.
+// Сначала "рабочий" ресурс проходит установившийся режим (массивы случайных
+// размеров), с него снимается профиль; затем два новых ресурса - холодный и
+// прогретый по профилю - обслуживают одну и ту же последовательность запросов.
+// Во всех ресурсах BestFit, чтобы поиск по списку из тысяч блоков не заслонял
+// разницу между кэшем и ::operator new.
+//
+// Запуск: lab5_bench_prewarm [запросов] [массивов_одновременно]
+// По умолчанию 2000 запросов (окно "сразу после запуска") и 2000 живых массивов.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "custom_memory_resource.h"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+struct Request
+{
+    size_t slot;
+    size_t bytes;
+};
+
+static std::vector<Request> make_requests(size_t count, size_t slots)
+{
+    std::mt19937 rng(7);
+    std::vector<Request> requests(count);
+    for (Request &request : requests)
+    {
+        // Размеры как у типичных буферов: 64 Б .. 64 КБ, степени двойки
+        request.slot = rng() % slots;
+        request.bytes = size_t(64) << (rng() % 11);
+    }
+    return requests;
+}
+
+// Проигрывает запросы: слот освобождает старый буфер и берёт новый; возвращает задержки в нс
+static std::vector<double> replay(CustomMemoryResource &mr, const std::vector<Request> &requests, size_t slots)
+{
+    std::vector<void *> ptrs(slots, nullptr);
+    std::vector<size_t> sizes(slots, 0);
+    std::vector<double> latencies;
+    latencies.reserve(requests.size());
+
+    for (const Request &request : requests)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (ptrs[request.slot])
+        {
+            mr.deallocate(ptrs[request.slot], sizes[request.slot], 16);
+        }
+        void *ptr = mr.allocate(request.bytes, 16);
+        std::memset(ptr, 1, request.bytes); // Запрос пишет в буфер, как реальный код
+        latencies.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        ptrs[request.slot] = ptr;
+        sizes[request.slot] = request.bytes;
+    }
+
+    for (size_t slot = 0; slot < slots; ++slot)
+    {
+        if (ptrs[slot])
+        {
+            mr.deallocate(ptrs[slot], sizes[slot], 16);
+        }
+    }
+    return latencies;
+}
+
+static void report(const char *name, std::vector<double> latencies, double setup_ms)
+{
+    std::sort(latencies.begin(), latencies.end());
+    auto at = [&latencies](double q)
+    {
+        return latencies[static_cast<size_t>(q * static_cast<double>(latencies.size() - 1))];
+    };
+    double total = 0;
+    for (double value : latencies)
+    {
+        total += value;
+    }
+    std::cout << name << " | " << at(0.5) << " | " << at(0.99) << " | " << latencies.back()
+              << " | " << total / 1e6 << " | " << setup_ms << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 2000;
+    size_t slots = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 2000;
+
+    // Установившийся режим "прошлого запуска"
+    WarmProfile profile;
+    {
+        CustomMemoryResource steady;
+        steady.set_placement_policy(PlacementPolicy::BestFit);
+        replay(steady, make_requests(count * 5, slots), slots);
+        profile = steady.capture_warm_profile();
+    }
+#ifdef __GLIBC__
+    // Как после перезапуска: память прошлого режима не должна остаться в куче подгруженной
+    malloc_trim(0);
+#endif
+    std::cout << "Профиль: " << profile.get_blocks_count() << " блоков, "
+              << profile.get_total_bytes() / 1024 << " КБ\n";
+    std::cout << "ресурс | p50, нс | p99, нс | max, нс | всего, мс | прогрев, мс\n";
+
+    const std::vector<Request> requests = make_requests(count, slots);
+    {
+        CustomMemoryResource cold;
+        cold.set_placement_policy(PlacementPolicy::BestFit);
+        report("холодный", replay(cold, requests, slots), 0.0);
+    }
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+    {
+        CustomMemoryResource warm;
+        warm.set_placement_policy(PlacementPolicy::BestFit);
+        auto start = std::chrono::steady_clock::now();
+        warm.prewarm(profile);
+        double setup_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        report("прогретый", replay(warm, requests, slots), setup_ms);
+    }
+    return 0;
+}
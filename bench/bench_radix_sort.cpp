@@ -0,0 +1,114 @@
+// Бенчмарк: radix_sort и parallel_radix_sort против std::sort на DynamicArray.
+// Для каждого типа ключей (uint32_t, uint64_t, double, записи по полю)
+// один и тот же случайный массив сортируется всеми способами.
+//
+// Запуск: lab5_bench_radix_sort [элементов] [потоков]
+// По умолчанию 10M элементов и потоки по числу ядер.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include "custom_memory_resource.h"
+#include "radix_sort.h"
+
+struct Record
+{
+    uint32_t id;
+    int32_t age;
+    double score;
+};
+
+template <typename T, typename Fill, typename Sort>
+static double time_sort(size_t n, Fill fill, Sort sort)
+{
+    CustomMemoryResource mr;
+    DynamicArray<T> arr(&mr);
+    arr.resize_uninitialized(n);
+    fill(arr);
+
+    auto start = std::chrono::steady_clock::now();
+    sort(arr);
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (!std::is_sorted(arr.begin(), arr.end(), [](const T &a, const T &b)
+                        {
+                            if constexpr (std::is_arithmetic<T>::value)
+                            {
+                                return a < b;
+                            }
+                            else
+                            {
+                                return a.age < b.age;
+                            } }))
+    {
+        std::cerr << "Массив не отсортирован!\n";
+        std::exit(1);
+    }
+    return elapsed;
+}
+
+template <typename T, typename Fill>
+static void run_numbers(const char *name, size_t n, size_t threads, Fill fill)
+{
+    double std_ms = time_sort<T>(n, fill, [](DynamicArray<T> &arr)
+                                 { std::sort(arr.begin(), arr.end()); });
+    double radix_ms = time_sort<T>(n, fill, [](DynamicArray<T> &arr)
+                                   { radix_sort(arr); });
+    double parallel_ms = time_sort<T>(n, fill, [threads](DynamicArray<T> &arr)
+                                      { parallel_radix_sort(arr, threads); });
+    std::cout << name << " | " << std_ms << " | " << radix_ms << " | " << parallel_ms << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 10000000;
+    size_t threads = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "Элементов: " << n << ", потоков: " << threads << "\n";
+    std::cout << "тип | std::sort, мс | radix_sort, мс | parallel_radix_sort, мс\n";
+
+    run_numbers<uint32_t>("uint32_t", n, threads, [](DynamicArray<uint32_t> &arr)
+                          {
+                              std::mt19937 rng(1);
+                              for (uint32_t &value : arr)
+                              {
+                                  value = rng();
+                              } });
+    run_numbers<uint64_t>("uint64_t", n, threads, [](DynamicArray<uint64_t> &arr)
+                          {
+                              std::mt19937_64 rng(2);
+                              for (uint64_t &value : arr)
+                              {
+                                  value = rng();
+                              } });
+    run_numbers<double>("double", n, threads, [](DynamicArray<double> &arr)
+                        {
+                            std::mt19937_64 rng(3);
+                            std::normal_distribution<double> dist(0.0, 1e6);
+                            for (double &value : arr)
+                            {
+                                value = dist(rng);
+                            } });
+
+    auto fill_records = [](DynamicArray<Record> &arr)
+    {
+        std::mt19937 rng(4);
+        for (size_t i = 0; i < arr.size(); ++i)
+        {
+            arr[i] = {static_cast<uint32_t>(i), static_cast<int32_t>(rng() % 100), 0.0};
+        }
+    };
+    double std_ms = time_sort<Record>(n, fill_records, [](DynamicArray<Record> &arr)
+                                      { std::stable_sort(arr.begin(), arr.end(), [](const Record &a, const Record &b)
+                                                         { return a.age < b.age; }); });
+    double radix_ms = time_sort<Record>(n, fill_records, [](DynamicArray<Record> &arr)
+                                        { radix_sort(arr, [](const Record &r)
+                                                     { return r.age; }); });
+    std::cout << "Record.age (устойчиво) | " << std_ms << " | " << radix_ms << " | -\n";
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef ALLOCATION_OBSERVER_H
+#define ALLOCATION_OBSERVER_H
+
+#include <cstddef>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LAB5_NOINLINE __attribute__((noinline))
+#define LAB5_RETURN_ADDRESS() __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define LAB5_NOINLINE __declspec(noinline)
+#define LAB5_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define LAB5_NOINLINE
+#define LAB5_RETURN_ADDRESS() nullptr
+#endif
+
+/**
+ * Наблюдатель за операциями memory_resource.
+ * Подключается к CustomMemoryResource через add_observer() и получает
+ * уведомление о каждом выделении и освобождении блока.
+ */
+class AllocationObserver
+{
+public:
+    virtual ~AllocationObserver() = default;
+
+    virtual void on_allocate(void *ptr, size_t bytes, size_t alignment) = 0;
+    virtual void on_deallocate(void *ptr, size_t bytes, size_t alignment) = 0;
+};
+
+/**
+ * Граница между ресурсом и вызвавшим его кодом для наблюдателей, снимающих стек.
+ *
+ * Внешняя точка входа ресурса (do_allocate, allocate_batch, медленный путь
+ * ThreadCacheResource) запоминает свой адрес возврата на время вызова;
+ * вложенные вызовы ресурсов его не перезаписывают. Сколько бы кадров
+ * аллокатора ни было между наблюдателем и вызывающим кодом, стек можно
+ * обрезать ровно по этому адресу.
+ */
+class AllocationCallSite
+{
+public:
+    class Scope
+    {
+    public:
+        // nullptr - граница не нужна (например, наблюдателей нет)
+        explicit Scope(void *return_address)
+            : owner_(return_address != nullptr && slot() == nullptr)
+        {
+            if (owner_)
+            {
+                slot() = return_address;
+            }
+        }
+
+        ~Scope()
+        {
+            if (owner_)
+            {
+                slot() = nullptr;
+            }
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        bool owner_;
+    };
+
+    // Адрес возврата в вызвавший ресурс код или nullptr вне выделения
+    static void *current() { return slot(); }
+
+private:
+    static void *&slot()
+    {
+        thread_local void *site = nullptr;
+        return site;
+    }
+};
+
+#endif // ALLOCATION_OBSERVER_H
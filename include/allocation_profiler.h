@@ -0,0 +1,309 @@
+#ifndef ALLOCATION_PROFILER_H
+#define ALLOCATION_PROFILER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "allocation_observer.h"
+
+#if defined(__has_include)
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define LAB5_HAS_BACKTRACE 1
+#endif
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define LAB5_HAS_CXXABI 1
+#endif
+#endif
+
+/**
+ * Сэмплирующий профилировщик выделений памяти.
+ *
+ * В среднем один раз на каждые sample_period байт (интервалы между сэмплами
+ * распределены экспоненциально, как в tcmalloc) снимается стек вызовов.
+ * Для каждого места вызова хранится оценка живой кучи и общего объёма
+ * выделений; profile выгружается в формате folded stacks
+ * ("frame;frame;frame bytes"), который понимают flamegraph.pl и pprof.
+ *
+ * Между сэмплами на выделение тратится одно вычитание и сравнение, а на
+ * освобождение - проверка пустоты таблицы живых сэмплов (или один поиск в ней).
+ */
+class AllocationProfiler : public AllocationObserver
+{
+public:
+    // Максимальная глубина сохраняемого стека
+    static constexpr int kMaxFrames = 32;
+
+    // Статистика по одному месту вызова
+    struct SiteStats
+    {
+        size_t live_samples{0};
+        double live_bytes{0};  // Оценка живых байт с учётом вероятности сэмпла
+        size_t total_samples{0};
+        double total_bytes{0}; // Оценка всех выделенных этим стеком байт
+    };
+
+    explicit AllocationProfiler(size_t sample_period = 512 * 1024, uint64_t seed = 0x5EED)
+        : sample_period_(sample_period == 0 ? 1 : sample_period), rng_(seed)
+    {
+        bytes_until_sample_ = next_interval();
+    }
+
+    void on_allocate(void *ptr, size_t bytes, size_t /*alignment*/) override
+    {
+        if (bytes < bytes_until_sample_)
+        {
+            bytes_until_sample_ -= bytes;
+            return;
+        }
+        record_sample(ptr, bytes);
+    }
+
+    void on_deallocate(void *ptr, size_t /*bytes*/, size_t /*alignment*/) override
+    {
+        if (live_.empty())
+        {
+            return;
+        }
+
+        auto it = live_.find(ptr);
+        if (it == live_.end())
+        {
+            return;
+        }
+
+        SiteStats &site = sites_[it->second.site];
+        --site.live_samples;
+        site.live_bytes -= it->second.weight;
+        if (site.live_samples == 0)
+        {
+            site.live_bytes = 0; // Убираем накопленную погрешность double
+        }
+        live_.erase(it);
+    }
+
+    // Выгружает профиль живой кучи (или всех выделений, если live_only == false)
+    void write_folded(std::ostream &os, bool live_only = true) const
+    {
+        for (const auto &entry : sites_)
+        {
+            double value = live_only ? entry.second.live_bytes : entry.second.total_bytes;
+            if (value <= 0)
+            {
+                continue;
+            }
+
+            const Stack &stack = entry.first;
+            // В folded-формате корень стека идёт первым
+            for (int i = stack.depth - 1; i >= 0; --i)
+            {
+                os << symbolize(stack.frames[i]);
+                if (i != 0)
+                {
+                    os << ';';
+                }
+            }
+            if (stack.depth == 0)
+            {
+                os << "[unknown]";
+            }
+            os << ' ' << static_cast<unsigned long long>(std::llround(value)) << '\n';
+        }
+    }
+
+    void reset()
+    {
+        sites_.clear();
+        live_.clear();
+        bytes_until_sample_ = next_interval();
+    }
+
+    size_t get_sample_period() const { return sample_period_; }
+    size_t get_live_samples_count() const { return live_.size(); }
+    size_t get_sites_count() const { return sites_.size(); }
+
+    // Суммарная оценка живых байт по всем местам вызова
+    double get_estimated_live_bytes() const
+    {
+        double total = 0;
+        for (const auto &entry : sites_)
+        {
+            total += entry.second.live_bytes;
+        }
+        return total;
+    }
+
+private:
+    struct Stack
+    {
+        void *frames[kMaxFrames]{};
+        int depth{0};
+
+        bool operator==(const Stack &other) const
+        {
+            return depth == other.depth &&
+                   std::equal(frames, frames + depth, other.frames);
+        }
+    };
+
+    struct StackHash
+    {
+        size_t operator()(const Stack &stack) const
+        {
+            // FNV-1a по адресам кадров
+            uint64_t hash = 1469598103934665603ull;
+            for (int i = 0; i < stack.depth; ++i)
+            {
+                hash ^= reinterpret_cast<uintptr_t>(stack.frames[i]);
+                hash *= 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct LiveSample
+    {
+        Stack site;
+        double weight{0};
+    };
+
+    size_t next_interval()
+    {
+        std::exponential_distribution<double> distribution(1.0 / static_cast<double>(sample_period_));
+        double interval = distribution(rng_);
+        return interval < 1.0 ? 1 : static_cast<size_t>(interval);
+    }
+
+    LAB5_NOINLINE void record_sample(void *ptr, size_t bytes)
+    {
+        bytes_until_sample_ = next_interval();
+
+        // Несмещённая оценка: блок размера bytes попадает в сэмпл с вероятностью
+        // 1 - exp(-bytes / period), поэтому его вес равен bytes / эта вероятность
+        double probability = 1.0 - std::exp(-static_cast<double>(bytes) / static_cast<double>(sample_period_));
+        double weight = probability > 0 ? static_cast<double>(bytes) / probability : static_cast<double>(bytes);
+
+        Stack stack = capture_stack();
+
+        SiteStats &site = sites_[stack];
+        ++site.live_samples;
+        site.live_bytes += weight;
+        ++site.total_samples;
+        site.total_bytes += weight;
+
+        live_[ptr] = LiveSample{stack, weight};
+    }
+
+    LAB5_NOINLINE static Stack capture_stack()
+    {
+        Stack stack;
+#ifdef LAB5_HAS_BACKTRACE
+        // Кадры аллокатора между наблюдателем и вызывающим кодом: глубина зависит
+        // от точки входа (do_allocate, allocate_batch, ThreadCacheResource)
+        constexpr int kMaxAllocatorFrames = 16;
+        void *frames[kMaxFrames + kMaxAllocatorFrames];
+        int depth = ::backtrace(frames, kMaxFrames + kMaxAllocatorFrames);
+
+        // Обрезаем по адресу возврата внешней точки входа ресурса; без него
+        // пропускаем capture_stack, record_sample, on_allocate и do_allocate
+        int first = 4;
+        if (void *site = AllocationCallSite::current())
+        {
+            for (int i = 0; i < depth; ++i)
+            {
+                if (frames[i] == site)
+                {
+                    first = i;
+                    break;
+                }
+            }
+        }
+        for (int i = first; i < depth && stack.depth < kMaxFrames; ++i)
+        {
+            stack.frames[stack.depth++] = frames[i];
+        }
+#endif
+        return stack;
+    }
+
+    static std::string symbolize(void *frame)
+    {
+#ifdef LAB5_HAS_BACKTRACE
+        char **symbols = ::backtrace_symbols(&frame, 1);
+        if (symbols)
+        {
+            // Формат glibc: "module(symbol+0xoff) [0xaddr]"
+            std::string text = symbols[0];
+            std::free(symbols);
+
+            size_t open = text.find('(');
+            size_t plus = text.find('+', open);
+            if (open != std::string::npos && plus != std::string::npos && plus > open + 1)
+            {
+                std::string mangled = text.substr(open + 1, plus - open - 1);
+#ifdef LAB5_HAS_CXXABI
+                int status = 0;
+                char *demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+                if (status == 0 && demangled)
+                {
+                    std::string name = demangled;
+                    std::free(demangled);
+                    return sanitize(name);
+                }
+#endif
+                return sanitize(mangled);
+            }
+
+            // Символ не найден: оставляем "module+0xoff", чтобы адрес можно было разрешить офлайн
+            size_t close = text.find(')', open);
+            if (open != std::string::npos && close != std::string::npos)
+            {
+                std::string module = text.substr(0, open);
+                size_t slash = module.find_last_of('/');
+                if (slash != std::string::npos)
+                {
+                    module = module.substr(slash + 1);
+                }
+                return sanitize(module + text.substr(open + 1, close - open - 1));
+            }
+        }
+#endif
+        char buffer[2 + 2 * sizeof(void *) + 1];
+        std::snprintf(buffer, sizeof(buffer), "%p", frame);
+        return buffer;
+    }
+
+    // В folded-формате ';' разделяет кадры, а пробел отделяет значение
+    static std::string sanitize(std::string name)
+    {
+        for (char &c : name)
+        {
+            if (c == ';')
+            {
+                c = ':';
+            }
+            else if (c == ' ')
+            {
+                c = '_';
+            }
+        }
+        return name;
+    }
+
+    size_t sample_period_;
+    size_t bytes_until_sample_{0};
+    std::mt19937_64 rng_;
+
+    std::unordered_map<Stack, SiteStats, StackHash> sites_;
+    std::unordered_map<void *, LiveSample> live_;
+};
+
+#endif // ALLOCATION_PROFILER_H
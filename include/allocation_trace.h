@@ -0,0 +1,348 @@
+#ifndef ALLOCATION_TRACE_H
+#define ALLOCATION_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "allocation_observer.h"
+
+/**
+ * Бинарный журнал выделений памяти.
+ *
+ * Формат: заголовок "LAB5TRC\0" + varint версии, затем записи подряд:
+ *   байт:   op (биты 0-1) | log2(alignment) << 2
+ *   varint: время с предыдущей записи, нс
+ *   varint: id блока (выдаётся по порядку выделения)
+ *   varint: размер в байтах (только у выделения)
+ * Типичная запись занимает 4-8 байт; вместо адресов хранятся id, поэтому
+ * журнал не зависит от раскладки адресного пространства при проигрывании.
+ */
+enum class TraceOp : uint8_t
+{
+    Allocate = 1,
+    Deallocate = 2
+};
+
+struct TraceRecord
+{
+    uint64_t timestamp_ns{0}; // Время от начала записи
+    TraceOp op{TraceOp::Allocate};
+    uint64_t id{0};
+    size_t size{0};      // 0 у освобождения
+    size_t alignment{0};
+};
+
+namespace allocation_trace_detail
+{
+    constexpr char kMagic[8] = {'L', 'A', 'B', '5', 'T', 'R', 'C', '\0'};
+    constexpr uint64_t kVersion = 1;
+
+    inline void put_varint(std::string &out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    inline unsigned log2_alignment(size_t alignment)
+    {
+        unsigned shift = 0;
+        while ((size_t(1) << shift) < alignment && shift < 63)
+        {
+            ++shift;
+        }
+        return shift;
+    }
+}
+
+/**
+ * Запись журнала: подключается к CustomMemoryResource как наблюдатель
+ * (mr.add_observer(&recorder)). Записи копятся в буфере и сбрасываются
+ * в поток кусками по kFlushThreshold байт, поэтому на операцию приходится
+ * чтение часов, поиск в хеш-таблице и несколько байт в буфер.
+ */
+class TraceRecorder : public AllocationObserver
+{
+public:
+    static constexpr size_t kFlushThreshold = 64 * 1024;
+
+    explicit TraceRecorder(std::ostream &out) : out_(out), last_(std::chrono::steady_clock::now())
+    {
+        buffer_.reserve(kFlushThreshold + 64);
+        buffer_.append(allocation_trace_detail::kMagic, sizeof(allocation_trace_detail::kMagic));
+        allocation_trace_detail::put_varint(buffer_, allocation_trace_detail::kVersion);
+    }
+
+    ~TraceRecorder() override
+    {
+        flush();
+    }
+
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+    void on_allocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        const uint64_t id = next_id_++;
+        live_ids_[ptr] = id;
+        append(TraceOp::Allocate, id, bytes, alignment);
+    }
+
+    void on_deallocate(void *ptr, size_t /*bytes*/, size_t alignment) override
+    {
+        auto it = live_ids_.find(ptr);
+        if (it == live_ids_.end())
+        {
+            return; // Блок выделен до начала записи
+        }
+        const uint64_t id = it->second;
+        live_ids_.erase(it);
+        append(TraceOp::Deallocate, id, 0, alignment);
+    }
+
+    // Сбрасывает накопленные записи в поток
+    void flush()
+    {
+        if (!buffer_.empty())
+        {
+            out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+            buffer_.clear();
+        }
+        out_.flush();
+    }
+
+    size_t get_records_count() const { return records_; }
+
+private:
+    void append(TraceOp op, uint64_t id, size_t bytes, size_t alignment)
+    {
+        using namespace allocation_trace_detail;
+
+        const auto now = std::chrono::steady_clock::now();
+        const uint64_t delta = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count());
+        last_ = now;
+
+        buffer_.push_back(static_cast<char>(static_cast<unsigned>(op) | (log2_alignment(alignment) << 2)));
+        put_varint(buffer_, delta);
+        put_varint(buffer_, id);
+        if (op == TraceOp::Allocate)
+        {
+            put_varint(buffer_, bytes);
+        }
+        ++records_;
+
+        if (buffer_.size() >= kFlushThreshold)
+        {
+            out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+            buffer_.clear();
+        }
+    }
+
+    std::ostream &out_;
+    std::string buffer_;
+    std::unordered_map<void *, uint64_t> live_ids_;
+    uint64_t next_id_{0};
+    size_t records_{0};
+    std::chrono::steady_clock::time_point last_;
+};
+
+// Последовательное чтение журнала, записанного TraceRecorder
+class TraceReader
+{
+public:
+    explicit TraceReader(std::istream &in) : in_(in)
+    {
+        char magic[sizeof(allocation_trace_detail::kMagic)];
+        in_.read(magic, sizeof(magic));
+        if (!in_ || std::memcmp(magic, allocation_trace_detail::kMagic, sizeof(magic)) != 0)
+        {
+            throw std::runtime_error("TraceReader: это не журнал выделений LAB5TRC");
+        }
+        if (read_varint() != allocation_trace_detail::kVersion)
+        {
+            throw std::runtime_error("TraceReader: неподдерживаемая версия журнала");
+        }
+    }
+
+    // Читает следующую запись; false в конце журнала
+    bool next(TraceRecord &record)
+    {
+        const int head = in_.get();
+        if (head == std::char_traits<char>::eof())
+        {
+            return false;
+        }
+
+        const unsigned op = static_cast<unsigned>(head) & 0x3;
+        if (op != static_cast<unsigned>(TraceOp::Allocate) && op != static_cast<unsigned>(TraceOp::Deallocate))
+        {
+            throw std::runtime_error("TraceReader: повреждённая запись журнала");
+        }
+        record.op = static_cast<TraceOp>(op);
+        record.alignment = size_t(1) << (static_cast<unsigned>(head) >> 2);
+        time_ += read_varint();
+        record.timestamp_ns = time_;
+        record.id = read_varint();
+        record.size = record.op == TraceOp::Allocate ? static_cast<size_t>(read_varint()) : 0;
+        return true;
+    }
+
+private:
+    uint64_t read_varint()
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            const int byte = in_.get();
+            if (byte == std::char_traits<char>::eof())
+            {
+                throw std::runtime_error("TraceReader: неожиданный конец журнала");
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::runtime_error("TraceReader: повреждённое число в журнале");
+    }
+
+    std::istream &in_;
+    uint64_t time_{0};
+};
+
+// Итоги проигрывания журнала
+struct TraceReplayStats
+{
+    size_t allocations{0};
+    size_t deallocations{0};
+    double seconds{0};           // Время проигрывания (журнал заранее загружен в память)
+    uint64_t recorded_ns{0};     // Длительность исходной записи
+    size_t peak_live_bytes{0};   // Пик запрошенных и ещё не освобождённых байт
+    size_t live_blocks_at_end{0};
+
+    double ops_per_second() const
+    {
+        return seconds > 0 ? static_cast<double>(allocations + deallocations) / seconds : 0.0;
+    }
+};
+
+/**
+ * Журнал, загруженный в память и подготовленный к проигрыванию: id блоков
+ * заменены плотными номерами слотов, чтобы в измеряемом цикле не было хеш-таблиц.
+ */
+class TraceProgram
+{
+public:
+    struct Step
+    {
+        bool allocate;
+        size_t slot;
+        size_t size;
+        size_t alignment;
+    };
+
+    explicit TraceProgram(TraceReader &reader)
+    {
+        std::unordered_map<uint64_t, size_t> slots;
+        TraceRecord record;
+        while (reader.next(record))
+        {
+            recorded_ns_ = record.timestamp_ns;
+            if (record.op == TraceOp::Allocate)
+            {
+                const size_t slot = slots_count_++;
+                slots[record.id] = slot;
+                steps_.push_back({true, slot, record.size, record.alignment});
+                continue;
+            }
+            auto it = slots.find(record.id);
+            if (it != slots.end())
+            {
+                steps_.push_back({false, it->second, 0, 0});
+                slots.erase(it);
+            }
+        }
+    }
+
+    const std::vector<Step> &steps() const { return steps_; }
+    size_t slots_count() const { return slots_count_; }
+    uint64_t recorded_ns() const { return recorded_ns_; }
+
+private:
+    std::vector<Step> steps_;
+    size_t slots_count_{0};
+    uint64_t recorded_ns_{0};
+};
+
+/**
+ * Проигрывает журнал на произвольном memory_resource с максимальной скоростью.
+ * Блоки, оставшиеся живыми в конце журнала, освобождаются после замера.
+ * on_step(stats), если задан, вызывается после каждой операции - например,
+ * чтобы снимать пиковое потребление памяти ресурсом (время вызова входит в замер).
+ */
+template <typename OnStep>
+TraceReplayStats replay_trace(const TraceProgram &program, std::pmr::memory_resource &resource, OnStep &&on_step)
+{
+    struct Live
+    {
+        void *ptr{nullptr};
+        size_t size{0};
+        size_t alignment{0};
+    };
+
+    TraceReplayStats stats;
+    stats.recorded_ns = program.recorded_ns();
+    std::vector<Live> live(program.slots_count());
+    size_t live_bytes = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const TraceProgram::Step &step : program.steps())
+    {
+        Live &slot = live[step.slot];
+        if (step.allocate)
+        {
+            slot = {resource.allocate(step.size, step.alignment), step.size, step.alignment};
+            live_bytes += step.size;
+            stats.peak_live_bytes = live_bytes > stats.peak_live_bytes ? live_bytes : stats.peak_live_bytes;
+            ++stats.allocations;
+        }
+        else
+        {
+            resource.deallocate(slot.ptr, slot.size, slot.alignment);
+            live_bytes -= slot.size;
+            slot.ptr = nullptr;
+            ++stats.deallocations;
+        }
+        on_step(stats);
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (Live &slot : live)
+    {
+        if (slot.ptr)
+        {
+            ++stats.live_blocks_at_end;
+            resource.deallocate(slot.ptr, slot.size, slot.alignment);
+        }
+    }
+    return stats;
+}
+
+inline TraceReplayStats replay_trace(const TraceProgram &program, std::pmr::memory_resource &resource)
+{
+    return replay_trace(program, resource, [](const TraceReplayStats &) {});
+}
+
+#endif // ALLOCATION_TRACE_H
@@ -0,0 +1,401 @@
+#ifndef COMPRESSED_INT_ARRAY_H
+#define COMPRESSED_INT_ARRAY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "dynamic_array.h"
+
+// Как закодирован блок CompressedIntArray
+enum class BlockEncoding : uint8_t
+{
+    FrameOfReference, // value = reference + packed
+    Delta             // value = предыдущее значение + reference + packed
+};
+
+// Подсказка развернуть цикл; компиляторы без неё просто оставляют цикл как есть
+#if defined(__clang__)
+#define LAB5_UNROLL_32 _Pragma("unroll 32")
+#elif defined(__GNUC__)
+#define LAB5_UNROLL_32 _Pragma("GCC unroll 32")
+#else
+#define LAB5_UNROLL_32
+#endif
+
+namespace compressed_int_array_detail
+{
+    // Число бит, нужное для value (0 для нуля)
+    inline unsigned bit_width(uint64_t value)
+    {
+        if (value == 0)
+        {
+            return 0;
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        return 64 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned width = 0;
+        for (; value != 0; value >>= 1)
+        {
+            ++width;
+        }
+        return width;
+#endif
+    }
+
+    constexpr uint64_t low_mask(unsigned width)
+    {
+        return width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+    }
+
+    constexpr size_t kBlockSize = 128;
+    constexpr size_t kLanes = 4;
+    constexpr size_t kLaneValues = kBlockSize / kLanes;
+
+    /**
+     * Распаковка блока ширины Width: out[i] = reference + packed[i].
+     * Ширина известна при компиляции, поэтому после развёртки цикла сдвиги
+     * и переходы через границу слова становятся константами, а строки из
+     * kLanes значений компилятор собирает в векторные операции.
+     */
+    template <typename T, unsigned Width>
+    void unpack_block(const uint64_t *words, T reference, T *out)
+    {
+        constexpr uint64_t mask = low_mask(Width);
+        LAB5_UNROLL_32
+        for (size_t row = 0; row < kLaneValues; ++row)
+        {
+            const size_t bit = row * Width;
+            const uint64_t *lo = words + bit / 64 * kLanes;
+            const unsigned shift = bit % 64;
+            T *dst = out + row * kLanes;
+            for (size_t lane = 0; lane < kLanes; ++lane)
+            {
+                uint64_t value = lo[lane] >> shift;
+                if (shift + Width > 64)
+                {
+                    value |= lo[lane + kLanes] << (64 - shift);
+                }
+                dst[lane] = static_cast<T>(reference + (value & mask));
+            }
+        }
+    }
+
+    template <typename T>
+    void fill_block(const uint64_t *, T reference, T *out)
+    {
+        std::fill(out, out + kBlockSize, reference);
+    }
+
+    template <typename T>
+    using UnpackFn = void (*)(const uint64_t *, T, T *);
+
+    template <typename T, size_t... Widths>
+    const UnpackFn<T> *make_unpack_table(std::index_sequence<Widths...>)
+    {
+        static const UnpackFn<T> table[] = {&fill_block<T>, &unpack_block<T, Widths + 1>...};
+        return table;
+    }
+
+    // Функция распаковки для каждой ширины 0..64 бит (до разрядности T)
+    template <typename T>
+    const UnpackFn<T> *unpack_table()
+    {
+        static const UnpackFn<T> *table = make_unpack_table<T>(std::make_index_sequence<sizeof(T) * 8>());
+        return table;
+    }
+}
+
+/**
+ * Массив беззнаковых целых, сжатый блоками по kBlockSize значений.
+ * Каждый блок кодируется одним из двух способов - какой окажется уже:
+ * - frame of reference: из значений вычитается минимум блока, остаток
+ *   упаковывается в width бит (подходит для ID из узкого диапазона);
+ * - дельты: хранится разность с предыдущим значением минус минимальная
+ *   разность (подходит для монотонных меток времени).
+ *
+ * Значения раскладываются по kLanes дорожкам (значение i - в дорожку i % kLanes),
+ * слова дорожек чередуются. При распаковке все дорожки сдвигаются на одно и то же
+ * число бит, поэтому внутренний цикл decode_block компилятор векторизует;
+ * дельты затем складываются одним проходом.
+ *
+ * Добавление - только в конец: последние неполные kBlockSize значений лежат
+ * несжатыми и кодируются, когда блок заполнится. Доступ по индексу к блоку
+ * frame of reference - O(1), к блоку дельт - распаковка блока и до kBlockSize
+ * сложений, поэтому для частых случайных обращений лучше монотонные колонки
+ * читать блоками через decode_block.
+ */
+template <typename T>
+class CompressedIntArray
+{
+    static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) <= 8,
+                  "CompressedIntArray: нужен беззнаковый целый тип");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+
+    static constexpr size_t kBlockSize = compressed_int_array_detail::kBlockSize;
+    static constexpr size_t kLanes = compressed_int_array_detail::kLanes;
+    static constexpr size_t kLaneValues = compressed_int_array_detail::kLaneValues;
+
+    explicit CompressedIntArray(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : blocks_(mr), words_(mr), tail_(mr), unpack_(compressed_int_array_detail::unpack_table<T>())
+    {
+        tail_.reserve(kBlockSize);
+    }
+
+    void push_back(T value)
+    {
+        tail_.push_back(value);
+        if (tail_.size() == kBlockSize)
+        {
+            seal_tail();
+        }
+    }
+
+    void append(const T *values, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            push_back(values[i]);
+        }
+    }
+
+    void append(const DynamicArray<T> &values)
+    {
+        append(values.data(), values.size());
+    }
+
+    T operator[](size_t index) const
+    {
+        const size_t block = index / kBlockSize;
+        const size_t offset = index % kBlockSize;
+        if (block == blocks_.size())
+        {
+            return tail_[offset];
+        }
+
+        const BlockHeader &header = blocks_[block];
+        if (header.encoding == BlockEncoding::FrameOfReference)
+        {
+            return static_cast<T>(header.reference + unpack(header, offset));
+        }
+
+        // Распаковка блока целиком векторная и дешевле поштучного извлечения дельт
+        T deltas[kBlockSize];
+        unpack_[header.width](words_.data() + header.offset, header.reference, deltas);
+        T value = header.base;
+        for (size_t i = 0; i <= offset; ++i)
+        {
+            value = static_cast<T>(value + deltas[i]);
+        }
+        return value;
+    }
+
+    T at(size_t index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("CompressedIntArray::at: индекс вне диапазона");
+        }
+        return (*this)[index];
+    }
+
+    size_t size() const { return blocks_.size() * kBlockSize + tail_.size(); }
+    bool empty() const { return size() == 0; }
+
+    // Число блоков, включая неполный последний
+    size_t blocks_count() const { return blocks_.size() + (tail_.empty() ? 0 : 1); }
+
+    /**
+     * Распаковывает блок block в out (не меньше kBlockSize элементов).
+     * Возвращает число значений в блоке: kBlockSize, у последнего - меньше.
+     */
+    size_t decode_block(size_t block, T *out) const
+    {
+        if (block == blocks_.size())
+        {
+            std::copy(tail_.begin(), tail_.end(), out);
+            return tail_.size();
+        }
+
+        const BlockHeader &header = blocks_[block];
+        unpack_[header.width](words_.data() + header.offset, header.reference, out);
+
+        if (header.encoding == BlockEncoding::Delta)
+        {
+            T running = header.base;
+            for (size_t i = 0; i < kBlockSize; ++i)
+            {
+                running = static_cast<T>(running + out[i]);
+                out[i] = running;
+            }
+        }
+        return kBlockSize;
+    }
+
+    // Вызывает fn(const T *values, size_t count) для каждого блока по порядку
+    template <typename Fn>
+    void for_each_block(Fn &&fn) const
+    {
+        T buffer[kBlockSize];
+        for (size_t block = 0; block < blocks_count(); ++block)
+        {
+            const size_t count = decode_block(block, buffer);
+            fn(static_cast<const T *>(buffer), count);
+        }
+    }
+
+    // Распаковывает весь массив в out (старое содержимое заменяется)
+    void decode(DynamicArray<T> &out) const
+    {
+        out.resize_uninitialized(size());
+        for (size_t block = 0; block < blocks_count(); ++block)
+        {
+            decode_block(block, out.data() + block * kBlockSize);
+        }
+    }
+
+    void clear()
+    {
+        blocks_.clear();
+        words_.clear();
+        tail_.clear();
+    }
+
+    BlockEncoding get_block_encoding(size_t block) const { return blocks_[block].encoding; }
+    unsigned get_block_width(size_t block) const { return blocks_[block].width; }
+
+    // Сколько байт занимают сжатые данные (упакованные слова, заголовки блоков и хвост)
+    size_t get_compressed_bytes() const
+    {
+        return words_.size() * sizeof(uint64_t) + blocks_.size() * sizeof(BlockHeader) + tail_.size() * sizeof(T);
+    }
+
+    // Во сколько раз массив меньше несжатого DynamicArray<T> того же размера
+    double get_compression_ratio() const
+    {
+        const size_t compressed = get_compressed_bytes();
+        return compressed == 0 ? 1.0 : static_cast<double>(size() * sizeof(T)) / static_cast<double>(compressed);
+    }
+
+private:
+    struct BlockHeader
+    {
+        size_t offset;          // Первое слово блока в words_
+        T reference;            // Минимум значений (или дельт), вычтенный перед упаковкой
+        T base;                 // Для дельт: значение перед первым, подобранное так, чтобы первая дельта была минимальной
+        uint8_t width;          // Бит на значение
+        BlockEncoding encoding;
+    };
+
+    // Упакованное значение с номером offset внутри блока
+    uint64_t unpack(const BlockHeader &header, size_t offset) const
+    {
+        const unsigned width = header.width;
+        if (width == 0)
+        {
+            return 0;
+        }
+        const size_t bit = offset / kLanes * width;
+        const uint64_t *lo = words_.data() + header.offset + bit / 64 * kLanes + offset % kLanes;
+        const unsigned shift = bit % 64;
+        uint64_t value = *lo >> shift;
+        if (shift + width > 64)
+        {
+            value |= lo[kLanes] << (64 - shift);
+        }
+        return value & compressed_int_array_detail::low_mask(width);
+    }
+
+    // Сжимает заполненный хвост в новый блок
+    void seal_tail()
+    {
+        using Signed = std::make_signed_t<T>;
+        const T *values = tail_.data();
+
+        // Frame of reference: диапазон значений
+        T min_value = values[0];
+        T max_value = values[0];
+        for (size_t i = 1; i < kBlockSize; ++i)
+        {
+            min_value = std::min(min_value, values[i]);
+            max_value = std::max(max_value, values[i]);
+        }
+        const unsigned for_width = compressed_int_array_detail::bit_width(static_cast<uint64_t>(max_value - min_value));
+
+        // Дельты с предыдущим значением; убывающие разности сравниваются как знаковые,
+        // чтобы диапазон оставался узким
+        T deltas[kBlockSize];
+        for (size_t i = 1; i < kBlockSize; ++i)
+        {
+            deltas[i] = static_cast<T>(values[i] - values[i - 1]);
+        }
+        Signed min_delta = static_cast<Signed>(deltas[1]);
+        Signed max_delta = min_delta;
+        for (size_t i = 2; i < kBlockSize; ++i)
+        {
+            min_delta = std::min(min_delta, static_cast<Signed>(deltas[i]));
+            max_delta = std::max(max_delta, static_cast<Signed>(deltas[i]));
+        }
+        const unsigned delta_width = compressed_int_array_detail::bit_width(
+            static_cast<uint64_t>(static_cast<T>(static_cast<T>(max_delta) - static_cast<T>(min_delta))));
+
+        // Первое значение отсчитывается от base так, чтобы его дельта была минимальной
+        deltas[0] = static_cast<T>(min_delta);
+
+        BlockHeader header;
+        header.offset = words_.size();
+        header.base = static_cast<T>(values[0] - deltas[0]);
+        const T *source;
+        if (delta_width < for_width)
+        {
+            header.encoding = BlockEncoding::Delta;
+            header.width = static_cast<uint8_t>(delta_width);
+            header.reference = static_cast<T>(min_delta);
+            source = deltas;
+        }
+        else
+        {
+            header.encoding = BlockEncoding::FrameOfReference;
+            header.width = static_cast<uint8_t>(for_width);
+            header.reference = min_value;
+            source = values;
+        }
+
+        // Каждая дорожка занимает ceil(kLaneValues * width / 64) слов
+        const size_t lane_words = (kLaneValues * header.width + 63) / 64;
+        const unsigned width = header.width;
+        const T reference = header.reference;
+        words_.append_with(lane_words * kLanes, [source, width, reference](uint64_t *words, size_t count)
+                           {
+                               std::fill(words, words + count, uint64_t(0));
+                               for (size_t i = 0; i < kBlockSize; ++i)
+                               {
+                                   const uint64_t packed = static_cast<T>(source[i] - reference);
+                                   const size_t bit = i / kLanes * width;
+                                   const unsigned shift = bit % 64;
+                                   uint64_t *lo = words + bit / 64 * kLanes + i % kLanes;
+                                   *lo |= packed << shift;
+                                   if (shift + width > 64)
+                                   {
+                                       lo[kLanes] |= packed >> (64 - shift);
+                                   }
+                               } });
+
+        blocks_.push_back(header);
+        tail_.clear();
+    }
+
+    DynamicArray<BlockHeader> blocks_;
+    DynamicArray<uint64_t> words_;
+    DynamicArray<T> tail_; // Последние значения, ещё не собранные в блок
+    const compressed_int_array_detail::UnpackFn<T> *unpack_; // Распаковка по ширине блока
+};
+
+#endif // COMPRESSED_INT_ARRAY_H
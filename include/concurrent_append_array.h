@@ -0,0 +1,402 @@
+#ifndef CONCURRENT_APPEND_ARRAY_H
+#define CONCURRENT_APPEND_ARRAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include "dynamic_array.h"
+
+/**
+ * Контейнер для одновременного добавления элементов из многих потоков.
+ *
+ * Слот под элемент резервируется одним compare_exchange по счётчику, без
+ * блокировок. Память хранится сегментами: сегмент 0 вмещает kFirstSegmentSize
+ * элементов, а каждый следующий - вдвое больше предыдущего. Уже добавленные
+ * элементы никогда не перемещаются, поэтому рост не мешает параллельной записи.
+ * Мьютекс берётся только при выделении нового сегмента (O(log n) раз за всё
+ * время жизни), так как memory_resource может быть непотокобезопасным.
+ *
+ * Сегменты под резерв выделяются до того, как сдвигается счётчик, поэтому
+ * bad_alloc и length_error не оставляют занятых пустых слотов. Если бросает
+ * конструктор T, добавление не оставляет следов: последний резерв просто
+ * откатывается, а если за ним уже писали другие потоки, его индексы
+ * помечаются пропусками (см. failed_count). Пропуски не разрушаются и не
+ * попадают в freeze(), at() для них бросает out_of_range.
+ *
+ * Читать элементы (operator[], size, freeze) можно только после того, как все
+ * вызовы push_back/emplace_back/append завершились (например, после join).
+ */
+template <typename T>
+class ConcurrentAppendArray
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+
+    // Размер первого сегмента (степень двойки)
+    static constexpr size_type kFirstSegmentSize = 64;
+    static constexpr size_type kMaxSegments = 48;
+
+    explicit ConcurrentAppendArray(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : allocator_(mr)
+    {
+        for (auto &segment : segments_)
+        {
+            segment.store(nullptr, std::memory_order_relaxed);
+        }
+        std::fill(holes_, holes_ + kMaxSegments, nullptr);
+    }
+
+    ~ConcurrentAppendArray()
+    {
+        release();
+    }
+
+    ConcurrentAppendArray(const ConcurrentAppendArray &) = delete;
+    ConcurrentAppendArray &operator=(const ConcurrentAppendArray &) = delete;
+
+    // Модификаторы (потокобезопасны относительно друг друга)
+    size_type push_back(const T &value)
+    {
+        return emplace_back(value);
+    }
+
+    size_type push_back(T &&value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    // Возвращает индекс, под которым сохранён элемент
+    template <typename... Args>
+    size_type emplace_back(Args &&...args)
+    {
+        const size_type index = reserve(1);
+        try
+        {
+            std::allocator_traits<allocator_type>::construct(allocator_, slot(index), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            abandon(index, 1);
+            throw;
+        }
+        return index;
+    }
+
+    /**
+     * Добавляет count элементов одним резервированием (один CAS на пачку).
+     * Элементы пачки идут подряд по индексам, но могут попасть в разные сегменты.
+     * Возвращает индекс первого элемента. Если конструктор бросает, уже
+     * построенные элементы пачки разрушаются и не добавляется ни один.
+     */
+    size_type append(const T *values, size_type count)
+    {
+        const size_type first = reserve(count);
+        size_type done = 0;
+        try
+        {
+            while (done < count)
+            {
+                const size_type index = first + done;
+                const size_type segment = segment_of(index);
+                const size_type offset = index - segment_start(segment);
+                T *base = segments_[segment].load(std::memory_order_acquire) + offset;
+                const size_type run = std::min(count - done, segment_capacity(segment) - offset);
+                for (size_type i = 0; i < run; ++i, ++done)
+                {
+                    std::allocator_traits<allocator_type>::construct(allocator_, base + i, values[done]);
+                }
+            }
+        }
+        catch (...)
+        {
+            for (size_type i = 0; i < done; ++i)
+            {
+                std::allocator_traits<allocator_type>::destroy(allocator_, slot(first + i));
+            }
+            abandon(first, count);
+            throw;
+        }
+        return first;
+    }
+
+    // Доступ к элементам (только когда добавление завершено)
+    reference operator[](size_type index)
+    {
+        const size_type segment = segment_of(index);
+        return segments_[segment].load(std::memory_order_acquire)[index - segment_start(segment)];
+    }
+
+    const_reference operator[](size_type index) const
+    {
+        const size_type segment = segment_of(index);
+        return segments_[segment].load(std::memory_order_acquire)[index - segment_start(segment)];
+    }
+
+    reference at(size_type index)
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("ConcurrentAppendArray::at: индекс вне диапазона");
+        }
+        if (is_hole(index))
+        {
+            throw std::out_of_range("ConcurrentAppendArray::at: элемент не был построен");
+        }
+        return (*this)[index];
+    }
+
+    // Число занятых индексов, включая пропуски
+    size_type size() const { return size_.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+
+    // Сколько индексов осталось пропусками после исключений в конструкторе T
+    size_type failed_count() const { return failed_.load(std::memory_order_acquire); }
+
+    // Сколько сегментов уже выделено
+    size_type segments_count() const
+    {
+        size_type count = 0;
+        while (count < kMaxSegments && segments_[count].load(std::memory_order_acquire))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * Переносит все элементы в непрерывный DynamicArray из того же
+     * memory_resource и очищает контейнер. Вызывать после завершения записи.
+     */
+    DynamicArray<T> freeze()
+    {
+        DynamicArray<T> result(allocator_.resource());
+        const size_type count = size();
+        const bool has_holes = failed_count() != 0;
+        result.reserve(count - failed_count());
+
+        for (size_type segment = 0; segment < kMaxSegments; ++segment)
+        {
+            const size_type start = segment_start(segment);
+            if (start >= count)
+            {
+                break;
+            }
+            T *base = segments_[segment].load(std::memory_order_acquire);
+            const size_type run = std::min(count - start, segment_capacity(segment));
+            for (size_type i = 0; i < run; ++i)
+            {
+                if (has_holes && is_hole(start + i))
+                {
+                    continue;
+                }
+                result.push_back(std::move(base[i]));
+            }
+        }
+
+        release();
+        return result;
+    }
+
+    allocator_type get_allocator() const { return allocator_; }
+
+private:
+    static constexpr unsigned kFirstSegmentShift = 6; // log2(kFirstSegmentSize)
+    static_assert((size_type(1) << kFirstSegmentShift) == kFirstSegmentSize,
+                  "kFirstSegmentShift должен соответствовать kFirstSegmentSize");
+
+    // Номер сегмента: 0 для [0, B), k для [B * 2^(k-1), B * 2^k)
+    static size_type segment_of(size_type index)
+    {
+        const unsigned long long block = index >> kFirstSegmentShift;
+        if (block == 0)
+        {
+            return 0;
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_type>(64 - __builtin_clzll(block));
+#else
+        size_type segment = 0;
+        for (unsigned long long rest = block; rest != 0; rest >>= 1)
+        {
+            ++segment;
+        }
+        return segment;
+#endif
+    }
+
+    static size_type segment_start(size_type segment)
+    {
+        return segment == 0 ? 0 : kFirstSegmentSize << (segment - 1);
+    }
+
+    static size_type segment_capacity(size_type segment)
+    {
+        return segment == 0 ? kFirstSegmentSize : kFirstSegmentSize << (segment - 1);
+    }
+
+    using hole_word = std::atomic<uint64_t>;
+    using hole_allocator = std::pmr::polymorphic_allocator<hole_word>;
+
+    static size_type hole_words(size_type segment)
+    {
+        return (segment_capacity(segment) + 63) / 64;
+    }
+
+    // Слот уже зарезервированного индекса: его сегмент выделен в reserve()
+    T *slot(size_type index)
+    {
+        const size_type segment = segment_of(index);
+        return segments_[segment].load(std::memory_order_acquire) + (index - segment_start(segment));
+    }
+
+    /**
+     * Резервирует count индексов подряд и возвращает первый. Сегменты под них
+     * выделяются до сдвига счётчика: если выделение бросает, ничего не занято.
+     */
+    size_type reserve(size_type count)
+    {
+        size_type first = size_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (count > segment_start(kMaxSegments) - first)
+            {
+                throw std::length_error("ConcurrentAppendArray: превышен максимальный размер");
+            }
+            if (count != 0)
+            {
+                for (size_type segment = segment_of(first); segment <= segment_of(first + count - 1); ++segment)
+                {
+                    segment_data(segment);
+                }
+            }
+            if (size_.compare_exchange_weak(first, first + count, std::memory_order_relaxed))
+            {
+                return first;
+            }
+        }
+    }
+
+    /**
+     * Возвращает индексы [first, first + count), элементы которых не удалось
+     * построить. Если резерв всё ещё последний, счётчик откатывается, иначе
+     * индексы помечаются пропусками в битовых картах сегментов (без выделений).
+     */
+    void abandon(size_type first, size_type count) noexcept
+    {
+        size_type expected = first + count;
+        if (size_.compare_exchange_strong(expected, first, std::memory_order_relaxed))
+        {
+            return;
+        }
+        for (size_type index = first; index < first + count; ++index)
+        {
+            const size_type segment = segment_of(index);
+            const size_type offset = index - segment_start(segment);
+            holes_[segment][offset / 64].fetch_or(uint64_t(1) << (offset % 64), std::memory_order_relaxed);
+        }
+        failed_.fetch_add(count, std::memory_order_release);
+    }
+
+    bool is_hole(size_type index) const
+    {
+        if (failed_.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+        const size_type segment = segment_of(index);
+        const size_type offset = index - segment_start(segment);
+        return (holes_[segment][offset / 64].load(std::memory_order_relaxed) >> (offset % 64)) & 1;
+    }
+
+    // Возвращает сегмент, при необходимости выделяя его (двойная проверка под мьютексом)
+    T *segment_data(size_type segment)
+    {
+        if (segment >= kMaxSegments)
+        {
+            throw std::length_error("ConcurrentAppendArray: превышен максимальный размер");
+        }
+
+        T *data = segments_[segment].load(std::memory_order_acquire);
+        if (data)
+        {
+            return data;
+        }
+
+        std::lock_guard<std::mutex> lock(grow_mutex_);
+        data = segments_[segment].load(std::memory_order_relaxed);
+        if (!data)
+        {
+            // Карта пропусков выделяется вместе с сегментом, чтобы abandon() ничего не выделял
+            data = allocator_.allocate(segment_capacity(segment));
+            hole_allocator holes(allocator_.resource());
+            hole_word *words = nullptr;
+            try
+            {
+                words = holes.allocate(hole_words(segment));
+            }
+            catch (...)
+            {
+                allocator_.deallocate(data, segment_capacity(segment));
+                throw;
+            }
+            for (size_type i = 0; i < hole_words(segment); ++i)
+            {
+                new (words + i) hole_word(0);
+            }
+            holes_[segment] = words;
+            segments_[segment].store(data, std::memory_order_release);
+        }
+        return data;
+    }
+
+    void release()
+    {
+        const size_type count = size_.load(std::memory_order_acquire);
+        const bool has_holes = failed_count() != 0;
+        hole_allocator holes(allocator_.resource());
+        for (size_type segment = 0; segment < kMaxSegments; ++segment)
+        {
+            T *base = segments_[segment].load(std::memory_order_acquire);
+            if (!base)
+            {
+                continue;
+            }
+            const size_type start = segment_start(segment);
+            const size_type run = count > start ? std::min(count - start, segment_capacity(segment)) : 0;
+            for (size_type i = 0; i < run; ++i)
+            {
+                if (!has_holes || !is_hole(start + i))
+                {
+                    std::allocator_traits<allocator_type>::destroy(allocator_, base + i);
+                }
+            }
+            allocator_.deallocate(base, segment_capacity(segment));
+            holes.deallocate(holes_[segment], hole_words(segment));
+            holes_[segment] = nullptr;
+            segments_[segment].store(nullptr, std::memory_order_relaxed);
+        }
+        size_.store(0, std::memory_order_release);
+        failed_.store(0, std::memory_order_release);
+    }
+
+    allocator_type allocator_;
+    std::mutex grow_mutex_;
+    std::atomic<T *> segments_[kMaxSegments];
+
+    // Битовые карты пропусков, по одной на сегмент (заполняются до публикации сегмента)
+    hole_word *holes_[kMaxSegments];
+    std::atomic<size_type> failed_{0};
+
+    // Счётчик на отдельной кэш-линии, чтобы CAS не задевал указатели сегментов
+    alignas(64) std::atomic<size_type> size_{0};
+};
+
+#endif // CONCURRENT_APPEND_ARRAY_H
@@ -0,0 +1,417 @@
+#ifndef COW_DYNAMIC_ARRAY_H
+#define COW_DYNAMIC_ARRAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "dynamic_array.h"
+
+/**
+ * Динамический массив с копированием при записи. Копия разделяет буфер
+ * с оригиналом и стоит одного атомарного инкремента счётчика ссылок;
+ * буфер клонируется, только когда массив меняют, пока буфер разделён.
+ *
+ * Буфер выделяется из memory_resource одним блоком: заголовок (счётчик
+ * ссылок, ресурс, ёмкость) и сразу за ним элементы. Указатель на данные и
+ * размер хранятся в самом массиве, поэтому чтение - operator[] const, at const,
+ * ConstIterator, data() const - обходится без атомарных операций.
+ *
+ * Неконстантный доступ (operator[], begin(), data() и т.д.) сначала делает
+ * буфер собственным. Полученные так ссылки и итераторы действительны до
+ * следующего копирования массива: после него запись через старую ссылку
+ * увидят обе копии. Для чтения из неконстантного массива есть cbegin/cend
+ * и get(index).
+ *
+ * Разные экземпляры, разделяющие буфер, можно читать, копировать и менять
+ * из разных потоков одновременно; один экземпляр - как обычный контейнер.
+ */
+template <typename T>
+class CowDynamicArray
+{
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = typename DynamicArray<T>::Iterator;
+    using const_iterator = typename DynamicArray<T>::ConstIterator;
+
+    explicit CowDynamicArray(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : resource_(mr) {}
+
+    explicit CowDynamicArray(size_type count, std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : resource_(mr)
+    {
+        resize(count);
+    }
+
+    CowDynamicArray(size_type count, const T &value, std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : resource_(mr)
+    {
+        resize(count, value);
+    }
+
+    // Копирует элементы обычного массива в новый буфер из того же ресурса
+    explicit CowDynamicArray(const DynamicArray<T> &source)
+        : resource_(source.get_allocator().resource())
+    {
+        reserve(source.size());
+        for (const T &value : source)
+        {
+            push_back(value);
+        }
+    }
+
+    // Копирование за O(1): буфер разделяется
+    CowDynamicArray(const CowDynamicArray &other)
+        : resource_(other.resource_), header_(other.header_), data_(other.data_),
+          size_(other.size_), capacity_(other.capacity_)
+    {
+        retain();
+    }
+
+    CowDynamicArray(CowDynamicArray &&other) noexcept
+        : resource_(other.resource_), header_(other.header_), data_(other.data_),
+          size_(other.size_), capacity_(other.capacity_)
+    {
+        other.forget();
+    }
+
+    ~CowDynamicArray()
+    {
+        release();
+    }
+
+    // Ресурс массива не меняется: новые буферы по-прежнему берутся из него
+    CowDynamicArray &operator=(const CowDynamicArray &other)
+    {
+        if (header_ != other.header_)
+        {
+            other.retain();
+            release();
+            header_ = other.header_;
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+        }
+        size_ = other.size_;
+        return *this;
+    }
+
+    CowDynamicArray &operator=(CowDynamicArray &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            header_ = other.header_;
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.forget();
+        }
+        return *this;
+    }
+
+    // Чтение без атомарных операций
+    const_reference operator[](size_type index) const { return data_[index]; }
+
+    const_reference at(size_type index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("CowDynamicArray::at: индекс вне диапазона");
+        }
+        return data_[index];
+    }
+
+    // Чтение из неконстантного массива без отделения буфера
+    const_reference get(size_type index) const { return data_[index]; }
+
+    const_reference front() const { return data_[0]; }
+    const_reference back() const { return data_[size_ - 1]; }
+    const_pointer data() const { return data_; }
+
+    const_iterator begin() const { return const_iterator(data_); }
+    const_iterator end() const { return const_iterator(data_ + size_); }
+    const_iterator cbegin() const { return const_iterator(data_); }
+    const_iterator cend() const { return const_iterator(data_ + size_); }
+
+    // Доступ на запись: буфер становится собственным
+    reference operator[](size_type index)
+    {
+        make_unique();
+        return data_[index];
+    }
+
+    reference at(size_type index)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("CowDynamicArray::at: индекс вне диапазона");
+        }
+        make_unique();
+        return data_[index];
+    }
+
+    reference front()
+    {
+        make_unique();
+        return data_[0];
+    }
+
+    reference back()
+    {
+        make_unique();
+        return data_[size_ - 1];
+    }
+
+    pointer data()
+    {
+        make_unique();
+        return data_;
+    }
+
+    iterator begin()
+    {
+        make_unique();
+        return iterator(data_);
+    }
+
+    iterator end()
+    {
+        make_unique();
+        return iterator(data_ + size_);
+    }
+
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    // Сколько массивов разделяют буфер (0 - буфера нет)
+    size_t use_count() const { return header_ ? header_->refs.load(std::memory_order_relaxed) : 0; }
+    bool is_shared() const { return use_count() > 1; }
+
+    void push_back(const T &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args &&...args)
+    {
+        if (size_ == capacity_ || !unique())
+        {
+            // value может ссылаться на элемент этого же буфера: строим до переноса
+            T value(std::forward<Args>(args)...);
+            reallocate(size_ == capacity_ ? std::max<size_type>(1, capacity_ * 2) : capacity_);
+            construct(data_ + size_, std::move(value));
+        }
+        else
+        {
+            construct(data_ + size_, std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void pop_back()
+    {
+        if (size_ > 0)
+        {
+            make_unique();
+            std::destroy_at(data_ + size_ - 1);
+            --size_;
+        }
+    }
+
+    // Разделённый буфер не трогается: массив просто отказывается от своей ссылки
+    void clear()
+    {
+        if (!unique())
+        {
+            release();
+            forget();
+            return;
+        }
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void reserve(size_type new_capacity)
+    {
+        if (new_capacity > capacity_)
+        {
+            reallocate(new_capacity);
+        }
+    }
+
+    void resize(size_type new_size)
+    {
+        resize_with(new_size, [this](T *slot)
+                    { construct(slot); });
+    }
+
+    void resize(size_type new_size, const T &value)
+    {
+        resize_with(new_size, [this, &value](T *slot)
+                    { construct(slot, value); });
+    }
+
+    allocator_type get_allocator() const { return allocator_type(resource_); }
+
+private:
+    // Заголовок буфера; элементы лежат сразу за ним
+    struct Header
+    {
+        std::atomic<size_t> refs;
+        std::pmr::memory_resource *resource; // Откуда выделен буфер (у копии ресурс может быть другим)
+        size_t capacity;
+    };
+
+    static constexpr size_t kAlignment = alignof(Header) > alignof(T) ? alignof(Header) : alignof(T);
+    static constexpr size_t kDataOffset = (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    static size_t buffer_bytes(size_t capacity) { return kDataOffset + capacity * sizeof(T); }
+
+    static T *data_of(Header *header)
+    {
+        return std::launder(reinterpret_cast<T *>(reinterpret_cast<char *>(header) + kDataOffset));
+    }
+
+    template <typename... Args>
+    void construct(T *slot, Args &&...args)
+    {
+        allocator_type allocator(resource_);
+        std::allocator_traits<allocator_type>::construct(allocator, slot, std::forward<Args>(args)...);
+    }
+
+    bool unique() const
+    {
+        return header_ && header_->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    void retain() const
+    {
+        if (header_)
+        {
+            header_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Отпускает ссылку; последний владелец разрушает элементы и возвращает буфер ресурсу
+    void release()
+    {
+        if (header_ && header_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::destroy(data_, data_ + size_);
+            std::pmr::memory_resource *resource = header_->resource;
+            const size_t bytes = buffer_bytes(header_->capacity);
+            header_->~Header();
+            resource->deallocate(header_, bytes, kAlignment);
+        }
+    }
+
+    void forget()
+    {
+        header_ = nullptr;
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+    void make_unique()
+    {
+        if (header_ && !unique())
+        {
+            reallocate(capacity_);
+        }
+    }
+
+    /**
+     * Переносит элементы в новый собственный буфер на new_capacity элементов:
+     * из собственного буфера - перемещением, из разделённого - копированием.
+     */
+    void reallocate(size_type new_capacity)
+    {
+        void *raw = resource_->allocate(buffer_bytes(new_capacity), kAlignment);
+        Header *header = ::new (raw) Header{{1}, resource_, new_capacity};
+        T *data = data_of(header);
+
+        const bool owned = unique();
+        size_type constructed = 0;
+        try
+        {
+            for (; constructed < size_; ++constructed)
+            {
+                if (owned)
+                {
+                    construct(data + constructed, std::move_if_noexcept(data_[constructed]));
+                }
+                else
+                {
+                    construct(data + constructed, data_[constructed]);
+                }
+            }
+        }
+        catch (...)
+        {
+            std::destroy(data, data + constructed);
+            header->~Header();
+            resource_->deallocate(raw, buffer_bytes(new_capacity), kAlignment);
+            throw;
+        }
+
+        release();
+        header_ = header;
+        data_ = data;
+        capacity_ = new_capacity;
+    }
+
+    template <typename Construct>
+    void resize_with(size_type new_size, Construct construct_at)
+    {
+        if (new_size == size_)
+        {
+            return;
+        }
+        if (new_size > capacity_)
+        {
+            reallocate(std::max(new_size, capacity_ * 2));
+        }
+        else
+        {
+            make_unique();
+        }
+
+        if (new_size < size_)
+        {
+            std::destroy(data_ + new_size, data_ + size_);
+            size_ = new_size;
+            return;
+        }
+        for (; size_ < new_size; ++size_)
+        {
+            construct_at(data_ + size_);
+        }
+    }
+
+    std::pmr::memory_resource *resource_;
+    Header *header_{nullptr};
+    T *data_{nullptr};
+    size_type size_{0};
+    size_type capacity_{0};
+};
+
+#endif // COW_DYNAMIC_ARRAY_H
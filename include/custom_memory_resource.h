@@ -4,7 +4,33 @@
 #include <memory_resource>
 #include <list>
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "allocation_observer.h"
+#include "heap_hardening.h"
+#include "memory_budget.h"
+#include "page_allocator.h"
+#include "sanitizer_annotations.h"
+#include "warm_profile.h"
+
+// Как выбирать свободный блок для повторного использования
+enum class PlacementPolicy
+{
+    FirstFit, // Первый подходящий блок в порядке списка (поведение по умолчанию)
+    BestFit,  // Наименьший подходящий блок
+    GoodFit   // Наименьший подходящий, если потеря не больше waste_ratio от размера блока; иначе новый блок
+};
 
 class CustomMemoryResource : public std::pmr::memory_resource
 {
@@ -15,11 +41,34 @@ private:
         size_t size{0};      // Сколько байт занимает этот блок
         size_t alignment{0}; // Выравнивание памяти (нужно для правильной работы с разными типами данных)
         bool free{false};    // true = блок свободен и можно его переиспользовать, false = блок занят
+        size_t mapped_size{0}; // Если не 0, блок получен через mmap и освобождается через munmap
+        bool carved{false};  // true = блок вырезан из общего куска (chunks_) и отдельно не освобождается
+
+        // Поля усиленного режима (см. set_hardening)
+        void *raw{nullptr};       // Начало реального выделения (перед канарейкой); nullptr = обычный блок
+        size_t usable{0};         // Сколько байт доступно от ptr до конца выделения
+        size_t requested{0};      // Сколько байт запрошено при последней выдаче блока
+        size_t requested_alignment{0}; // С каким выравниванием блок запрошен при последней выдаче
+        bool quarantined{false};  // Блок освобождён, но ещё не может быть выдан повторно
+        bool poisoned{false};     // Блок заполнен kFreedPoison
+        bool guarded{false};      // Блок в mmap-регионе с защитной страницей
+    };
+
+    // Общий кусок памяти, из которого нарезаны блоки пакетного выделения
+    struct Chunk
+    {
+        void *ptr{nullptr};
+        size_t alignment{0};
+        size_t size{0};
+        size_t mapped_size{0}; // Если не 0, кусок получен через mmap (см. prewarm)
     };
 
     // Список всех блоков памяти (и занятых, и свободных)
     std::list<MemoryBlock> allocated_blocks_;
 
+    // Куски памяти, нарезанные на блоки; освобождаются целиком в деструкторе
+    std::list<Chunk> chunks_;
+
     // Статистика: сколько всего байт мы выделили за всё время работы
     size_t total_allocated_bytes_{0};
 
@@ -29,46 +78,610 @@ private:
     // Режим отладки: если true, то будем выводить сообщения о каждой операции с памятью
     bool verbose_{false};
 
-protected:
-    void *do_allocate(size_t bytes, size_t alignment) override
+    // Подключённые наблюдатели (профилировщик и т.п.); пустой список ничего не стоит
+    std::vector<AllocationObserver *> observers_;
+
+    // Порог (в байтах), начиная с которого блоки берутся из mmap с большими страницами.
+    // 0 = путь для больших выделений выключен
+    size_t large_allocation_threshold_{0};
+
+    // Пробовать ли MAP_HUGETLB перед прозрачными большими страницами
+    bool use_hugetlb_{false};
+
+    // Усиленный режим: канарейки, яд, карантин, защитные страницы
+    HardeningOptions hardening_{HardeningOptions::compiled_default()};
+
+    // Освобождённые блоки в порядке освобождения (указатели в allocated_blocks_ стабильны)
+    std::deque<MemoryBlock *> quarantine_;
+
+    // Сколько ошибок обнаружено усиленным режимом
+    size_t hardening_errors_{0};
+
+    // Политика выбора свободного блока (см. set_placement_policy)
+    PlacementPolicy placement_policy_{PlacementPolicy::FirstFit};
+    double waste_ratio_{0.25};
+
+    // Статистика повторного использования
+    size_t reuse_hits_{0};            // Запросы, обслуженные свободным блоком
+    size_t reuse_misses_{0};          // Запросы, потребовавшие новой памяти
+    size_t cross_alignment_hits_{0};  // Из них блоком, выделенным с другим выравниванием
+
+    // Сколько байт ресурс сейчас держит у системы (занятые и кэшированные блоки, куски)
+    size_t footprint_bytes_{0};
+
+    // Лимит памяти (см. set_memory_budget); nullptr = без ограничений
+    MemoryBudget *budget_{nullptr};
+
+    // Вызывается, когда бюджет исчерпан даже после освобождения кэша
+    std::function<void(size_t, MemoryBudget &)> pressure_handler_;
+
+    size_t budget_pressure_events_{0}; // Сколько раз бюджет не пускал новое выделение с первой попытки
+    size_t reclaimed_bytes_{0};        // Сколько байт кэша возвращено системе
+
+    /**
+     * Учитывает bytes новой памяти до того, как взять её у системы. Если бюджет
+     * исчерпан: 1) возвращает системе кэшированные свободные блоки, 2) вызывает
+     * обработчик давления, 3) если места так и нет - бросает std::bad_alloc.
+     */
+    void charge_footprint(size_t bytes)
+    {
+        if (budget_ && budget_->try_charge(bytes))
+        {
+            ++budget_pressure_events_;
+            release_free_blocks();
+            MemoryBudget *exhausted = budget_->try_charge(bytes);
+            if (exhausted && pressure_handler_)
+            {
+                pressure_handler_(bytes, *exhausted);
+                release_free_blocks();
+                exhausted = budget_->try_charge(bytes);
+            }
+            if (exhausted)
+            {
+                throw std::bad_alloc();
+            }
+        }
+        footprint_bytes_ += bytes;
+    }
+
+    // Память отдана системе (или так и не была получена)
+    void uncharge_footprint(size_t bytes)
+    {
+        footprint_bytes_ -= bytes;
+        if (budget_)
+        {
+            budget_->release(bytes);
+        }
+    }
+
+    // Сколько байт системной памяти занимает отдельный (не нарезанный) блок
+    static size_t block_footprint(const MemoryBlock &block)
+    {
+        if (block.mapped_size != 0)
+        {
+            return block.mapped_size;
+        }
+        if (block.raw)
+        {
+            return static_cast<size_t>(static_cast<char *>(block.ptr) - static_cast<char *>(block.raw)) + block.usable;
+        }
+        return block.size;
+    }
+
+    // Возвращает память блока куче или ОС; нарезанные блоки освобождаются вместе со своим куском
+    static void free_block_memory(MemoryBlock &block)
+    {
+        // Снимаем разметку, иначе память, возвращённая ОС или куче, останется "отравленной"
+        SanitizerAnnotations::mark_defined(block.ptr, block.size);
+
+        // Блоки из mmap возвращаем ОС целым отображением
+        if (block.mapped_size != 0)
+        {
+            PageAllocator::unmap(block.raw ? block.raw : block.ptr, block.mapped_size);
+            return;
+        }
+
+        // Защищённые блоки начинаются раньше ptr (с канарейки)
+        if (block.raw)
+        {
+            ::operator delete(block.raw, std::align_val_t(block.alignment));
+            return;
+        }
+
+        // Физически удаляем блок памяти с помощью глобального оператора delete
+        // Важно передать alignment, чтобы память удалилась корректно
+        ::operator delete(block.ptr, std::align_val_t(block.alignment));
+    }
+
+    static void free_chunk_memory(Chunk &chunk)
+    {
+        // Промежутки между нарезанными блоками тоже были отравлены
+        SanitizerAnnotations::mark_defined(chunk.ptr, chunk.size);
+        if (chunk.mapped_size != 0)
+        {
+            PageAllocator::unmap(chunk.ptr, chunk.mapped_size);
+            return;
+        }
+        ::operator delete(chunk.ptr, std::align_val_t(chunk.alignment));
+    }
+
+    // Наибольшая степень двойки, на которую делится адрес
+    static size_t address_alignment(const void *ptr)
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+        return address == 0 ? 0 : static_cast<size_t>(address & (~address + 1));
+    }
+
+    // Блок подходит, если:
+    // 1. Он помечен как свободный (free == true) и не в карантине усиленного режима
+    // 2. Он достаточно большой (size >= bytes)
+    // 3. Его адрес выровнен не хуже, чем требуется (блок с выравниванием 64
+    //    подходит и для запроса с выравниванием 8)
+    static bool block_fits(const MemoryBlock &block, size_t bytes, size_t alignment)
+    {
+        return block.free && !block.quarantined && block.size >= bytes &&
+               address_alignment(block.ptr) >= alignment;
+    }
+
+    // Выдаёт найденный свободный блок под запрос (bytes, alignment)
+    void take_block(MemoryBlock &block, size_t bytes, size_t alignment)
+    {
+        unindex_free_block(block);
+        block.free = false;
+        block.requested = bytes;
+        block.requested_alignment = alignment;
+        ++reuse_hits_;
+        if (block.alignment != alignment)
+        {
+            ++cross_alignment_hits_;
+        }
+    }
+
+    // Ключ индекса свободных блоков: выравнивание адреса, затем размер, затем адрес
+    struct FreeKey
+    {
+        size_t alignment;
+        size_t size;
+        uintptr_t address;
+        MemoryBlock *block;
+
+        bool operator<(const FreeKey &other) const
+        {
+            return std::tie(alignment, size, address) < std::tie(other.alignment, other.size, other.address);
+        }
+    };
+
+    // Свободные блоки вне карантина, упорядоченные по размеру (поиск за O(log n)).
+    // Ведётся только для BestFit и GoodFit; FirstFit обходит список
+    std::set<FreeKey> free_index_;
+
+    bool uses_free_index() const { return placement_policy_ != PlacementPolicy::FirstFit; }
+
+    static FreeKey free_key(MemoryBlock &block)
+    {
+        return {address_alignment(block.ptr), block.size, reinterpret_cast<uintptr_t>(block.ptr), &block};
+    }
+
+    // Блок снова можно выдавать
+    void index_free_block(MemoryBlock &block)
+    {
+        if (uses_free_index())
+        {
+            free_index_.insert(free_key(block));
+        }
+    }
+
+    // Блок выдан и больше не участвует в поиске
+    void unindex_free_block(MemoryBlock &block)
+    {
+        if (uses_free_index())
+        {
+            free_index_.erase(free_key(block));
+        }
+    }
+
+    // Ищет свободный блок согласно политике; nullptr, если подходящего нет
+    MemoryBlock *find_free_block(size_t bytes, size_t alignment)
+    {
+        if (!uses_free_index())
+        {
+            auto it = std::find_if(allocated_blocks_.begin(), allocated_blocks_.end(),
+                                   [bytes, alignment](const MemoryBlock &block)
+                                   {
+                                       return block_fits(block, bytes, alignment);
+                                   });
+            return it != allocated_blocks_.end() ? &*it : nullptr;
+        }
+
+        // Наименьший блок размером не меньше bytes среди классов выравнивания >= alignment.
+        // Классы - степени двойки, поэтому их не больше числа бит в адресе
+        const FreeKey *best = nullptr;
+        auto cls = free_index_.lower_bound({alignment, 0, 0, nullptr});
+        while (cls != free_index_.end())
+        {
+            const size_t class_alignment = cls->alignment;
+            auto pos = free_index_.lower_bound({class_alignment, bytes, 0, nullptr});
+            // При равных размерах предпочитаем более слабо выровненный блок
+            if (pos != free_index_.end() && pos->alignment == class_alignment && (!best || pos->size < best->size))
+            {
+                best = &*pos;
+            }
+            if (class_alignment > SIZE_MAX / 2)
+            {
+                break;
+            }
+            cls = free_index_.lower_bound({class_alignment * 2, 0, 0, nullptr});
+        }
+
+        if (!best)
+        {
+            return nullptr;
+        }
+        if (placement_policy_ == PlacementPolicy::GoodFit &&
+            static_cast<double>(best->size - bytes) > waste_ratio_ * static_cast<double>(best->size))
+        {
+            return nullptr;
+        }
+        return best->block;
+    }
+
+    /**
+     * Сообщает об ошибке согласно hardening_.action.
+     * can_throw = false на пути освобождения: deallocate зовут из noexcept-деструкторов,
+     * и исключение там означало бы std::terminate, поэтому Throw ведёт себя как Abort.
+     */
+    void report(HeapErrorKind kind, const void *address, size_t block_size, const std::string &details,
+                bool can_throw = true)
+    {
+        ++hardening_errors_;
+        HeapCorruptionError error(kind, address, block_size, details);
+        if (hardening_.action == HardeningAction::Throw && can_throw)
+        {
+            throw error;
+        }
+        std::cerr << error.what() << "\n";
+        if (hardening_.action != HardeningAction::Log)
+        {
+            std::abort();
+        }
+    }
+
+    // Размер области перед блоком: канарейка, округлённая до выравнивания
+    static size_t hardened_front(size_t alignment)
+    {
+        return PageAllocator::round_up(heap_hardening_detail::kCanarySize, alignment);
+    }
+
+    // Проверяет яд свободного блока перед повторной выдачей. Вызывается до take_block,
+    // чтобы при ошибке блок остался свободным, а не потерялся занятым
+    void verify_poison(MemoryBlock &block)
+    {
+        if (!block.poisoned)
+        {
+            return;
+        }
+        SanitizerAnnotations::mark_defined(block.ptr, block.size);
+        const size_t damage = heap_hardening_detail::find_poison_damage(block.ptr, block.size);
+        SanitizerAnnotations::poison(block.ptr, block.size);
+        block.poisoned = false;
+        if (damage != block.size)
+        {
+            report(HeapErrorKind::UseAfterFree, block.ptr, block.size,
+                   "байт по смещению " + std::to_string(damage) + " изменён после освобождения");
+        }
+    }
+
+    // Готовит блок к выдаче на bytes байт: расставляет канарейки
+    void arm_block(MemoryBlock &block, size_t bytes)
+    {
+        using namespace heap_hardening_detail;
+
+        // Служебный доступ ко всему блоку; в конце остаток после bytes снова отравляется
+        SanitizerAnnotations::mark_defined(block.ptr, block.size);
+
+        block.requested = bytes;
+        if (hardening_.canaries)
+        {
+            char *ptr = static_cast<char *>(block.ptr);
+            write_canary(ptr - kCanarySize);
+            if (bytes + kCanarySize <= block.usable)
+            {
+                write_canary(ptr + bytes);
+            }
+        }
+
+        SanitizerAnnotations::mark_uninitialized(block.ptr, bytes);
+        SanitizerAnnotations::poison(static_cast<char *>(block.ptr) + bytes, block.size - bytes);
+    }
+
+    // Проверяет канарейки занятого блока; возвращает число найденных повреждений
+    size_t verify_canaries(const MemoryBlock &block, bool can_throw = true)
+    {
+        using namespace heap_hardening_detail;
+
+        if (!hardening_.canaries || !block.raw)
+        {
+            return 0;
+        }
+
+        size_t errors = 0;
+        const char *ptr = static_cast<const char *>(block.ptr);
+        if (!check_canary(ptr - kCanarySize))
+        {
+            ++errors;
+            report(HeapErrorKind::BufferUnderflow, block.ptr, block.size,
+                   "перезаписана канарейка перед блоком", can_throw);
+        }
+        if (block.requested + kCanarySize <= block.usable)
+        {
+            // Хвостовая канарейка может лежать в отравленном остатке блока
+            const char *tail = ptr + block.requested;
+            SanitizerAnnotations::mark_defined(tail, kCanarySize);
+            const bool intact = check_canary(tail);
+            if (block.requested < block.size)
+            {
+                SanitizerAnnotations::poison(tail, std::min(kCanarySize, block.size - block.requested));
+            }
+            if (!intact)
+            {
+                ++errors;
+                report(HeapErrorKind::BufferOverflow, block.ptr, block.size,
+                       "запись за пределы " + std::to_string(block.requested) + " запрошенных байт", can_throw);
+            }
+        }
+        return errors;
+    }
+
+    // Выделяет новый блок усиленного режима: [канарейка][данные][канарейка]
+    // или, для больших блоков, [канарейка][данные][защитная страница]
+    void *allocate_hardened(size_t bytes, size_t alignment)
+    {
+        const size_t front = hardened_front(alignment);
+        MemoryBlock block;
+        block.size = bytes;
+        block.alignment = alignment;
+        block.requested_alignment = alignment;
+
+        if (hardening_.guard_pages && bytes >= hardening_.guard_page_threshold &&
+            alignment <= PageAllocator::page_size() && PageAllocator::supported())
+        {
+            const size_t body = PageAllocator::round_up(bytes, alignment);
+            const size_t mapped = PageAllocator::round_up(front + body, PageAllocator::page_size()) + PageAllocator::page_size();
+            charge_footprint(mapped);
+            MappedRegion region = PageAllocator::map_guarded(front + body);
+            if (!region.ptr)
+            {
+                uncharge_footprint(mapped);
+            }
+            else
+            {
+                // Конец данных прижат к защитной странице (с точностью до выравнивания)
+                char *guard = static_cast<char *>(region.ptr) + region.size - PageAllocator::page_size();
+                block.ptr = guard - body;
+                block.raw = region.ptr;
+                block.mapped_size = region.size;
+                block.usable = body;
+                block.guarded = true;
+            }
+        }
+
+        if (!block.ptr)
+        {
+            const size_t total = front + bytes + heap_hardening_detail::kCanarySize;
+            charge_footprint(total);
+            char *raw;
+            try
+            {
+                raw = static_cast<char *>(::operator new(total, std::align_val_t(alignment)));
+            }
+            catch (...)
+            {
+                uncharge_footprint(total);
+                throw;
+            }
+            block.raw = raw;
+            block.ptr = raw + front;
+            block.usable = bytes + heap_hardening_detail::kCanarySize;
+        }
+
+        allocated_blocks_.push_back(block);
+        arm_block(allocated_blocks_.back(), bytes);
+        total_allocated_bytes_ += bytes;
+
+        if (verbose_)
+        {
+            std::cout << "CustomMemoryResource: выделен защищённый блок "
+                      << block.ptr << " размером " << bytes << " байт"
+                      << (block.guarded ? " (с защитной страницей)" : "") << "\n";
+        }
+
+        return block.ptr;
+    }
+
+    // Освобождение в усиленном режиме: проверки, яд, карантин. Не бросает (см. report)
+    void release_hardened(void *ptr, size_t bytes, size_t alignment)
     {
-        // Пытаемся найти уже существующий свободный блок, который подходит по размеру и выравниванию
         auto it = std::find_if(allocated_blocks_.begin(), allocated_blocks_.end(),
-                               [bytes, alignment](const MemoryBlock &block)
+                               [ptr](const MemoryBlock &block)
                                {
-                                   // Блок подходит, если:
-                                   // 1. Он помечен как свободный (free == true)
-                                   // 2. Он достаточно большой (size >= bytes)
-                                   // 3. У него правильное выравнивание (alignment совпадает)
-                                   return block.free && block.size >= bytes && block.alignment == alignment;
+                                   return block.ptr == ptr;
                                });
+        if (it == allocated_blocks_.end())
+        {
+            report(HeapErrorKind::InvalidFree, ptr, bytes, "указатель не выдавался этим ресурсом", false);
+            return;
+        }
+
+        MemoryBlock &block = *it;
+        if (block.free)
+        {
+            report(HeapErrorKind::DoubleFree, ptr, block.size,
+                   block.quarantined ? "блок уже в карантине" : "блок уже свободен", false);
+            return;
+        }
+        if (bytes != block.requested || alignment != block.requested_alignment)
+        {
+            report(HeapErrorKind::SizeMismatch, ptr, block.size,
+                   "освобождается " + std::to_string(bytes) + " байт с выравниванием " +
+                       std::to_string(alignment) + ", выделено " + std::to_string(block.requested) +
+                       " байт с выравниванием " + std::to_string(block.requested_alignment),
+                   false);
+        }
+        verify_canaries(block, false);
+
+        block.free = true;
+        total_deallocated_bytes_ += bytes;
+
+        if (hardening_.poison)
+        {
+            SanitizerAnnotations::mark_defined(block.ptr, block.size);
+            std::memset(block.ptr, heap_hardening_detail::kFreedPoison, block.size);
+            block.poisoned = true;
+        }
+        SanitizerAnnotations::poison(block.ptr, block.size);
+
+        if (hardening_.quarantine_size != 0)
+        {
+            block.quarantined = true;
+            if (block.guarded)
+            {
+                // Любое обращение к блоку в карантине - сразу SIGSEGV
+                PageAllocator::protect(block.raw, block.mapped_size - PageAllocator::page_size(), false);
+            }
+            quarantine_.push_back(&block);
+            while (quarantine_.size() > hardening_.quarantine_size)
+            {
+                MemoryBlock *oldest = quarantine_.front();
+                quarantine_.pop_front();
+                if (oldest->guarded)
+                {
+                    PageAllocator::protect(oldest->raw, oldest->mapped_size - PageAllocator::page_size(), true);
+                }
+                oldest->quarantined = false;
+                index_free_block(*oldest);
+            }
+        }
+        else
+        {
+            index_free_block(block);
+        }
+
+        if (verbose_)
+        {
+            std::cout << "CustomMemoryResource: освобожден защищённый блок "
+                      << ptr << " размером " << bytes << " байт\n";
+        }
+    }
+
+    // Выделяет большой блок из выровненного на 2 МБ mmap-региона.
+    // Возвращает nullptr, если путь недоступен и нужно откатиться на ::operator new
+    void *allocate_large(size_t bytes, size_t alignment)
+    {
+        if (large_allocation_threshold_ == 0 || bytes < large_allocation_threshold_ ||
+            alignment > PageAllocator::kHugePageSize || !PageAllocator::supported())
+        {
+            return nullptr;
+        }
+
+        const size_t mapped = PageAllocator::round_up(bytes, PageAllocator::kHugePageSize);
+        charge_footprint(mapped);
+        MappedRegion region = PageAllocator::map_huge(bytes, use_hugetlb_);
+        if (!region.ptr)
+        {
+            uncharge_footprint(mapped);
+            return nullptr;
+        }
+
+        allocated_blocks_.push_back({region.ptr, bytes, alignment, false, region.size});
+        allocated_blocks_.back().requested = bytes;
+        allocated_blocks_.back().requested_alignment = alignment;
+        total_allocated_bytes_ += bytes;
+
+        if (verbose_)
+        {
+            std::cout << "CustomMemoryResource: выделен большой блок "
+                      << region.ptr << " размером " << bytes << " байт ("
+                      << (region.hugetlb ? "MAP_HUGETLB" : "MADV_HUGEPAGE") << ")\n";
+        }
+
+        return region.ptr;
+    }
+
+    // Находит подходящий свободный блок или выделяет новый
+    void *allocate_block(size_t bytes, size_t alignment)
+    {
+        // Пытаемся найти уже существующий свободный блок, который подходит по размеру и выравниванию
+        MemoryBlock *reused = find_free_block(bytes, alignment);
 
         // Если нашли подходящий свободный блок
-        if (it != allocated_blocks_.end())
+        if (reused)
         {
+            // Яд проверяется до выдачи: если он испорчен, блок остаётся свободным
+            if (reused->raw)
+            {
+                verify_poison(*reused);
+            }
+
             // Помечаем блок как занятый (теперь он снова используется)
-            it->free = false;
+            take_block(*reused, bytes, alignment);
+
+            // Защищённому блоку заново расставляем канарейки под новый размер
+            if (reused->raw)
+            {
+                arm_block(*reused, bytes);
+            }
+            else
+            {
+                // Для санитайзеров блок снова доступен, но не инициализирован; хвост сверх bytes остаётся отравленным
+                SanitizerAnnotations::mark_uninitialized(reused->ptr, bytes);
+            }
 
             // Если включен режим отладки, выводим информацию
             if (verbose_)
             {
                 std::cout << "CustomMemoryResource: переиспользован блок "
-                          << it->ptr << " размером " << it->size << " байт\n";
+                          << reused->ptr << " размером " << reused->size << " байт\n";
             }
 
             // Возвращаем адрес этого блока
-            return it->ptr;
+            return reused->ptr;
+        }
+
+        ++reuse_misses_;
+
+        // В усиленном режиме каждый новый блок окружён канарейками
+        if (hardening_.enabled())
+        {
+            return allocate_hardened(bytes, alignment);
+        }
+
+        // Большие запросы обслуживаем из mmap с большими страницами (если включено)
+        if (void *large = allocate_large(bytes, alignment))
+        {
+            return large;
         }
 
         // Если не нашли подходящий блок, выделяем новую память на куче
         // ::operator new - это глобальная функция выделения памяти
         // std::align_val_t нужен для правильного выравнивания памяти
-        void *ptr = ::operator new(bytes, std::align_val_t(alignment));
+        charge_footprint(bytes);
+        void *ptr;
+        try
+        {
+            ptr = ::operator new(bytes, std::align_val_t(alignment));
+        }
+        catch (...)
+        {
+            uncharge_footprint(bytes);
+            throw;
+        }
 
         // Добавляем информацию о новом блоке в наш список
         // {ptr, bytes, alignment, false} - создаём структуру MemoryBlock
         // false означает, что блок занят (не свободен)
         allocated_blocks_.push_back({ptr, bytes, alignment, false});
+        allocated_blocks_.back().requested = bytes;
+        allocated_blocks_.back().requested_alignment = alignment;
 
         // Обновляем статистику: увеличиваем счётчик выделенных байт
         total_allocated_bytes_ += bytes;
@@ -84,8 +697,15 @@ protected:
         return ptr;
     }
 
-    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    // Помечает блок свободным; неизвестные указатели игнорируются (кроме усиленного режима)
+    void release_block(void *ptr, size_t bytes, size_t alignment)
     {
+        if (hardening_.enabled() && ptr)
+        {
+            release_hardened(ptr, bytes, alignment);
+            return;
+        }
+
         // Ищем блок с указанным адресом в нашем списке
         auto it = std::find_if(allocated_blocks_.begin(), allocated_blocks_.end(),
                                [ptr](const MemoryBlock &block)
@@ -100,6 +720,10 @@ protected:
             // Просто помечаем блок как свободный, но НЕ удаляем его из списка!
             // Это ключевой момент: блок остаётся в памяти и может быть переиспользован
             it->free = true;
+            index_free_block(*it);
+
+            // Санитайзеры должны видеть обращение к кэшированному блоку как use-after-free
+            SanitizerAnnotations::poison(it->ptr, it->size);
 
             // Обновляем статистику: увеличиваем счётчик освобождённых байт
             total_deallocated_bytes_ += bytes;
@@ -114,13 +738,93 @@ protected:
         // Если блок не найден - ничего не делаем (это нормально, может быть вызов с nullptr)
     }
 
-    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    // Сообщает наблюдателям о пакетно выделенных блоках
+    void notify_batch_allocated(void *const *ptrs, size_t count, size_t bytes, size_t alignment)
     {
-        return this == &other;
+        for (AllocationObserver *observer : observers_)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                observer->on_allocate(ptrs[i], bytes, alignment);
+            }
+        }
     }
 
-public:
-    /**
+    // Пакетно помечает блоки свободными, не уведомляя наблюдателей
+    void release_batch(void *const *ptrs, size_t count, size_t bytes, size_t alignment)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (hardening_.enabled())
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                release_block(ptrs[i], bytes, alignment);
+            }
+            return;
+        }
+
+        std::vector<void *> sorted(ptrs, ptrs + count);
+        std::sort(sorted.begin(), sorted.end());
+
+        size_t released = 0;
+        for (auto &block : allocated_blocks_)
+        {
+            if (released == count)
+            {
+                break;
+            }
+            if (!block.free && std::binary_search(sorted.begin(), sorted.end(), block.ptr))
+            {
+                block.free = true;
+                index_free_block(block);
+                SanitizerAnnotations::poison(block.ptr, block.size);
+                ++released;
+            }
+        }
+        total_deallocated_bytes_ += bytes * released;
+
+        if (verbose_)
+        {
+            std::cout << "CustomMemoryResource: пакетно освобождено " << released << " блоков\n";
+        }
+    }
+
+protected:
+    LAB5_NOINLINE void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        // Граница стека нужна только наблюдателям
+        AllocationCallSite::Scope call_site(observers_.empty() ? nullptr : LAB5_RETURN_ADDRESS());
+        void *ptr = allocate_block(bytes, alignment);
+
+        for (AllocationObserver *observer : observers_)
+        {
+            observer->on_allocate(ptr, bytes, alignment);
+        }
+
+        return ptr;
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        for (AllocationObserver *observer : observers_)
+        {
+            observer->on_deallocate(ptr, bytes, alignment);
+        }
+
+        release_block(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    /**
      * Конструктор по умолчанию.
      * Создаёт пустой менеджер памяти без выделенных блоков.
      */
@@ -131,9 +835,23 @@ public:
         // Проходим по всем блокам в списке
         for (auto &block : allocated_blocks_)
         {
-            // Физически удаляем блок памяти с помощью глобального оператора delete
-            // Важно передать alignment, чтобы память удалилась корректно
-            ::operator delete(block.ptr, std::align_val_t(block.alignment));
+            // Нарезанные блоки освобождаются вместе со своим куском ниже
+            if (block.carved)
+            {
+                SanitizerAnnotations::mark_defined(block.ptr, block.size);
+                continue;
+            }
+            free_block_memory(block);
+        }
+
+        for (auto &chunk : chunks_)
+        {
+            free_chunk_memory(chunk);
+        }
+
+        if (budget_)
+        {
+            budget_->release(footprint_bytes_);
         }
 
         // Если включен режим отладки, выводим итоговую статистику
@@ -149,6 +867,395 @@ public:
 
     void set_verbose(bool verbose) { verbose_ = verbose; }
 
+    /**
+     * Включает путь для больших выделений: запросы размером не меньше threshold
+     * байт обслуживаются из выровненных на 2 МБ mmap-регионов с MADV_HUGEPAGE
+     * (или из MAP_HUGETLB, если use_hugetlb == true и страницы зарезервированы).
+     * threshold == 0 выключает путь.
+     */
+    void set_large_allocation_threshold(size_t threshold, bool use_hugetlb = false)
+    {
+        large_allocation_threshold_ = threshold;
+        use_hugetlb_ = use_hugetlb;
+    }
+
+    size_t get_large_allocation_threshold() const { return large_allocation_threshold_; }
+
+    /**
+     * Включает усиленный режим проверки (или выключает, если options.enabled() == false).
+     * Блоки получают канарейки, освобождённые блоки заполняются ядом и проходят
+     * через карантин, большие блоки прижимаются к защитной странице. Ошибки
+     * (переполнение, double free, чужой указатель, несовпадение размера,
+     * запись после освобождения) обрабатываются согласно options.action.
+     * В усиленном режиме путь больших страниц и нарезка пакетов не используются.
+     * Менять режим можно только до первого выделения.
+     */
+    void set_hardening(const HardeningOptions &options)
+    {
+        if (!allocated_blocks_.empty())
+        {
+            throw std::logic_error("CustomMemoryResource::set_hardening: режим можно менять только до первого выделения");
+        }
+        hardening_ = options;
+    }
+
+    const HardeningOptions &get_hardening() const { return hardening_; }
+
+    /**
+     * Проверяет канарейки всех занятых блоков и яд всех свободных.
+     * Каждая найденная ошибка обрабатывается согласно hardening action.
+     * Возвращает число найденных ошибок.
+     */
+    size_t check_heap()
+    {
+        size_t errors = 0;
+        for (auto &block : allocated_blocks_)
+        {
+            if (!block.raw)
+            {
+                continue;
+            }
+            if (!block.free)
+            {
+                errors += verify_canaries(block);
+                continue;
+            }
+            // Блок в карантине за защитной страницей недоступен для чтения, и проверять его не нужно
+            if (block.poisoned && !(block.quarantined && block.guarded))
+            {
+                SanitizerAnnotations::mark_defined(block.ptr, block.size);
+                const size_t damage = heap_hardening_detail::find_poison_damage(block.ptr, block.size);
+                SanitizerAnnotations::poison(block.ptr, block.size);
+                if (damage != block.size)
+                {
+                    ++errors;
+                    report(HeapErrorKind::UseAfterFree, block.ptr, block.size,
+                           "байт по смещению " + std::to_string(damage) + " изменён после освобождения");
+                }
+            }
+        }
+        return errors;
+    }
+
+    size_t get_hardening_errors_count() const { return hardening_errors_; }
+
+    /**
+     * Выбирает политику повторного использования свободных блоков.
+     * BestFit и GoodFit ищут по упорядоченному индексу (alignment, size) за O(log n);
+     * GoodFit отказывается от блока, если в нём пропадёт больше waste_ratio его размера,
+     * и тогда выделяет новый. Политику можно менять в любой момент: индекс перестраивается.
+     */
+    void set_placement_policy(PlacementPolicy policy, double waste_ratio = 0.25)
+    {
+        if (waste_ratio < 0.0 || waste_ratio > 1.0)
+        {
+            throw std::invalid_argument("CustomMemoryResource::set_placement_policy: waste_ratio должен быть в [0, 1]");
+        }
+        placement_policy_ = policy;
+        waste_ratio_ = waste_ratio;
+
+        free_index_.clear();
+        for (auto &block : allocated_blocks_)
+        {
+            if (block.free && !block.quarantined)
+            {
+                index_free_block(block);
+            }
+        }
+    }
+
+    PlacementPolicy get_placement_policy() const { return placement_policy_; }
+
+    double get_waste_ratio() const { return waste_ratio_; }
+
+    // Сколько запросов обслужено свободными блоками и сколько потребовало новой памяти
+    size_t get_reuse_hits() const { return reuse_hits_; }
+    size_t get_reuse_misses() const { return reuse_misses_; }
+
+    // Сколько повторных выдач пришлось на блоки, выделенные с другим выравниванием
+    size_t get_cross_alignment_hits() const { return cross_alignment_hits_; }
+
+    // Доля запросов, обслуженных без новой памяти
+    double get_reuse_hit_rate() const
+    {
+        const size_t total = reuse_hits_ + reuse_misses_;
+        return total == 0 ? 0.0 : static_cast<double>(reuse_hits_) / static_cast<double>(total);
+    }
+
+    // Внутренняя фрагментация: байты занятых блоков сверх запрошенного размера
+    size_t get_internal_waste_bytes() const
+    {
+        size_t waste = 0;
+        for (const auto &block : allocated_blocks_)
+        {
+            if (!block.free)
+            {
+                waste += block.size - block.requested;
+            }
+        }
+        return waste;
+    }
+
+    size_t get_quarantined_blocks_count() const { return quarantine_.size(); }
+
+    /**
+     * Подключает лимит памяти (nullptr - снять лимит). Учитывается память,
+     * которую ресурс держит у системы, включая кэш свободных блоков; повторная
+     * выдача кэшированного блока бюджет не трогает. Уже взятая память
+     * переносится в новый бюджет; если она туда не помещается - std::logic_error.
+     * Бюджет должен жить дольше ресурса.
+     */
+    void set_memory_budget(MemoryBudget *budget)
+    {
+        if (budget == budget_)
+        {
+            return;
+        }
+        if (budget && footprint_bytes_ != 0 && budget->try_charge(footprint_bytes_))
+        {
+            throw std::logic_error("CustomMemoryResource::set_memory_budget: уже взятая память не помещается в бюджет");
+        }
+        if (budget_)
+        {
+            budget_->release(footprint_bytes_);
+        }
+        budget_ = budget;
+    }
+
+    MemoryBudget *get_memory_budget() const { return budget_; }
+
+    /**
+     * Обработчик давления: вызывается с размером запроса и переполненным
+     * уровнем бюджета, когда места нет даже после освобождения кэша.
+     * Обработчик может сбросить нагрузку (освободить массивы, в том числе из
+     * этого ресурса), после чего запрос повторяется один раз.
+     */
+    void set_pressure_handler(std::function<void(size_t, MemoryBudget &)> handler)
+    {
+        pressure_handler_ = std::move(handler);
+    }
+
+    /**
+     * Возвращает системе свободные блоки из кэша (кроме блоков в карантине)
+     * и куски пакетного выделения, все блоки которых свободны.
+     * Возвращает число освобождённых байт.
+     */
+    size_t release_free_blocks()
+    {
+        size_t released = 0;
+        for (auto it = allocated_blocks_.begin(); it != allocated_blocks_.end();)
+        {
+            MemoryBlock &block = *it;
+            if (!block.free || block.quarantined || block.carved)
+            {
+                ++it;
+                continue;
+            }
+            unindex_free_block(block);
+            const size_t bytes = block_footprint(block);
+            free_block_memory(block);
+            uncharge_footprint(bytes);
+            released += bytes;
+            it = allocated_blocks_.erase(it);
+        }
+
+        for (auto chunk = chunks_.begin(); chunk != chunks_.end();)
+        {
+            char *begin = static_cast<char *>(chunk->ptr);
+            char *end = begin + chunk->size;
+            auto inside = [begin, end](const MemoryBlock &block)
+            {
+                return block.carved && static_cast<char *>(block.ptr) >= begin && static_cast<char *>(block.ptr) < end;
+            };
+            const bool busy = std::any_of(allocated_blocks_.begin(), allocated_blocks_.end(),
+                                          [&inside](const MemoryBlock &block)
+                                          {
+                                              return inside(block) && (!block.free || block.quarantined);
+                                          });
+            if (busy)
+            {
+                ++chunk;
+                continue;
+            }
+            for (auto it = allocated_blocks_.begin(); it != allocated_blocks_.end();)
+            {
+                if (inside(*it))
+                {
+                    unindex_free_block(*it);
+                    it = allocated_blocks_.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            const size_t bytes = chunk->size;
+            free_chunk_memory(*chunk);
+            uncharge_footprint(bytes);
+            released += bytes;
+            chunk = chunks_.erase(chunk);
+        }
+
+        reclaimed_bytes_ += released;
+        if (verbose_ && released != 0)
+        {
+            std::cout << "CustomMemoryResource: возвращено системе " << released << " байт кэша\n";
+        }
+        return released;
+    }
+
+    // Сколько байт ресурс держит у системы прямо сейчас
+    size_t get_footprint_bytes() const { return footprint_bytes_; }
+
+    size_t get_budget_pressure_events() const { return budget_pressure_events_; }
+
+    size_t get_reclaimed_bytes() const { return reclaimed_bytes_; }
+
+    /**
+     * Снимок распределения блоков ресурса (занятых и свободных) по размеру
+     * и выравниванию. Снимается в установившемся режиме, сохраняется через
+     * WarmProfile::save и при следующем запуске передаётся в prewarm.
+     */
+    WarmProfile capture_warm_profile() const
+    {
+        WarmProfile profile;
+        for (const auto &block : allocated_blocks_)
+        {
+            profile.add(block.size, block.alignment);
+        }
+        return profile;
+    }
+
+    /**
+     * Заранее создаёт свободные блоки по профилю, чтобы первые запросы после
+     * запуска брали их из кэша, а не из ::operator new с page fault'ами.
+     * Блоки нарезаются из одного региона, страницы которого подгружаются
+     * сразу (MAP_POPULATE). Прогрев добирает свободные блоки каждого класса
+     * до числа из профиля, поэтому повторный вызов ничего не делает. Классы
+     * с выравниванием больше страницы пропускаются. В усиленном режиме у
+     * каждого блока свои канарейки, поэтому прогрев не выполняется.
+     * Возвращает число добавленных блоков; регион учитывается в бюджете.
+     * Профиль, которому нужен регион больше WarmProfile::kMaxRegionBytes,
+     * отвергается с std::length_error до каких-либо изменений.
+     */
+    size_t prewarm(const WarmProfile &profile)
+    {
+        if (hardening_.enabled())
+        {
+            return 0;
+        }
+
+        // Сколько блоков каждого класса не хватает и где они лягут в регионе
+        struct Plan
+        {
+            size_t size;
+            size_t alignment;
+            size_t stride;
+            size_t missing;
+            size_t offset;
+        };
+        const std::vector<WarmProfileEntry> entries = profile.entries();
+
+        // Свободные блоки классов профиля - за один проход по списку
+        std::map<std::pair<size_t, size_t>, size_t> free_counts;
+        for (const WarmProfileEntry &entry : entries)
+        {
+            free_counts[{entry.size, entry.alignment}] = 0;
+        }
+        for (const auto &block : allocated_blocks_)
+        {
+            if (block.free)
+            {
+                auto it = free_counts.find({block.size, block.alignment});
+                if (it != free_counts.end())
+                {
+                    ++it->second;
+                }
+            }
+        }
+
+        std::vector<Plan> plans;
+        size_t total = 0;
+        for (const WarmProfileEntry &entry : entries)
+        {
+            const size_t existing = free_counts[{entry.size, entry.alignment}];
+            if (entry.alignment > PageAllocator::page_size() || existing >= entry.count)
+            {
+                continue;
+            }
+            const size_t missing = entry.count - existing;
+            const size_t offset = PageAllocator::round_up(total, entry.alignment);
+            if (!WarmProfile::extend_region(total, entry.size, entry.alignment, missing))
+            {
+                throw std::length_error("CustomMemoryResource::prewarm: профиль больше допустимого региона");
+            }
+            const size_t stride = PageAllocator::round_up(std::max<size_t>(entry.size, 1), entry.alignment);
+            plans.push_back({entry.size, entry.alignment, stride, missing, offset});
+        }
+        if (plans.empty())
+        {
+            return 0;
+        }
+
+        const size_t page = PageAllocator::page_size();
+        const size_t region_size = PageAllocator::round_up(total, page);
+        charge_footprint(region_size);
+        Chunk chunk;
+        MappedRegion region = PageAllocator::map_populated(region_size);
+        if (region.ptr)
+        {
+            chunk = {region.ptr, page, region.size, region.size};
+        }
+        else
+        {
+            try
+            {
+                chunk = {::operator new(region_size, std::align_val_t(page)), page, region_size, 0};
+            }
+            catch (...)
+            {
+                uncharge_footprint(region_size);
+                throw;
+            }
+            PageAllocator::prefault(chunk.ptr, region_size);
+        }
+        chunks_.push_back(chunk);
+
+        char *base = static_cast<char *>(chunk.ptr);
+        SanitizerAnnotations::poison(base, chunk.size);
+        size_t added = 0;
+        for (const Plan &plan : plans)
+        {
+            for (size_t i = 0; i < plan.missing; ++i)
+            {
+                allocated_blocks_.push_back({base + plan.offset + i * plan.stride, plan.size, plan.alignment, true, 0, true});
+                index_free_block(allocated_blocks_.back());
+            }
+            added += plan.missing;
+        }
+
+        if (verbose_)
+        {
+            std::cout << "CustomMemoryResource: прогрето " << added << " блоков в регионе "
+                      << region_size << " байт\n";
+        }
+        return added;
+    }
+
+    // Подключает наблюдателя; ресурс не владеет им, наблюдатель должен жить дольше ресурса
+    void add_observer(AllocationObserver *observer)
+    {
+        if (observer && std::find(observers_.begin(), observers_.end(), observer) == observers_.end())
+        {
+            observers_.push_back(observer);
+        }
+    }
+
+    void remove_observer(AllocationObserver *observer)
+    {
+        observers_.erase(std::remove(observers_.begin(), observers_.end(), observer), observers_.end());
+    }
+
     void print_allocated_blocks() const
     {
         std::cout << "=== Информация о блоках памяти ===\n";
@@ -162,6 +1269,8 @@ public:
                       << ", size=" << block.size
                       << ", alignment=" << block.alignment
                       << ", status=" << (block.free ? "FREE" : "USED")
+                      << (block.mapped_size != 0 ? ", mmap" : "")
+                      << (block.quarantined ? ", quarantine" : "")
                       << "\n";
         }
 
@@ -191,6 +1300,160 @@ public:
                              });
     }
 
+    /**
+     * Пакетное выделение count блоков по bytes байт с одинаковым выравниванием.
+     * Сначала за один проход по списку забираются подходящие свободные блоки,
+     * а недостающие нарезаются из одного непрерывного куска памяти.
+     * Адреса записываются в out_ptrs[0..count).
+     */
+    LAB5_NOINLINE void allocate_batch(size_t count, size_t bytes, size_t alignment, void **out_ptrs)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        AllocationCallSite::Scope call_site(observers_.empty() ? nullptr : LAB5_RETURN_ADDRESS());
+
+        size_t filled = 0;
+
+        // В усиленном режиме у каждого блока свои канарейки: нарезка из общего куска не используется
+        if (hardening_.enabled())
+        {
+            try
+            {
+                for (; filled < count; ++filled)
+                {
+                    out_ptrs[filled] = allocate_block(bytes, alignment);
+                }
+            }
+            catch (...)
+            {
+                release_batch(out_ptrs, filled, bytes, alignment);
+                throw;
+            }
+            notify_batch_allocated(out_ptrs, count, bytes, alignment);
+            return;
+        }
+
+        if (uses_free_index())
+        {
+            // Забираем свободные блоки по индексу, пока политика их принимает
+            while (filled < count)
+            {
+                MemoryBlock *block = find_free_block(bytes, alignment);
+                if (!block)
+                {
+                    break;
+                }
+                take_block(*block, bytes, alignment);
+                SanitizerAnnotations::mark_uninitialized(block->ptr, bytes);
+                out_ptrs[filled++] = block->ptr;
+            }
+        }
+        else
+        {
+            // Один проход по списку: забираем все подходящие свободные блоки
+            for (auto &block : allocated_blocks_)
+            {
+                if (filled == count)
+                {
+                    break;
+                }
+                if (block_fits(block, bytes, alignment))
+                {
+                    take_block(block, bytes, alignment);
+                    SanitizerAnnotations::mark_uninitialized(block.ptr, bytes);
+                    out_ptrs[filled++] = block.ptr;
+                }
+            }
+        }
+        const size_t reused = filled;
+
+        // Оставшиеся блоки нарезаем из одного куска с шагом, кратным выравниванию
+        if (filled < count)
+        {
+            const size_t stride = (std::max<size_t>(bytes, 1) + alignment - 1) / alignment * alignment;
+            const size_t missing = count - filled;
+            try
+            {
+                charge_footprint(stride * missing);
+            }
+            catch (...)
+            {
+                // Бюджет не пустил: уже выданные из кэша блоки возвращаем обратно.
+                // Наблюдатели о них ещё не знали, поэтому и об освобождении не узнают
+                release_batch(out_ptrs, filled, bytes, alignment);
+                throw;
+            }
+            char *chunk;
+            try
+            {
+                chunk = static_cast<char *>(::operator new(stride * missing, std::align_val_t(alignment)));
+            }
+            catch (...)
+            {
+                uncharge_footprint(stride * missing);
+                release_batch(out_ptrs, filled, bytes, alignment);
+                throw;
+            }
+            chunks_.push_back({chunk, alignment, stride * missing});
+
+            for (size_t i = 0; i < missing; ++i)
+            {
+                void *ptr = chunk + i * stride;
+                // Промежуток до следующего блока недоступен: переполнение сразу видно санитайзеру
+                SanitizerAnnotations::poison(chunk + i * stride + bytes, stride - bytes);
+                allocated_blocks_.push_back({ptr, bytes, alignment, false, 0, true});
+                allocated_blocks_.back().requested = bytes;
+                allocated_blocks_.back().requested_alignment = alignment;
+                out_ptrs[filled++] = ptr;
+            }
+            total_allocated_bytes_ += bytes * missing;
+            reuse_misses_ += missing;
+        }
+
+        if (verbose_)
+        {
+            std::cout << "CustomMemoryResource: пакетно выделено " << count << " блоков по "
+                      << bytes << " байт (переиспользовано " << reused << ")\n";
+        }
+
+        notify_batch_allocated(out_ptrs, count, bytes, alignment);
+    }
+
+    /**
+     * Пакетное освобождение: помечает свободными все блоки из ptrs за один
+     * проход по списку. Неизвестные указатели игнорируются, как в do_deallocate.
+     */
+    void deallocate_batch(void *const *ptrs, size_t count, size_t bytes, size_t alignment)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        for (AllocationObserver *observer : observers_)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                observer->on_deallocate(ptrs[i], bytes, alignment);
+            }
+        }
+
+        release_batch(ptrs, count, bytes, alignment);
+    }
+
+    size_t get_chunks_count() const { return chunks_.size(); }
+
+    size_t get_mapped_blocks_count() const
+    {
+        return std::count_if(allocated_blocks_.begin(), allocated_blocks_.end(),
+                             [](const MemoryBlock &block)
+                             {
+                                 return block.mapped_size != 0;
+                             });
+    }
+
     size_t get_total_allocated_bytes() const { return total_allocated_bytes_; }
 
     size_t get_total_deallocated_bytes() const { return total_deallocated_bytes_; }
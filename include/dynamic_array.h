@@ -5,6 +5,19 @@
 #include <iterator>
 #include <stdexcept>
 #include <algorithm>
+#include <new>
+#include <type_traits>
+
+#ifdef LAB5_GROWTH_STATS
+#include "growth_stats.h"
+#endif
+
+// Тег для конструктора, который принимает во владение уже выделенный буфер
+struct adopt_buffer_t
+{
+    explicit adopt_buffer_t() = default;
+};
+inline constexpr adopt_buffer_t adopt_buffer{};
 
 template <typename T>
 class DynamicArray
@@ -28,22 +41,22 @@ public:
         using pointer = T *;
         using reference = T &;
 
-        Iterator() : ptr_(nullptr) {}
-        explicit Iterator(pointer ptr) : ptr_(ptr) {}
+        constexpr Iterator() : ptr_(nullptr) {}
+        constexpr explicit Iterator(pointer ptr) : ptr_(ptr) {}
 
-        reference operator*() const { return *ptr_; }
-        pointer operator->() const { return ptr_; }
-        reference operator[](difference_type n) const { return ptr_[n]; }
+        constexpr reference operator*() const { return *ptr_; }
+        constexpr pointer operator->() const { return ptr_; }
+        constexpr reference operator[](difference_type n) const { return ptr_[n]; }
 
         // Префиксный инкремент
-        Iterator &operator++()
+        constexpr Iterator &operator++()
         {
             ++ptr_;
             return *this;
         }
 
         // Постфиксный инкремент
-        Iterator operator++(int)
+        constexpr Iterator operator++(int)
         {
             Iterator temp = *this;
             ++ptr_;
@@ -51,14 +64,14 @@ public:
         }
 
         // Префиксный декремент
-        Iterator &operator--()
+        constexpr Iterator &operator--()
         {
             --ptr_;
             return *this;
         }
 
         // Постфиксный декремент
-        Iterator operator--(int)
+        constexpr Iterator operator--(int)
         {
             Iterator temp = *this;
             --ptr_;
@@ -66,40 +79,40 @@ public:
         }
 
         // Арифметика указателей
-        Iterator &operator+=(difference_type n)
+        constexpr Iterator &operator+=(difference_type n)
         {
             ptr_ += n;
             return *this;
         }
 
-        Iterator &operator-=(difference_type n)
+        constexpr Iterator &operator-=(difference_type n)
         {
             ptr_ -= n;
             return *this;
         }
 
-        Iterator operator+(difference_type n) const
+        constexpr Iterator operator+(difference_type n) const
         {
             return Iterator(ptr_ + n);
         }
 
-        Iterator operator-(difference_type n) const
+        constexpr Iterator operator-(difference_type n) const
         {
             return Iterator(ptr_ - n);
         }
 
-        difference_type operator-(const Iterator &other) const
+        constexpr difference_type operator-(const Iterator &other) const
         {
             return ptr_ - other.ptr_;
         }
 
         // Операторы сравнения
-        bool operator==(const Iterator &other) const { return ptr_ == other.ptr_; }
-        bool operator!=(const Iterator &other) const { return ptr_ != other.ptr_; }
-        bool operator<(const Iterator &other) const { return ptr_ < other.ptr_; }
-        bool operator>(const Iterator &other) const { return ptr_ > other.ptr_; }
-        bool operator<=(const Iterator &other) const { return ptr_ <= other.ptr_; }
-        bool operator>=(const Iterator &other) const { return ptr_ >= other.ptr_; }
+        constexpr bool operator==(const Iterator &other) const { return ptr_ == other.ptr_; }
+        constexpr bool operator!=(const Iterator &other) const { return ptr_ != other.ptr_; }
+        constexpr bool operator<(const Iterator &other) const { return ptr_ < other.ptr_; }
+        constexpr bool operator>(const Iterator &other) const { return ptr_ > other.ptr_; }
+        constexpr bool operator<=(const Iterator &other) const { return ptr_ <= other.ptr_; }
+        constexpr bool operator>=(const Iterator &other) const { return ptr_ >= other.ptr_; }
 
     private:
         pointer ptr_;
@@ -114,23 +127,23 @@ public:
         using pointer = const T *;
         using reference = const T &;
 
-        ConstIterator() : ptr_(nullptr) {}
-        explicit ConstIterator(pointer ptr) : ptr_(ptr) {}
-        ConstIterator(const Iterator &it) : ptr_(&(*it)) {}
+        constexpr ConstIterator() : ptr_(nullptr) {}
+        constexpr explicit ConstIterator(pointer ptr) : ptr_(ptr) {}
+        constexpr ConstIterator(const Iterator &it) : ptr_(it.operator->()) {}
 
-        reference operator*() const { return *ptr_; }
-        pointer operator->() const { return ptr_; }
-        reference operator[](difference_type n) const { return ptr_[n]; }
+        constexpr reference operator*() const { return *ptr_; }
+        constexpr pointer operator->() const { return ptr_; }
+        constexpr reference operator[](difference_type n) const { return ptr_[n]; }
 
         // Префиксный инкремент
-        ConstIterator &operator++()
+        constexpr ConstIterator &operator++()
         {
             ++ptr_;
             return *this;
         }
 
         // Постфиксный инкремент
-        ConstIterator operator++(int)
+        constexpr ConstIterator operator++(int)
         {
             ConstIterator temp = *this;
             ++ptr_;
@@ -138,14 +151,14 @@ public:
         }
 
         // Префиксный декремент
-        ConstIterator &operator--()
+        constexpr ConstIterator &operator--()
         {
             --ptr_;
             return *this;
         }
 
         // Постфиксный декремент
-        ConstIterator operator--(int)
+        constexpr ConstIterator operator--(int)
         {
             ConstIterator temp = *this;
             --ptr_;
@@ -153,40 +166,40 @@ public:
         }
 
         // Арифметика указателей
-        ConstIterator &operator+=(difference_type n)
+        constexpr ConstIterator &operator+=(difference_type n)
         {
             ptr_ += n;
             return *this;
         }
 
-        ConstIterator &operator-=(difference_type n)
+        constexpr ConstIterator &operator-=(difference_type n)
         {
             ptr_ -= n;
             return *this;
         }
 
-        ConstIterator operator+(difference_type n) const
+        constexpr ConstIterator operator+(difference_type n) const
         {
             return ConstIterator(ptr_ + n);
         }
 
-        ConstIterator operator-(difference_type n) const
+        constexpr ConstIterator operator-(difference_type n) const
         {
             return ConstIterator(ptr_ - n);
         }
 
-        difference_type operator-(const ConstIterator &other) const
+        constexpr difference_type operator-(const ConstIterator &other) const
         {
             return ptr_ - other.ptr_;
         }
 
         // Операторы сравнения
-        bool operator==(const ConstIterator &other) const { return ptr_ == other.ptr_; }
-        bool operator!=(const ConstIterator &other) const { return ptr_ != other.ptr_; }
-        bool operator<(const ConstIterator &other) const { return ptr_ < other.ptr_; }
-        bool operator>(const ConstIterator &other) const { return ptr_ > other.ptr_; }
-        bool operator<=(const ConstIterator &other) const { return ptr_ <= other.ptr_; }
-        bool operator>=(const ConstIterator &other) const { return ptr_ >= other.ptr_; }
+        constexpr bool operator==(const ConstIterator &other) const { return ptr_ == other.ptr_; }
+        constexpr bool operator!=(const ConstIterator &other) const { return ptr_ != other.ptr_; }
+        constexpr bool operator<(const ConstIterator &other) const { return ptr_ < other.ptr_; }
+        constexpr bool operator>(const ConstIterator &other) const { return ptr_ > other.ptr_; }
+        constexpr bool operator<=(const ConstIterator &other) const { return ptr_ <= other.ptr_; }
+        constexpr bool operator>=(const ConstIterator &other) const { return ptr_ >= other.ptr_; }
 
     private:
         pointer ptr_;
@@ -211,10 +224,30 @@ public:
         resize(count, value);
     }
 
+    /**
+     * Принимает во владение пустой буфер на capacity элементов, выделенный из mr
+     * (например, через CustomMemoryResource::allocate_batch). Массив освободит его
+     * так же, как собственный: mr->deallocate(buffer, capacity * sizeof(T), alignof(T)).
+     */
+    DynamicArray(adopt_buffer_t, pointer buffer, size_type capacity, std::pmr::memory_resource *mr)
+        : allocator_(mr), data_(buffer), size_(0), capacity_(buffer ? capacity : 0)
+    {
+#ifdef LAB5_GROWTH_STATS
+        // Деструктор отчитается on_release, поэтому принятый буфер учитывается как выделение
+        if (data_)
+        {
+            growth_->on_allocate(capacity_);
+        }
+#endif
+    }
+
     // Конструктор копирования
     DynamicArray(const DynamicArray &other)
         : allocator_(other.allocator_), data_(nullptr), size_(0), capacity_(0)
     {
+#ifdef LAB5_GROWTH_STATS
+        growth_ = other.growth_;
+#endif
         reserve(other.size_);
         for (size_type i = 0; i < other.size_; ++i)
         {
@@ -232,11 +265,20 @@ public:
         other.data_ = nullptr;
         other.size_ = 0;
         other.capacity_ = 0;
+#ifdef LAB5_GROWTH_STATS
+        growth_ = other.growth_;
+#endif
     }
 
     // Деструктор
     ~DynamicArray()
     {
+#ifdef LAB5_GROWTH_STATS
+        if (data_)
+        {
+            growth_->on_release(size_, capacity_);
+        }
+#endif
         clear();
         if (data_)
         {
@@ -259,21 +301,47 @@ public:
         return *this;
     }
 
-    // Оператор перемещающего присваивания
-    DynamicArray &operator=(DynamicArray &&other) noexcept
+    /**
+     * Оператор перемещающего присваивания. Ресурс массива не меняется, как у
+     * pmr-контейнеров: буфер other перенимается, только если ресурсы равны,
+     * иначе элементы переносятся поштучно. Исходный массив остаётся пустым.
+     */
+    DynamicArray &operator=(DynamicArray &&other)
     {
-        if (this != &other)
+        if (this == &other)
+        {
+            return *this;
+        }
+        if (allocator_ != other.allocator_)
+        {
+            clear();
+            reserve(other.size_);
+            for (size_type i = 0; i < other.size_; ++i)
+            {
+                push_back(std::move(other.data_[i]));
+            }
+            other.clear();
+        }
+        else
         {
+#ifdef LAB5_GROWTH_STATS
+            if (data_)
+            {
+                growth_->on_release(size_, capacity_);
+            }
+#endif
             clear();
             if (data_)
             {
                 allocator_.deallocate(data_, capacity_);
             }
 
-            allocator_ = std::move(other.allocator_);
             data_ = other.data_;
             size_ = other.size_;
             capacity_ = other.capacity_;
+#ifdef LAB5_GROWTH_STATS
+            growth_ = other.growth_;
+#endif
 
             other.data_ = nullptr;
             other.size_ = 0;
@@ -324,6 +392,9 @@ public:
     reference back() { return data_[size_ - 1]; }
     const_reference back() const { return data_[size_ - 1]; }
 
+    pointer data() { return data_; }
+    const_pointer data() const { return data_; }
+
     // Размер и емкость
     size_type size() const { return size_; }
     size_type capacity() const { return capacity_; }
@@ -389,6 +460,16 @@ public:
         }
 
         pointer new_data = allocator_.allocate(new_capacity);
+#ifdef LAB5_GROWTH_STATS
+        if (data_)
+        {
+            growth_->on_reallocate(size_, size_ * sizeof(T), new_capacity);
+        }
+        else
+        {
+            growth_->on_allocate(new_capacity);
+        }
+#endif
 
         // Перемещаем существующие элементы
         for (size_type i = 0; i < size_; ++i)
@@ -457,13 +538,116 @@ public:
         size_ = new_size;
     }
 
+    /**
+     * Как resize, но новые элементы инициализируются по умолчанию, а не значением:
+     * у тривиальных типов (int, double, POD-структуры) память остаётся как есть,
+     * без обнуления. Подходит, когда хвост сразу же перезаписывается (чтение из файла).
+     */
+    void resize_default_init(size_type new_size)
+    {
+        if (new_size > capacity_)
+        {
+            reserve(new_size);
+        }
+
+        if (new_size > size_)
+        {
+            if constexpr (!std::is_trivially_default_constructible<T>::value)
+            {
+                for (size_type i = size_; i < new_size; ++i)
+                {
+                    std::allocator_traits<allocator_type>::construct(allocator_, data_ + i);
+                }
+            }
+        }
+        else if (new_size < size_)
+        {
+            for (size_type i = new_size; i < size_; ++i)
+            {
+                std::allocator_traits<allocator_type>::destroy(allocator_, data_ + i);
+            }
+        }
+
+        size_ = new_size;
+    }
+
+    // Увеличивает размер без инициализации новых элементов; только для тривиальных T
+    void resize_uninitialized(size_type new_size)
+    {
+        static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                      "resize_uninitialized: нужен тривиальный тип, используйте resize_default_init");
+        resize_default_init(new_size);
+    }
+
+    /**
+     * Дописывает до count элементов: fn(tail, count) пишет прямо в
+     * неинициализированный хвост буфера. Если fn возвращает число, оно считается
+     * количеством записанных элементов (например, короткое чтение из файла);
+     * иначе записанными считаются все count. При исключении из fn размер не меняется.
+     * Ёмкость растёт геометрически, как у push_back. Возвращает число добавленных элементов.
+     */
+    template <typename Fn>
+    size_type append_with(size_type count, Fn &&fn)
+    {
+        static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                      "append_with: нужен тривиальный тип");
+        if (count == 0)
+        {
+            return 0;
+        }
+        if (size_ + count > capacity_)
+        {
+            reserve(std::max(capacity_ * 2, size_ + count));
+        }
+
+        pointer tail = data_ + size_;
+        size_type written = count;
+        if constexpr (std::is_void<decltype(fn(tail, count))>::value)
+        {
+            fn(tail, count);
+        }
+        else
+        {
+            written = std::min(static_cast<size_type>(fn(tail, count)), count);
+        }
+        size_ += written;
+        return written;
+    }
+
     allocator_type get_allocator() const { return allocator_; }
 
+    /**
+     * Тег, под которым рост массива учитывается в GrowthRegistry (по умолчанию -
+     * имя типа элемента). Без LAB5_GROWTH_STATS вызов ничего не делает.
+     */
+    void set_growth_tag(const char *tag)
+    {
+#ifdef LAB5_GROWTH_STATS
+        growth_ = &GrowthRegistry::instance().counters(tag);
+#else
+        (void)tag;
+#endif
+    }
+
+    /**
+     * Резервирует ёмкость по накопленной статистике тега: до среднего итогового
+     * размера таких массивов. Без LAB5_GROWTH_STATS вызов ничего не делает.
+     */
+    void reserve_growth_hint()
+    {
+#ifdef LAB5_GROWTH_STATS
+        reserve(growth_->get_reserve_hint());
+#endif
+    }
+
 private:
     allocator_type allocator_;
     pointer data_;
     size_type size_;
     size_type capacity_;
+#ifdef LAB5_GROWTH_STATS
+    GrowthCounters *growth_{&growth_stats_detail::type_counters<T>()};
+#endif
 };
 
 #endif // DYNAMIC_ARRAY_H
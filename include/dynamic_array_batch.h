@@ -0,0 +1,38 @@
+#ifndef DYNAMIC_ARRAY_BATCH_H
+#define DYNAMIC_ARRAY_BATCH_H
+
+#include <vector>
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+
+/**
+ * Создаёт count пустых массивов с ёмкостью capacity каждый.
+ * Буферы берутся одним вызовом allocate_batch вместо count отдельных
+ * do_allocate, поэтому память для всех массивов ищется за один проход.
+ */
+template <typename T>
+std::vector<DynamicArray<T>> make_dynamic_arrays(CustomMemoryResource &mr, size_t count, size_t capacity)
+{
+    std::vector<DynamicArray<T>> arrays;
+    arrays.reserve(count);
+
+    if (capacity == 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            arrays.emplace_back(&mr);
+        }
+        return arrays;
+    }
+
+    std::vector<void *> buffers(count);
+    mr.allocate_batch(count, capacity * sizeof(T), alignof(T), buffers.data());
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        arrays.emplace_back(adopt_buffer, static_cast<T *>(buffers[i]), capacity, &mr);
+    }
+    return arrays;
+}
+
+#endif // DYNAMIC_ARRAY_BATCH_H
@@ -0,0 +1,619 @@
+#ifndef DYNAMIC_ARRAY_IO_H
+#define DYNAMIC_ARRAY_IO_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "dynamic_array.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define LAB5_HAS_POSIX_IO 1
+#else
+#define LAB5_HAS_POSIX_IO 0
+#endif
+
+/*
+ * Бинарный формат файла с содержимым DynamicArray<T> (версия 1):
+ *
+ *   [ArrayFileHeader][заполнение до payload_offset][payload]
+ *
+ * Для тривиально копируемых T payload - это сами элементы подряд, и
+ * payload_offset выровнен так, чтобы файл можно было отобразить в память и
+ * читать элементы на месте (MappedArray). Для остальных типов payload
+ * формирует ElementCodec<T>, по одному элементу за раз.
+ */
+
+// Тег типа элемента. Для своих типов можно специализировать этот шаблон
+template <typename T>
+struct ElementTypeTag
+{
+    static constexpr uint32_t value = 0; // 0 = "неизвестный тип", проверяется только размер
+};
+
+#define LAB5_ELEMENT_TYPE_TAG(type, tag)            \
+    template <>                                     \
+    struct ElementTypeTag<type>                     \
+    {                                               \
+        static constexpr uint32_t value = tag;      \
+    };
+
+LAB5_ELEMENT_TYPE_TAG(char, 1)
+LAB5_ELEMENT_TYPE_TAG(signed char, 2)
+LAB5_ELEMENT_TYPE_TAG(unsigned char, 3)
+LAB5_ELEMENT_TYPE_TAG(short, 4)
+LAB5_ELEMENT_TYPE_TAG(unsigned short, 5)
+LAB5_ELEMENT_TYPE_TAG(int, 6)
+LAB5_ELEMENT_TYPE_TAG(unsigned int, 7)
+LAB5_ELEMENT_TYPE_TAG(long, 8)
+LAB5_ELEMENT_TYPE_TAG(unsigned long, 9)
+LAB5_ELEMENT_TYPE_TAG(long long, 10)
+LAB5_ELEMENT_TYPE_TAG(unsigned long long, 11)
+LAB5_ELEMENT_TYPE_TAG(float, 12)
+LAB5_ELEMENT_TYPE_TAG(double, 13)
+LAB5_ELEMENT_TYPE_TAG(bool, 14)
+
+#undef LAB5_ELEMENT_TYPE_TAG
+
+struct ArrayFileHeader
+{
+    static constexpr char kMagic[8] = {'L', 'A', 'B', '5', 'A', 'R', 'R', '\0'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    // Флаги
+    static constexpr uint32_t kCodecPayload = 1; // payload записан через ElementCodec
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;     // kByteOrderMark в порядке байт записавшей машины
+    uint32_t type_tag;       // ElementTypeTag<T>::value или ElementCodec<T>::type_tag
+    uint32_t flags;
+    uint64_t element_size;   // sizeof(T) (0 для payload через кодек)
+    uint64_t alignment;      // alignof(T)
+    uint64_t count;          // Число элементов
+    uint64_t payload_offset; // Смещение payload от начала файла
+    uint64_t payload_bytes;  // Размер payload
+    uint64_t checksum;       // array_checksum(payload)
+};
+
+/**
+ * Контрольная сумма payload: 64-битный хеш, обрабатывающий по 8 байт за шаг.
+ * Не криптографический, нужен только для обнаружения повреждённых файлов.
+ * Считается и по частям: все части, кроме последней, должны быть кратны 8 байтам.
+ */
+class ArrayChecksum
+{
+public:
+    explicit ArrayChecksum(size_t total_bytes) : hash_(0x9E3779B97F4A7C15ull ^ total_bytes) {}
+
+    void update(const void *data, size_t bytes)
+    {
+        const unsigned char *cur = static_cast<const unsigned char *>(data);
+        for (; bytes >= 8; bytes -= 8, cur += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, cur, 8);
+            hash_ = (hash_ ^ word) * 0xFF51AFD7ED558CCDull;
+            hash_ ^= hash_ >> 32;
+        }
+        for (; bytes > 0; --bytes, ++cur)
+        {
+            hash_ = (hash_ ^ *cur) * 0x100000001B3ull;
+        }
+    }
+
+    uint64_t finish() const
+    {
+        uint64_t hash = hash_;
+        hash ^= hash >> 33;
+        hash *= 0xC4CEB9FE1A85EC53ull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+private:
+    uint64_t hash_;
+};
+
+inline uint64_t array_checksum(const void *data, size_t bytes)
+{
+    ArrayChecksum checksum(bytes);
+    checksum.update(data, bytes);
+    return checksum.finish();
+}
+
+// Буфер, в который ElementCodec<T>::encode дописывает байты элемента
+class ByteWriter
+{
+public:
+    explicit ByteWriter(DynamicArray<char> &out) : out_(out) {}
+
+    void write_bytes(const void *data, size_t bytes)
+    {
+        out_.append_with(bytes, [data](char *tail, size_t count)
+                         { std::memcpy(tail, data, count); });
+    }
+
+    template <typename U>
+    void write(const U &value)
+    {
+        static_assert(std::is_trivially_copyable<U>::value, "ByteWriter::write: нужен тривиально копируемый тип");
+        write_bytes(&value, sizeof(U));
+    }
+
+    void write_string(const std::string &value)
+    {
+        write<uint64_t>(value.size());
+        write_bytes(value.data(), value.size());
+    }
+
+private:
+    DynamicArray<char> &out_;
+};
+
+// Чтение байт элемента в ElementCodec<T>::decode с проверкой границ
+class ByteReader
+{
+public:
+    ByteReader(const char *begin, const char *end) : cur_(begin), end_(end) {}
+
+    void read_bytes(void *data, size_t bytes)
+    {
+        if (static_cast<size_t>(end_ - cur_) < bytes)
+        {
+            throw std::runtime_error("ByteReader: неожиданный конец данных");
+        }
+        std::memcpy(data, cur_, bytes);
+        cur_ += bytes;
+    }
+
+    template <typename U>
+    U read()
+    {
+        static_assert(std::is_trivially_copyable<U>::value, "ByteReader::read: нужен тривиально копируемый тип");
+        U value;
+        read_bytes(&value, sizeof(U));
+        return value;
+    }
+
+    std::string read_string()
+    {
+        uint64_t size = read<uint64_t>();
+        if (static_cast<uint64_t>(end_ - cur_) < size)
+        {
+            throw std::runtime_error("ByteReader: неожиданный конец данных");
+        }
+        std::string value(cur_, static_cast<size_t>(size));
+        cur_ += size;
+        return value;
+    }
+
+    bool at_end() const { return cur_ == end_; }
+
+private:
+    const char *cur_;
+    const char *end_;
+};
+
+/**
+ * Кодек для нетривиальных типов. Специализация должна содержать:
+ *   static constexpr uint32_t type_tag;
+ *   static void encode(const T &value, ByteWriter &out);
+ *   static T decode(ByteReader &in);
+ */
+template <typename T>
+struct ElementCodec;
+
+namespace dynamic_array_io_detail
+{
+    template <typename T, typename = void>
+    struct has_codec : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct has_codec<T, decltype(void(ElementCodec<T>::type_tag))> : std::true_type
+    {
+    };
+
+    template <typename T>
+    constexpr bool use_raw_payload()
+    {
+        return std::is_trivially_copyable<T>::value && !has_codec<T>::value;
+    }
+
+    inline uint64_t round_up(uint64_t value, uint64_t granularity)
+    {
+        return (value + granularity - 1) / granularity * granularity;
+    }
+
+    template <typename T>
+    ArrayFileHeader make_header(uint64_t count, uint64_t payload_bytes, uint64_t checksum)
+    {
+        ArrayFileHeader header{};
+        std::memcpy(header.magic, ArrayFileHeader::kMagic, sizeof(header.magic));
+        header.version = ArrayFileHeader::kVersion;
+        header.byte_order = ArrayFileHeader::kByteOrderMark;
+        header.alignment = alignof(T);
+        header.count = count;
+        header.payload_bytes = payload_bytes;
+        header.checksum = checksum;
+
+        if constexpr (use_raw_payload<T>())
+        {
+            header.type_tag = ElementTypeTag<T>::value;
+            header.element_size = sizeof(T);
+            // Выравнивание payload не меньше 64 байт: подходит и для T, и для SIMD-чтения
+            header.payload_offset = round_up(sizeof(ArrayFileHeader), alignof(T) > 64 ? alignof(T) : 64);
+        }
+        else
+        {
+            header.type_tag = ElementCodec<T>::type_tag;
+            header.flags = ArrayFileHeader::kCodecPayload;
+            header.payload_offset = sizeof(ArrayFileHeader);
+        }
+        return header;
+    }
+
+    // Проверяет, что файл записан для того же T, и возвращает понятную ошибку иначе
+    template <typename T>
+    void validate_header(const ArrayFileHeader &header, uint64_t file_size)
+    {
+        if (std::memcmp(header.magic, ArrayFileHeader::kMagic, sizeof(header.magic)) != 0)
+        {
+            throw std::runtime_error("load_array: файл не является сохранённым DynamicArray");
+        }
+        if (header.version != ArrayFileHeader::kVersion)
+        {
+            throw std::runtime_error("load_array: неподдерживаемая версия формата");
+        }
+        if (header.byte_order != ArrayFileHeader::kByteOrderMark)
+        {
+            throw std::runtime_error("load_array: файл записан с другим порядком байт");
+        }
+
+        ArrayFileHeader expected = make_header<T>(header.count, header.payload_bytes, 0);
+        if (header.type_tag != expected.type_tag || header.flags != expected.flags ||
+            header.element_size != expected.element_size || header.alignment != expected.alignment)
+        {
+            throw std::runtime_error("load_array: тип элементов в файле не совпадает с T");
+        }
+        // Произведение и сумма считаются без переполнения: заголовок может быть подделан
+        if (expected.element_size != 0 &&
+            (header.count > UINT64_MAX / expected.element_size ||
+             header.payload_bytes != header.count * expected.element_size))
+        {
+            throw std::runtime_error("load_array: размер payload не соответствует числу элементов");
+        }
+        // save_array пишет payload по одному смещению, от него же зависит выравнивание
+        if (header.payload_offset != expected.payload_offset)
+        {
+            throw std::runtime_error("load_array: неверное смещение payload");
+        }
+        if (header.payload_offset > file_size || header.payload_bytes > file_size - header.payload_offset)
+        {
+            throw std::runtime_error("load_array: файл обрезан");
+        }
+    }
+
+    // Пишет несколько буферов одним системным вызовом (writev) с дозаписью остатка
+    struct Chunk
+    {
+        const void *data;
+        size_t size;
+    };
+
+    inline void write_all(const std::string &path, const Chunk *chunks, int count)
+    {
+#if LAB5_HAS_POSIX_IO
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("save_array: не удалось открыть " + path);
+        }
+
+        iovec iov[4];
+        int iov_count = 0;
+        for (int i = 0; i < count && iov_count < 4; ++i)
+        {
+            if (chunks[i].size != 0)
+            {
+                iov[iov_count].iov_base = const_cast<void *>(chunks[i].data);
+                iov[iov_count].iov_len = chunks[i].size;
+                ++iov_count;
+            }
+        }
+
+        int first = 0;
+        while (first < iov_count)
+        {
+            ssize_t written = ::writev(fd, iov + first, iov_count - first);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ::close(fd);
+                throw std::runtime_error("save_array: ошибка записи в " + path);
+            }
+            // Частичная запись: пропускаем записанные буферы и сдвигаем текущий
+            size_t left = static_cast<size_t>(written);
+            while (first < iov_count && left >= iov[first].iov_len)
+            {
+                left -= iov[first].iov_len;
+                ++first;
+            }
+            if (first < iov_count)
+            {
+                iov[first].iov_base = static_cast<char *>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+
+        if (::close(fd) != 0)
+        {
+            throw std::runtime_error("save_array: ошибка записи в " + path);
+        }
+#else
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        for (int i = 0; i < count && file; ++i)
+        {
+            file.write(static_cast<const char *>(chunks[i].data), static_cast<std::streamsize>(chunks[i].size));
+        }
+        if (!file)
+        {
+            throw std::runtime_error("save_array: ошибка записи в " + path);
+        }
+#endif
+    }
+}
+
+/**
+ * Сохраняет содержимое массива в файл.
+ * Тривиально копируемые элементы пишутся одним writev вместе с заголовком,
+ * для остальных типов нужна специализация ElementCodec<T>.
+ */
+template <typename T>
+void save_array(const std::string &path, const DynamicArray<T> &array)
+{
+    using namespace dynamic_array_io_detail;
+    static const char padding[256] = {};
+
+    if constexpr (use_raw_payload<T>())
+    {
+        const uint64_t payload_bytes = array.size() * sizeof(T);
+        ArrayFileHeader header = make_header<T>(array.size(), payload_bytes,
+                                                array_checksum(array.data(), payload_bytes));
+
+        Chunk chunks[3] = {{&header, sizeof(header)},
+                           {padding, static_cast<size_t>(header.payload_offset - sizeof(header))},
+                           {array.data(), static_cast<size_t>(payload_bytes)}};
+        write_all(path, chunks, 3);
+    }
+    else
+    {
+        static_assert(has_codec<T>::value,
+                      "save_array: для нетривиального T нужна специализация ElementCodec<T>");
+
+        // Кодируем все элементы в один буфер из того же memory_resource
+        DynamicArray<char> payload(array.get_allocator().resource());
+        payload.set_growth_tag("save_array.payload");
+        ByteWriter writer(payload);
+        for (const T &value : array)
+        {
+            ElementCodec<T>::encode(value, writer);
+        }
+
+        ArrayFileHeader header = make_header<T>(array.size(), payload.size(),
+                                                array_checksum(payload.data(), payload.size()));
+
+        Chunk chunks[2] = {{&header, sizeof(header)}, {payload.data(), payload.size()}};
+        write_all(path, chunks, 2);
+    }
+}
+
+/**
+ * Загружает массив из файла, заменяя содержимое out.
+ * Элементы тривиальных типов копируются одним блоком, без поэлементного push_back.
+ */
+template <typename T>
+void load_array(const std::string &path, DynamicArray<T> &out)
+{
+    using namespace dynamic_array_io_detail;
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        throw std::runtime_error("load_array: не удалось открыть " + path);
+    }
+    const uint64_t file_size = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    ArrayFileHeader header{};
+    if (file_size < sizeof(header) || !file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        throw std::runtime_error("load_array: файл обрезан");
+    }
+    validate_header<T>(header, file_size);
+
+    out.clear();
+    file.seekg(static_cast<std::streamoff>(header.payload_offset));
+
+    if constexpr (use_raw_payload<T>())
+    {
+        // Читаем payload прямо в буфер массива
+        out.resize_default_init(static_cast<size_t>(header.count));
+        if (!file.read(reinterpret_cast<char *>(out.data()), static_cast<std::streamsize>(header.payload_bytes)))
+        {
+            out.clear();
+            throw std::runtime_error("load_array: файл обрезан");
+        }
+        if (array_checksum(out.data(), static_cast<size_t>(header.payload_bytes)) != header.checksum)
+        {
+            out.clear();
+            throw std::runtime_error("load_array: контрольная сумма не совпадает");
+        }
+    }
+    else
+    {
+        DynamicArray<char> payload(out.get_allocator().resource());
+        payload.resize_uninitialized(static_cast<size_t>(header.payload_bytes));
+        if (!file.read(payload.data(), static_cast<std::streamsize>(header.payload_bytes)))
+        {
+            throw std::runtime_error("load_array: файл обрезан");
+        }
+        if (array_checksum(payload.data(), payload.size()) != header.checksum)
+        {
+            throw std::runtime_error("load_array: контрольная сумма не совпадает");
+        }
+
+        // count не проверен кодеком: резерв не больше числа байт payload
+        out.reserve(static_cast<size_t>(std::min<uint64_t>(header.count, header.payload_bytes)));
+        ByteReader reader(payload.data(), payload.data() + payload.size());
+        for (uint64_t i = 0; i < header.count; ++i)
+        {
+            out.push_back(ElementCodec<T>::decode(reader));
+        }
+        if (!reader.at_end())
+        {
+            throw std::runtime_error("load_array: лишние байты в payload");
+        }
+    }
+}
+
+/**
+ * Отображённый в память файл, сохранённый через save_array.
+ * Даёт доступ к элементам только для чтения без копирования и без
+ * конструирования объектов. Только для тривиально копируемых T.
+ */
+template <typename T>
+class MappedArray
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MappedArray: отображение без копирования возможно только для тривиально копируемых T");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using const_reference = const T &;
+    using const_pointer = const T *;
+    using const_iterator = typename DynamicArray<T>::ConstIterator;
+
+    /**
+     * Отображает файл. Если verify_checksum == true, payload целиком читается
+     * один раз для проверки контрольной суммы (это затронет все страницы).
+     */
+    explicit MappedArray(const std::string &path, bool verify_checksum = true)
+    {
+#if LAB5_HAS_POSIX_IO
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("MappedArray: не удалось открыть " + path);
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ArrayFileHeader))
+        {
+            ::close(fd);
+            throw std::runtime_error("MappedArray: файл обрезан");
+        }
+
+        mapped_size_ = static_cast<size_t>(st.st_size);
+        void *mapped = ::mmap(nullptr, mapped_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+        {
+            throw std::runtime_error("MappedArray: mmap завершился ошибкой");
+        }
+        mapped_ = mapped;
+
+        try
+        {
+            const ArrayFileHeader &header = *static_cast<const ArrayFileHeader *>(mapped_);
+            dynamic_array_io_detail::validate_header<T>(header, mapped_size_);
+
+            // mmap выравнивает начало по странице, а validate_header - смещение payload
+            if (header.payload_offset % alignof(T) != 0)
+            {
+                throw std::runtime_error("MappedArray: payload не выровнен под T");
+            }
+            data_ = reinterpret_cast<const T *>(static_cast<const char *>(mapped_) + header.payload_offset);
+            size_ = static_cast<size_t>(header.count);
+
+            if (verify_checksum && array_checksum(data_, static_cast<size_t>(header.payload_bytes)) != header.checksum)
+            {
+                throw std::runtime_error("MappedArray: контрольная сумма не совпадает");
+            }
+        }
+        catch (...)
+        {
+            ::munmap(mapped_, mapped_size_);
+            throw;
+        }
+#else
+        (void)path;
+        (void)verify_checksum;
+        throw std::runtime_error("MappedArray: отображение файлов не поддерживается на этой платформе");
+#endif
+    }
+
+    ~MappedArray()
+    {
+#if LAB5_HAS_POSIX_IO
+        if (mapped_)
+        {
+            ::munmap(mapped_, mapped_size_);
+        }
+#endif
+    }
+
+    MappedArray(const MappedArray &) = delete;
+    MappedArray &operator=(const MappedArray &) = delete;
+
+    MappedArray(MappedArray &&other) noexcept
+        : mapped_(other.mapped_), mapped_size_(other.mapped_size_), data_(other.data_), size_(other.size_)
+    {
+        other.mapped_ = nullptr;
+        other.mapped_size_ = 0;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    const_iterator begin() const { return const_iterator(data_); }
+    const_iterator end() const { return const_iterator(data_ + size_); }
+
+    const_reference operator[](size_type index) const { return data_[index]; }
+
+    const_reference at(size_type index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("MappedArray::at: индекс вне диапазона");
+        }
+        return data_[index];
+    }
+
+    const_pointer data() const { return data_; }
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    void *mapped_{nullptr};
+    size_t mapped_size_{0};
+    const T *data_{nullptr};
+    size_t size_{0};
+};
+
+#endif // DYNAMIC_ARRAY_IO_H
@@ -0,0 +1,322 @@
+#ifndef DYNAMIC_ARRAY_VIEW_H
+#define DYNAMIC_ARRAY_VIEW_H
+
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include "dynamic_array.h"
+
+template <typename T>
+class StridedView;
+
+template <typename T>
+class ChunkedView;
+
+/**
+ * Невладеющее представление непрерывного диапазона элементов (аналог std::span).
+ *
+ * Хранит только указатель и длину, поэтому копируется бесплатно и позволяет
+ * передавать части DynamicArray в функции и потоки без выделения памяти.
+ * DynamicArrayView<const T> даёт доступ только на чтение.
+ * Представление становится недействительным при реаллокации исходного массива.
+ */
+template <typename T>
+class DynamicArrayView
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    // Итераторы те же, что у DynamicArray: для const T - ConstIterator
+    using iterator = std::conditional_t<std::is_const<T>::value,
+                                        typename DynamicArray<value_type>::ConstIterator,
+                                        typename DynamicArray<value_type>::Iterator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Конструкторы
+    constexpr DynamicArrayView() : data_(nullptr), size_(0) {}
+    constexpr DynamicArrayView(pointer data, size_type size) : data_(data), size_(size) {}
+
+    DynamicArrayView(iterator first, iterator last)
+        : data_(first.operator->()), size_(static_cast<size_type>(last - first)) {}
+
+    DynamicArrayView(DynamicArray<value_type> &array) : data_(array.data()), size_(array.size()) {}
+
+    template <typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    DynamicArrayView(const DynamicArray<value_type> &array) : data_(array.data()), size_(array.size()) {}
+
+    // DynamicArrayView<T> неявно превращается в DynamicArrayView<const T>
+    template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+    constexpr DynamicArrayView(const DynamicArrayView<U> &other) : data_(other.data()), size_(other.size()) {}
+
+    // Итераторы
+    iterator begin() const { return iterator(data_); }
+    iterator end() const { return iterator(data_ + size_); }
+
+    // Доступ к элементам
+    constexpr reference operator[](size_type index) const { return data_[index]; }
+
+    reference at(size_type index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("DynamicArrayView::at: индекс вне диапазона");
+        }
+        return data_[index];
+    }
+
+    constexpr reference front() const { return data_[0]; }
+    constexpr reference back() const { return data_[size_ - 1]; }
+    constexpr pointer data() const { return data_; }
+
+    // Размер
+    constexpr size_type size() const { return size_; }
+    constexpr size_type size_bytes() const { return size_ * sizeof(T); }
+    constexpr bool empty() const { return size_ == 0; }
+
+    // Поддиапазоны
+    DynamicArrayView subspan(size_type offset, size_type count = npos) const
+    {
+        if (offset > size_)
+        {
+            throw std::out_of_range("DynamicArrayView::subspan: смещение вне диапазона");
+        }
+        size_type available = size_ - offset;
+        return DynamicArrayView(data_ + offset, count == npos || count > available ? available : count);
+    }
+
+    DynamicArrayView first(size_type count) const { return subspan(0, count); }
+
+    DynamicArrayView last(size_type count) const
+    {
+        return count >= size_ ? *this : subspan(size_ - count);
+    }
+
+    // Каждый step-й элемент начиная с offset
+    StridedView<T> strided(size_type step, size_type offset = 0) const
+    {
+        if (step == 0)
+        {
+            throw std::invalid_argument("DynamicArrayView::strided: шаг должен быть больше нуля");
+        }
+        if (offset >= size_)
+        {
+            return StridedView<T>(data_, 0, step);
+        }
+        return StridedView<T>(data_ + offset, (size_ - offset + step - 1) / step, step);
+    }
+
+    // Разбиение на куски по chunk_size элементов (последний может быть короче)
+    ChunkedView<T> chunks(size_type chunk_size) const
+    {
+        if (chunk_size == 0)
+        {
+            throw std::invalid_argument("DynamicArrayView::chunks: размер куска должен быть больше нуля");
+        }
+        return ChunkedView<T>(*this, chunk_size);
+    }
+
+private:
+    pointer data_;
+    size_type size_;
+};
+
+// Выводим тип представления из массива: const DynamicArray<T> даёт DynamicArrayView<const T>
+template <typename T>
+DynamicArrayView(DynamicArray<T> &) -> DynamicArrayView<T>;
+
+template <typename T>
+DynamicArrayView(const DynamicArray<T> &) -> DynamicArrayView<const T>;
+
+/**
+ * Представление элементов с постоянным шагом: data[0], data[step], data[2*step], ...
+ */
+template <typename T>
+class StridedView
+{
+public:
+    using value_type = std::remove_cv_t<T>;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using pointer = T *;
+    using reference = T &;
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        Iterator() : base_(nullptr), index_(0), step_(1) {}
+        Iterator(pointer base, difference_type index, difference_type step)
+            : base_(base), index_(index), step_(step) {}
+
+        // Храним номер элемента, а не указатель, чтобы end() не выходил за пределы массива
+        reference operator*() const { return base_[index_ * step_]; }
+        pointer operator->() const { return base_ + index_ * step_; }
+        reference operator[](difference_type n) const { return base_[(index_ + n) * step_]; }
+
+        Iterator &operator++()
+        {
+            ++index_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator temp = *this;
+            ++index_;
+            return temp;
+        }
+
+        Iterator &operator--()
+        {
+            --index_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator temp = *this;
+            --index_;
+            return temp;
+        }
+
+        Iterator &operator+=(difference_type n)
+        {
+            index_ += n;
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type n)
+        {
+            index_ -= n;
+            return *this;
+        }
+
+        Iterator operator+(difference_type n) const { return Iterator(base_, index_ + n, step_); }
+        Iterator operator-(difference_type n) const { return Iterator(base_, index_ - n, step_); }
+        difference_type operator-(const Iterator &other) const { return index_ - other.index_; }
+
+        bool operator==(const Iterator &other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator &other) const { return index_ != other.index_; }
+        bool operator<(const Iterator &other) const { return index_ < other.index_; }
+        bool operator>(const Iterator &other) const { return index_ > other.index_; }
+        bool operator<=(const Iterator &other) const { return index_ <= other.index_; }
+        bool operator>=(const Iterator &other) const { return index_ >= other.index_; }
+
+    private:
+        pointer base_;
+        difference_type index_;
+        difference_type step_;
+    };
+
+    using iterator = Iterator;
+
+    StridedView(pointer data, size_type size, size_type step) : data_(data), size_(size), step_(step) {}
+
+    iterator begin() const { return iterator(data_, 0, static_cast<difference_type>(step_)); }
+    iterator end() const { return iterator(data_, static_cast<difference_type>(size_), static_cast<difference_type>(step_)); }
+
+    reference operator[](size_type index) const { return data_[index * step_]; }
+
+    reference at(size_type index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("StridedView::at: индекс вне диапазона");
+        }
+        return data_[index * step_];
+    }
+
+    size_type size() const { return size_; }
+    size_type step() const { return step_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    pointer data_;
+    size_type size_;
+    size_type step_;
+};
+
+/**
+ * Последовательность соседних кусков DynamicArrayView фиксированного размера.
+ * Удобно раздавать куски рабочим потокам: chunks(n)[i] - i-й кусок.
+ */
+template <typename T>
+class ChunkedView
+{
+public:
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = DynamicArrayView<T>;
+        using difference_type = ptrdiff_t;
+        using pointer = void;
+        using reference = DynamicArrayView<T>;
+
+        Iterator() : view_(), chunk_size_(1), offset_(0) {}
+        Iterator(DynamicArrayView<T> view, size_type chunk_size, size_type offset)
+            : view_(view), chunk_size_(chunk_size), offset_(offset) {}
+
+        reference operator*() const { return view_.subspan(offset_, chunk_size_); }
+
+        Iterator &operator++()
+        {
+            offset_ += chunk_size_;
+            if (offset_ > view_.size())
+            {
+                offset_ = view_.size();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const Iterator &other) const { return offset_ == other.offset_; }
+        bool operator!=(const Iterator &other) const { return offset_ != other.offset_; }
+
+    private:
+        DynamicArrayView<T> view_;
+        size_type chunk_size_;
+        size_type offset_;
+    };
+
+    using iterator = Iterator;
+
+    ChunkedView(DynamicArrayView<T> view, size_type chunk_size) : view_(view), chunk_size_(chunk_size) {}
+
+    iterator begin() const { return iterator(view_, chunk_size_, 0); }
+    iterator end() const { return iterator(view_, chunk_size_, view_.size()); }
+
+    DynamicArrayView<T> operator[](size_type index) const
+    {
+        return view_.subspan(index * chunk_size_, chunk_size_);
+    }
+
+    size_type size() const { return (view_.size() + chunk_size_ - 1) / chunk_size_; }
+    bool empty() const { return view_.empty(); }
+
+private:
+    DynamicArrayView<T> view_;
+    size_type chunk_size_;
+};
+
+#endif // DYNAMIC_ARRAY_VIEW_H
@@ -0,0 +1,639 @@
+#ifndef DYNAMIC_BIT_ARRAY_H
+#define DYNAMIC_BIT_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include "dynamic_array.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LAB5_BIT_ARRAY_X86 1
+#endif
+
+// Варианты подсчёта единичных битов; выбирается лучший из поддерживаемых процессором
+enum class PopcountPath
+{
+    Portable, // popcount без расширений набора команд
+    Popcnt,   // Инструкция POPCNT по слову
+    Avx2,     // Таблица полубайтов через vpshufb (алгоритм Мулы), 4 слова за шаг
+    Avx512    // VPOPCNTDQ, 8 слов за шаг
+};
+
+namespace bit_array_detail
+{
+    constexpr size_t kWordBits = 64;
+
+    inline size_t words_for(size_t bits) { return (bits + kWordBits - 1) / kWordBits; }
+
+    // Маска младших bits битов слова (bits = 0 - всё слово)
+    inline uint64_t tail_mask(size_t bits)
+    {
+        return bits % kWordBits == 0 ? ~uint64_t(0) : (uint64_t(1) << (bits % kWordBits)) - 1;
+    }
+
+    // Число единиц в слове
+    inline size_t popcount_word(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t total = 0;
+        for (; word != 0; word &= word - 1)
+        {
+            ++total;
+        }
+        return total;
+#endif
+    }
+
+    // Номер младшего единичного бита (word != 0)
+    inline size_t lowest_bit(uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t bit = 0;
+        for (; (word & 1) == 0; word >>= 1)
+        {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    inline size_t popcount_portable(const uint64_t *words, size_t count)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            total += popcount_word(words[i]);
+        }
+        return total;
+    }
+
+#ifdef LAB5_BIT_ARRAY_X86
+    __attribute__((target("popcnt"))) inline size_t popcount_popcnt(const uint64_t *words, size_t count)
+    {
+        // Четыре независимых суммы, чтобы не упираться в задержку сложения
+        size_t a = 0, b = 0, c = 0, d = 0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            a += static_cast<size_t>(__builtin_popcountll(words[i]));
+            b += static_cast<size_t>(__builtin_popcountll(words[i + 1]));
+            c += static_cast<size_t>(__builtin_popcountll(words[i + 2]));
+            d += static_cast<size_t>(__builtin_popcountll(words[i + 3]));
+        }
+        for (; i < count; ++i)
+        {
+            a += static_cast<size_t>(__builtin_popcountll(words[i]));
+        }
+        return a + b + c + d;
+    }
+
+    __attribute__((target("avx2,popcnt"))) inline size_t popcount_avx2(const uint64_t *words, size_t count)
+    {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0f);
+        __m256i acc = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i));
+            const __m256i lo = _mm256_and_si256(v, low_mask);
+            const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+            const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+            // Байтовые суммы не переполняются: в байте не больше 8 единиц
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+        }
+        size_t total = static_cast<size_t>(_mm256_extract_epi64(acc, 0)) + static_cast<size_t>(_mm256_extract_epi64(acc, 1)) +
+                       static_cast<size_t>(_mm256_extract_epi64(acc, 2)) + static_cast<size_t>(_mm256_extract_epi64(acc, 3));
+        for (; i < count; ++i)
+        {
+            total += static_cast<size_t>(__builtin_popcountll(words[i]));
+        }
+        return total;
+    }
+
+    __attribute__((target("avx512f,avx512vpopcntdq"))) inline size_t popcount_avx512(const uint64_t *words, size_t count)
+    {
+        __m512i acc = _mm512_setzero_si512();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+        }
+        if (i < count)
+        {
+            const __mmask8 mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+            acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, words + i)));
+        }
+        uint64_t lanes[8];
+        _mm512_storeu_si512(lanes, acc);
+        return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7]);
+    }
+#endif
+
+    inline bool popcount_supported(PopcountPath path)
+    {
+#ifdef LAB5_BIT_ARRAY_X86
+        switch (path)
+        {
+        case PopcountPath::Portable:
+            return true;
+        case PopcountPath::Popcnt:
+            return __builtin_cpu_supports("popcnt");
+        case PopcountPath::Avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+        case PopcountPath::Avx512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+        }
+        return false;
+#else
+        return path == PopcountPath::Portable;
+#endif
+    }
+
+    // Подсчёт выбранным способом; путь должен поддерживаться процессором
+    inline size_t popcount_words(PopcountPath path, const uint64_t *words, size_t count)
+    {
+        switch (path)
+        {
+#ifdef LAB5_BIT_ARRAY_X86
+        case PopcountPath::Popcnt:
+            return popcount_popcnt(words, count);
+        case PopcountPath::Avx2:
+            return popcount_avx2(words, count);
+        case PopcountPath::Avx512:
+            return popcount_avx512(words, count);
+#endif
+        default:
+            return popcount_portable(words, count);
+        }
+    }
+
+    // Лучший путь для текущего процессора, определяется один раз
+    inline PopcountPath best_popcount_path()
+    {
+        static const PopcountPath path = []
+        {
+            for (PopcountPath candidate : {PopcountPath::Avx512, PopcountPath::Avx2, PopcountPath::Popcnt})
+            {
+                if (popcount_supported(candidate))
+                {
+                    return candidate;
+                }
+            }
+            return PopcountPath::Portable;
+        }();
+        return path;
+    }
+}
+
+/**
+ * Динамический массив битов: по биту на элемент вместо байта у DynamicArray<bool>.
+ *
+ * Биты хранятся в 64-битных словах DynamicArray<uint64_t>, поэтому память
+ * берётся из того же memory_resource и растёт так же геометрически. Биты
+ * за size() в последнем слове всегда нулевые, так что count, find_first,
+ * any/all и побитовые операции работают сразу по словам без масок.
+ *
+ * count() использует лучший доступный способ подсчёта: AVX-512 VPOPCNTDQ,
+ * AVX2 или POPCNT (выбор при первом вызове по __builtin_cpu_supports),
+ * иначе переносимый. Циклы &=, |=, ^= простые и векторизуются компилятором.
+ *
+ * Неконстантный operator[] возвращает прокси-ссылку на бит.
+ */
+class DynamicBitArray
+{
+public:
+    using size_type = size_t;
+    using word_type = uint64_t;
+    using allocator_type = std::pmr::polymorphic_allocator<word_type>;
+
+    static constexpr size_type kWordBits = bit_array_detail::kWordBits;
+
+    // Прокси-ссылка на один бит
+    class reference
+    {
+    public:
+        reference(word_type *word, word_type mask) : word_(word), mask_(mask) {}
+        reference(const reference &other) = default;
+
+        reference &operator=(bool value)
+        {
+            if (value)
+            {
+                *word_ |= mask_;
+            }
+            else
+            {
+                *word_ &= ~mask_;
+            }
+            return *this;
+        }
+
+        reference &operator=(const reference &other) { return *this = static_cast<bool>(other); }
+
+        operator bool() const { return (*word_ & mask_) != 0; }
+        bool operator~() const { return (*word_ & mask_) == 0; }
+
+        void flip() { *word_ ^= mask_; }
+
+    private:
+        word_type *word_;
+        word_type mask_;
+    };
+
+    // Итератор чтения значений битов
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = bool;
+
+        ConstIterator(const word_type *words, size_type index) : words_(words), index_(index) {}
+
+        bool operator*() const { return (words_[index_ / kWordBits] >> (index_ % kWordBits)) & 1; }
+
+        ConstIterator &operator++()
+        {
+            ++index_;
+            return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+            ConstIterator tmp = *this;
+            ++index_;
+            return tmp;
+        }
+
+        bool operator==(const ConstIterator &other) const { return index_ == other.index_; }
+        bool operator!=(const ConstIterator &other) const { return index_ != other.index_; }
+
+    private:
+        const word_type *words_;
+        size_type index_;
+    };
+
+    using const_iterator = ConstIterator;
+
+    explicit DynamicBitArray(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : words_(mr) {}
+
+    explicit DynamicBitArray(size_type count, bool value = false, std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : words_(mr)
+    {
+        resize(count, value);
+    }
+
+    // Упаковывает DynamicArray<bool> в биты; память берётся из его ресурса
+    explicit DynamicBitArray(const DynamicArray<bool> &source)
+        : words_(source.get_allocator().resource())
+    {
+        words_.resize(bit_array_detail::words_for(source.size()));
+        for (size_type i = 0; i < source.size(); ++i)
+        {
+            words_[i / kWordBits] |= word_type(source[i]) << (i % kWordBits);
+        }
+        size_ = source.size();
+    }
+
+    DynamicBitArray(const DynamicBitArray &other) = default;
+    DynamicBitArray &operator=(const DynamicBitArray &other) = default;
+
+    // Исходный массив остаётся пустым
+    DynamicBitArray(DynamicBitArray &&other) noexcept
+        : words_(std::move(other.words_)), size_(other.size_)
+    {
+        other.size_ = 0;
+    }
+
+    /**
+     * Ресурс массива не меняется, как у pmr-контейнеров: буфер other
+     * перенимается, только если ресурсы равны, иначе слова копируются.
+     * Исходный массив в обоих случаях остаётся пустым.
+     */
+    DynamicBitArray &operator=(DynamicBitArray &&other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        words_ = std::move(other.words_);
+        size_ = other.size_;
+        other.size_ = 0;
+        return *this;
+    }
+
+    bool operator[](size_type index) const { return test(index); }
+
+    reference operator[](size_type index)
+    {
+        return reference(&words_[index / kWordBits], word_type(1) << (index % kWordBits));
+    }
+
+    bool at(size_type index) const
+    {
+        check_index(index);
+        return test(index);
+    }
+
+    reference at(size_type index)
+    {
+        check_index(index);
+        return (*this)[index];
+    }
+
+    bool test(size_type index) const { return (words_[index / kWordBits] >> (index % kWordBits)) & 1; }
+
+    void set(size_type index, bool value = true) { (*this)[index] = value; }
+    void reset(size_type index) { words_[index / kWordBits] &= ~(word_type(1) << (index % kWordBits)); }
+    void flip(size_type index) { words_[index / kWordBits] ^= word_type(1) << (index % kWordBits); }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_type capacity() const { return words_.capacity() * kWordBits; }
+
+    // Слова с битами; биты за size() в последнем слове нулевые
+    const word_type *words() const { return words_.data(); }
+    size_type words_count() const { return words_.size(); }
+
+    const_iterator begin() const { return const_iterator(words_.data(), 0); }
+    const_iterator end() const { return const_iterator(words_.data(), size_); }
+
+    void push_back(bool value)
+    {
+        if (size_ % kWordBits == 0)
+        {
+            words_.push_back(0);
+        }
+        words_.back() |= word_type(value) << (size_ % kWordBits);
+        ++size_;
+    }
+
+    void pop_back()
+    {
+        if (size_ == 0)
+        {
+            return;
+        }
+        --size_;
+        if (size_ % kWordBits == 0)
+        {
+            words_.pop_back();
+        }
+        else
+        {
+            words_.back() &= bit_array_detail::tail_mask(size_);
+        }
+    }
+
+    void resize(size_type new_size, bool value = false)
+    {
+        const size_type new_words = bit_array_detail::words_for(new_size);
+        if (new_size > size_ && value)
+        {
+            // Добиваем единицами хвост текущего последнего слова
+            if (size_ % kWordBits != 0)
+            {
+                words_.back() |= ~bit_array_detail::tail_mask(size_);
+            }
+            words_.resize(new_words, ~word_type(0));
+        }
+        else
+        {
+            words_.resize(new_words);
+        }
+        size_ = new_size;
+        clear_tail();
+    }
+
+    void reserve(size_type bits) { words_.reserve(bit_array_detail::words_for(bits)); }
+
+    void clear()
+    {
+        words_.clear();
+        size_ = 0;
+    }
+
+    void set_all()
+    {
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            words_[i] = ~word_type(0);
+        }
+        clear_tail();
+    }
+
+    void reset_all()
+    {
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            words_[i] = 0;
+        }
+    }
+
+    void flip_all()
+    {
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            words_[i] = ~words_[i];
+        }
+        clear_tail();
+    }
+
+    // Число единичных битов
+    size_type count() const
+    {
+        return bit_array_detail::popcount_words(bit_array_detail::best_popcount_path(), words_.data(), words_.size());
+    }
+
+    bool any() const
+    {
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            if (words_[i] != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool none() const { return !any(); }
+
+    bool all() const
+    {
+        const size_type full = size_ / kWordBits;
+        for (size_type i = 0; i < full; ++i)
+        {
+            if (words_[i] != ~word_type(0))
+            {
+                return false;
+            }
+        }
+        return full == words_.size() || words_[full] == bit_array_detail::tail_mask(size_);
+    }
+
+    // Индекс первого единичного бита или size(), если таких нет
+    size_type find_first() const { return find_from_word(0); }
+
+    // Индекс следующего единичного бита после index или size()
+    size_type find_next(size_type index) const
+    {
+        ++index;
+        if (index >= size_)
+        {
+            return size_;
+        }
+        const size_type word = index / kWordBits;
+        const word_type rest = words_[word] >> (index % kWordBits);
+        if (rest != 0)
+        {
+            return index + static_cast<size_type>(bit_array_detail::lowest_bit(rest));
+        }
+        return find_from_word(word + 1);
+    }
+
+    // Вызывает fn(index) для каждого единичного бита по возрастанию
+    template <typename Fn>
+    void for_each_set(Fn fn) const
+    {
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            word_type word = words_[i];
+            while (word != 0)
+            {
+                fn(i * kWordBits + static_cast<size_type>(bit_array_detail::lowest_bit(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    DynamicBitArray &operator&=(const DynamicBitArray &other)
+    {
+        check_same_size(other);
+        word_type *dst = words_.data();
+        const word_type *src = other.words_.data();
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            dst[i] &= src[i];
+        }
+        return *this;
+    }
+
+    DynamicBitArray &operator|=(const DynamicBitArray &other)
+    {
+        check_same_size(other);
+        word_type *dst = words_.data();
+        const word_type *src = other.words_.data();
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            dst[i] |= src[i];
+        }
+        return *this;
+    }
+
+    DynamicBitArray &operator^=(const DynamicBitArray &other)
+    {
+        check_same_size(other);
+        word_type *dst = words_.data();
+        const word_type *src = other.words_.data();
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            dst[i] ^= src[i];
+        }
+        return *this;
+    }
+
+    bool operator==(const DynamicBitArray &other) const
+    {
+        if (size_ != other.size_)
+        {
+            return false;
+        }
+        for (size_type i = 0; i < words_.size(); ++i)
+        {
+            if (words_[i] != other.words_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const DynamicBitArray &other) const { return !(*this == other); }
+
+    allocator_type get_allocator() const { return words_.get_allocator(); }
+
+private:
+    void check_index(size_type index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("DynamicBitArray::at: индекс вне диапазона");
+        }
+    }
+
+    void check_same_size(const DynamicBitArray &other) const
+    {
+        if (size_ != other.size_)
+        {
+            throw std::invalid_argument("DynamicBitArray: размеры операндов различаются");
+        }
+    }
+
+    // Обнуляет биты за size() в последнем слове
+    void clear_tail()
+    {
+        if (size_ % kWordBits != 0)
+        {
+            words_.back() &= bit_array_detail::tail_mask(size_);
+        }
+    }
+
+    size_type find_from_word(size_type word) const
+    {
+        for (; word < words_.size(); ++word)
+        {
+            if (words_[word] != 0)
+            {
+                return word * kWordBits + static_cast<size_type>(bit_array_detail::lowest_bit(words_[word]));
+            }
+        }
+        return size_;
+    }
+
+    DynamicArray<word_type> words_;
+    size_type size_{0};
+};
+
+inline DynamicBitArray operator&(DynamicBitArray lhs, const DynamicBitArray &rhs)
+{
+    lhs &= rhs;
+    return lhs;
+}
+
+inline DynamicBitArray operator|(DynamicBitArray lhs, const DynamicBitArray &rhs)
+{
+    lhs |= rhs;
+    return lhs;
+}
+
+inline DynamicBitArray operator^(DynamicBitArray lhs, const DynamicBitArray &rhs)
+{
+    lhs ^= rhs;
+    return lhs;
+}
+
+#endif // DYNAMIC_BIT_ARRAY_H
@@ -0,0 +1,286 @@
+#ifndef EPOCH_RECLAMATION_H
+#define EPOCH_RECLAMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "dynamic_array.h"
+#include "thread_slot_registry.h"
+
+/**
+ * Эпохальное освобождение памяти (epoch-based reclamation) поверх memory_resource.
+ *
+ * Читатели перед доступом к общим данным "прикалываются" к текущей эпохе
+ * (pin() - одна запись в собственный слот потока), писатели откладывают
+ * освобождение через retire(). Отложенный объект освобождается только после
+ * того, как глобальная эпоха продвинулась на два шага: к этому моменту ни один
+ * читатель, который мог его видеть, уже не находится внутри pin().
+ *
+ * Освобождение выполняется под мьютексом домена, поэтому непотокобезопасный
+ * CustomMemoryResource допустим, если выделения из него делает только поток-писатель.
+ */
+class EpochDomain
+{
+public:
+    // RAII-защита читателя: пока объект жив, отложенные объекты не освобождаются
+    class Guard
+    {
+    public:
+        explicit Guard(EpochDomain *domain) : domain_(domain) {}
+
+        Guard(Guard &&other) noexcept : domain_(other.domain_) { other.domain_ = nullptr; }
+
+        ~Guard()
+        {
+            if (domain_)
+            {
+                domain_->unpin();
+            }
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+        Guard &operator=(Guard &&) = delete;
+
+    private:
+        EpochDomain *domain_;
+    };
+
+    explicit EpochDomain(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : resource_(mr) {}
+
+    // К моменту уничтожения читателей быть не должно: всё отложенное освобождается
+    ~EpochDomain()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        retired_.clear();
+    }
+
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain &operator=(const EpochDomain &) = delete;
+
+    std::pmr::memory_resource *resource() const { return resource_; }
+
+    // Читатель: вход в критическую секцию (допускается вложенность)
+    Guard pin()
+    {
+        ReaderSlot &slot = readers_.local();
+        if (slot.depth++ == 0)
+        {
+            slot.epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_seq_cst);
+            // Запись эпохи должна стать видимой до чтения общих данных. Одна seq_cst-запись
+            // этого не даёт: последующие acquire-загрузки могут обогнать её (StoreLoad),
+            // и писатель при обходе слотов пропустит читателя, уже взявшего старый указатель
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return Guard(this);
+    }
+
+    // Писатель: отложить возврат буфера в memory_resource домена
+    void retire(void *ptr, size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        retire_item(std::make_unique<RetiredBuffer>(resource_, ptr, bytes, alignment));
+    }
+
+    // Писатель: отложить уничтожение массива (его буфер вернётся в его memory_resource)
+    template <typename T>
+    void retire(DynamicArray<T> &&array)
+    {
+        retire_item(std::make_unique<RetiredObject<DynamicArray<T>>>(std::move(array)));
+    }
+
+    // Писатель: отложить delete объекта, созданного через new
+    template <typename T>
+    void retire_object(T *object)
+    {
+        retire_item(std::make_unique<RetiredPointer<T>>(object));
+    }
+
+    /**
+     * Пытается продвинуть эпоху и освобождает всё, что стало безопасным.
+     * Вызывается автоматически из retire(), но может вызываться и отдельно.
+     * Возвращает число освобождённых объектов.
+     */
+    size_t try_reclaim()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reclaim_locked();
+    }
+
+    uint64_t get_epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    size_t get_retired_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return retired_.size();
+    }
+
+    size_t get_reclaimed_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return reclaimed_;
+    }
+
+private:
+    struct ReaderSlot
+    {
+        std::atomic<uint64_t> epoch{0}; // Эпоха, к которой прикреплён читатель; 0 = вне секции
+        size_t depth{0};                // Глубина вложенных pin()
+    };
+
+    struct Retired
+    {
+        virtual ~Retired() = default;
+        uint64_t epoch{0};
+    };
+
+    struct RetiredBuffer : Retired
+    {
+        RetiredBuffer(std::pmr::memory_resource *mr, void *ptr, size_t bytes, size_t alignment)
+            : mr(mr), ptr(ptr), bytes(bytes), alignment(alignment) {}
+
+        ~RetiredBuffer() override { mr->deallocate(ptr, bytes, alignment); }
+
+        std::pmr::memory_resource *mr;
+        void *ptr;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    template <typename T>
+    struct RetiredObject : Retired
+    {
+        explicit RetiredObject(T &&value) : value(std::move(value)) {}
+        T value;
+    };
+
+    template <typename T>
+    struct RetiredPointer : Retired
+    {
+        explicit RetiredPointer(T *object) : object(object) {}
+        ~RetiredPointer() override { delete object; }
+        T *object;
+    };
+
+    void unpin()
+    {
+        ReaderSlot &slot = readers_.local();
+        if (--slot.depth == 0)
+        {
+            slot.epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    void retire_item(std::unique_ptr<Retired> item)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        item->epoch = epoch_.load(std::memory_order_relaxed);
+        retired_.push_back(std::move(item));
+        reclaim_locked();
+    }
+
+    // Вызывается под mutex_
+    size_t reclaim_locked()
+    {
+        const uint64_t current = epoch_.load(std::memory_order_relaxed);
+        // Парный к барьеру в pin(): замена указателя видна читателю, не попавшему в обход слотов
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Эпоху можно продвинуть, если все активные читатели уже видели текущую
+        bool can_advance = true;
+        readers_.for_each([&](const ReaderSlot &slot, std::thread::id)
+                          {
+                              const uint64_t pinned = slot.epoch.load(std::memory_order_seq_cst);
+                              if (pinned != 0 && pinned != current)
+                              {
+                                  can_advance = false;
+                              }
+                          });
+        if (can_advance)
+        {
+            epoch_.store(current + 1, std::memory_order_seq_cst);
+        }
+
+        // Объект, отложенный в эпоху e, безопасен, когда глобальная эпоха >= e + 2
+        const uint64_t safe = epoch_.load(std::memory_order_relaxed);
+        size_t freed = 0;
+        auto keep = retired_.begin();
+        for (auto it = retired_.begin(); it != retired_.end(); ++it)
+        {
+            if ((*it)->epoch + 2 <= safe)
+            {
+                it->reset();
+                ++freed;
+            }
+            else
+            {
+                if (keep != it)
+                {
+                    *keep = std::move(*it);
+                }
+                ++keep;
+            }
+        }
+        retired_.erase(keep, retired_.end());
+        reclaimed_ += freed;
+        return freed;
+    }
+
+    std::pmr::memory_resource *resource_;
+    std::atomic<uint64_t> epoch_{1}; // Начинаем с 1: значение 0 в слоте означает "не прикреплён"
+    ThreadSlotRegistry<ReaderSlot> readers_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Retired>> retired_;
+    size_t reclaimed_{0};
+};
+
+/**
+ * Публикация снимков DynamicArray для многих читателей.
+ *
+ * Писатель вызывает publish() с новым снимком; старый снимок уходит в
+ * EpochDomain и освобождается, когда его не может видеть ни один читатель.
+ * Читатель: auto guard = domain.pin(); const DynamicArray<T> *snapshot = publisher.current();
+ */
+template <typename T>
+class SnapshotPublisher
+{
+public:
+    explicit SnapshotPublisher(EpochDomain &domain) : domain_(domain) {}
+
+    ~SnapshotPublisher()
+    {
+        const DynamicArray<T> *last = current_.exchange(nullptr, std::memory_order_acq_rel);
+        if (last)
+        {
+            domain_.retire_object(const_cast<DynamicArray<T> *>(last));
+        }
+    }
+
+    SnapshotPublisher(const SnapshotPublisher &) = delete;
+    SnapshotPublisher &operator=(const SnapshotPublisher &) = delete;
+
+    void publish(DynamicArray<T> &&snapshot)
+    {
+        const DynamicArray<T> *fresh = new DynamicArray<T>(std::move(snapshot));
+        const DynamicArray<T> *old = current_.exchange(fresh, std::memory_order_acq_rel);
+        if (old)
+        {
+            domain_.retire_object(const_cast<DynamicArray<T> *>(old));
+        }
+    }
+
+    // Вызывать только внутри domain.pin()
+    const DynamicArray<T> *current() const { return current_.load(std::memory_order_acquire); }
+
+private:
+    EpochDomain &domain_;
+    std::atomic<const DynamicArray<T> *> current_{nullptr};
+};
+
+#endif // EPOCH_RECLAMATION_H
@@ -0,0 +1,421 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include "dynamic_array.h"
+
+// Раскладка ключей в FlatMap
+enum class FlatMapLayout
+{
+    Sorted,    // Отсортированный массив, бинарный поиск без ветвлений
+    Eytzinger  // Неявное двоичное дерево в ширину: соседние уровни рядом в памяти
+};
+
+/**
+ * Плоский ассоциативный контейнер для таблиц, которые строятся один раз и
+ * часто читаются. Ключи и значения лежат в двух DynamicArray из общего
+ * memory_resource; поиск идёт только по массиву ключей, без обхода указателей.
+ *
+ * Заполнение пакетное: insert складывает пары в буфер, build сортирует их
+ * один раз и раскладывает ключи. Для одинаковых ключей остаётся значение,
+ * вставленное последним. Поиск до вызова build бросает std::logic_error.
+ * Раскладка Eytzinger требует конструктора по умолчанию у Key и Value.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using size_type = size_t;
+
+    // Сколько запросов find_batch ведёт одновременно
+    static constexpr size_t kBatchWidth = 16;
+
+    explicit FlatMap(std::pmr::memory_resource *mr = std::pmr::get_default_resource(),
+                     FlatMapLayout layout = FlatMapLayout::Sorted, Compare compare = Compare())
+        : mr_(mr), layout_(layout), compare_(compare), keys_(mr), values_(mr) {}
+
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last, std::pmr::memory_resource *mr = std::pmr::get_default_resource(),
+            FlatMapLayout layout = FlatMapLayout::Sorted)
+        : FlatMap(mr, layout)
+    {
+        build(first, last);
+    }
+
+    FlatMap(const FlatMap &) = delete;
+    FlatMap &operator=(const FlatMap &) = delete;
+
+    // Добавляет пару в буфер; в поиске она появится после build()
+    void insert(const Key &key, const Value &value)
+    {
+        if (!pending_)
+        {
+            pending_.emplace(mr_);
+        }
+        pending_->emplace_back(key, value);
+    }
+
+    // Сортирует накопленные пары вместе с уже построенными и раскладывает ключи
+    void build()
+    {
+        if (!pending_)
+        {
+            return;
+        }
+
+        DynamicArray<Entry> entries(mr_);
+        entries.reserve(size_ + pending_->size());
+        collect_sorted(entries);
+        for (Entry &entry : *pending_)
+        {
+            entries.push_back(std::move(entry));
+        }
+        pending_.reset();
+
+        std::stable_sort(entries.begin(), entries.end(), [this](const Entry &a, const Entry &b)
+                         { return compare_(a.first, b.first); });
+
+        // Из равных ключей остаётся последний: stable_sort сохранил порядок вставки
+        size_t unique = 0;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if (i + 1 < entries.size() && !compare_(entries[i].first, entries[i + 1].first))
+            {
+                continue;
+            }
+            if (unique != i)
+            {
+                entries[unique] = std::move(entries[i]);
+            }
+            ++unique;
+        }
+        lay_out(entries, unique);
+    }
+
+    // Заменяет содержимое парами из [first, last) и сразу строит раскладку
+    template <typename InputIt>
+    void build(InputIt first, InputIt last)
+    {
+        clear();
+        for (; first != last; ++first)
+        {
+            insert(first->first, first->second);
+        }
+        build();
+    }
+
+    void clear()
+    {
+        pending_.reset();
+        keys_.clear();
+        values_.clear();
+        size_ = 0;
+    }
+
+    // Перестраивает ключи под другую раскладку
+    void set_layout(FlatMapLayout layout)
+    {
+        if (layout == layout_)
+        {
+            return;
+        }
+        build();
+        DynamicArray<Entry> entries(mr_);
+        entries.reserve(size_);
+        collect_sorted(entries);
+        layout_ = layout;
+        lay_out(entries, entries.size());
+    }
+
+    FlatMapLayout get_layout() const { return layout_; }
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Значение по ключу или nullptr
+    const Value *find(const Key &key) const
+    {
+        check_built();
+        const size_t index = layout_ == FlatMapLayout::Sorted ? sorted_lower_bound(key) : eytzinger_lower_bound(key);
+        return matches(index, key) ? &values_[index] : nullptr;
+    }
+
+    Value *find(const Key &key)
+    {
+        return const_cast<Value *>(static_cast<const FlatMap *>(this)->find(key));
+    }
+
+    bool contains(const Key &key) const { return find(key) != nullptr; }
+
+    const Value &at(const Key &key) const
+    {
+        const Value *value = find(key);
+        if (!value)
+        {
+            throw std::out_of_range("FlatMap::at: ключ не найден");
+        }
+        return *value;
+    }
+
+    /**
+     * Ищет count ключей сразу: results[i] - значение для keys[i] или nullptr.
+     * Запросы идут группами по kBatchWidth, на каждом шаге поиска все запросы
+     * группы спускаются на уровень вниз, и промахи кэша по разным ключам
+     * перекрываются, а не ждут друг друга.
+     */
+    void find_batch(const Key *keys, size_t count, const Value **results) const
+    {
+        check_built();
+        for (size_t start = 0; start < count; start += kBatchWidth)
+        {
+            const size_t width = std::min(kBatchWidth, count - start);
+            if (layout_ == FlatMapLayout::Sorted)
+            {
+                sorted_batch(keys + start, width, results + start);
+            }
+            else
+            {
+                eytzinger_batch(keys + start, width, results + start);
+            }
+        }
+    }
+
+    // Обходит пары в порядке возрастания ключей
+    template <typename Fn>
+    void for_each(Fn &&fn) const
+    {
+        check_built();
+        if (layout_ == FlatMapLayout::Sorted)
+        {
+            for (size_t i = 0; i < size_; ++i)
+            {
+                fn(keys_[i], values_[i]);
+            }
+            return;
+        }
+        eytzinger_in_order(1, fn);
+    }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    // Ключей одного уровня Eytzinger в строке кэша: на столько узлов вперёд делается prefetch
+    static constexpr size_t kPrefetchStride = sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+
+    void check_built() const
+    {
+        if (pending_)
+        {
+            throw std::logic_error("FlatMap: есть вставленные пары без build()");
+        }
+    }
+
+    bool matches(size_t index, const Key &key) const
+    {
+        if (layout_ == FlatMapLayout::Sorted)
+        {
+            return index < size_ && !compare_(key, keys_[index]);
+        }
+        return index != 0 && !compare_(key, keys_[index]);
+    }
+
+    // Индекс первого ключа не меньше key в отсортированном массиве; size_, если такого нет
+    size_t sorted_lower_bound(const Key &key) const
+    {
+        if (size_ == 0)
+        {
+            return 0;
+        }
+        const Key *base = keys_.data();
+        size_t n = size_;
+        while (n > 1)
+        {
+            const size_t half = n / 2;
+            prefetch(base + half / 2);
+            prefetch(base + half + half / 2);
+            base = compare_(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<size_t>(base - keys_.data()) + compare_(*base, key);
+    }
+
+    /**
+     * Спуск по дереву Eytzinger: у узла k дети 2k и 2k+1. После выхода за
+     * пределы массива младшие единичные биты k - это повороты направо после
+     * последнего поворота налево; их сдвиг даёт узел ответа (0 - ответа нет).
+     */
+    size_t eytzinger_lower_bound(const Key &key) const
+    {
+        const Key *b = keys_.data();
+        size_t k = 1;
+        while (k <= size_)
+        {
+            prefetch(b + k * kPrefetchStride);
+            k = 2 * k + compare_(b[k], key);
+        }
+        return eytzinger_answer(k);
+    }
+
+    static size_t eytzinger_answer(size_t k)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+        while (k & 1)
+        {
+            k >>= 1;
+        }
+        return k >> 1;
+#endif
+    }
+
+    // Подсказка загрузить строку кэша заранее; без GCC/Clang ничего не делает
+    static void prefetch(const void *address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    void sorted_batch(const Key *keys, size_t width, const Value **results) const
+    {
+        if (size_ == 0)
+        {
+            std::fill(results, results + width, nullptr);
+            return;
+        }
+
+        const Key *base[kBatchWidth];
+        std::fill(base, base + width, keys_.data());
+        for (size_t n = size_; n > 1;)
+        {
+            const size_t half = n / 2;
+            for (size_t q = 0; q < width; ++q)
+            {
+                base[q] = compare_(base[q][half], keys[q]) ? base[q] + half : base[q];
+            }
+            n -= half;
+            for (size_t q = 0; q < width; ++q)
+            {
+                prefetch(base[q] + n / 2);
+            }
+        }
+        for (size_t q = 0; q < width; ++q)
+        {
+            const size_t index = static_cast<size_t>(base[q] - keys_.data()) + compare_(*base[q], keys[q]);
+            results[q] = matches(index, keys[q]) ? &values_[index] : nullptr;
+        }
+    }
+
+    void eytzinger_batch(const Key *keys, size_t width, const Value **results) const
+    {
+        const Key *b = keys_.data();
+        size_t k[kBatchWidth];
+        std::fill(k, k + width, size_t(1));
+        // Глубина дерева одинакова для всех запросов, отличается только последний неполный уровень
+        for (size_t level_start = 1; level_start <= size_; level_start *= 2)
+        {
+            for (size_t q = 0; q < width; ++q)
+            {
+                if (k[q] <= size_)
+                {
+                    k[q] = 2 * k[q] + compare_(b[k[q]], keys[q]);
+                    prefetch(b + k[q] * kPrefetchStride);
+                }
+            }
+        }
+        for (size_t q = 0; q < width; ++q)
+        {
+            const size_t index = eytzinger_answer(k[q]);
+            results[q] = matches(index, keys[q]) ? &values_[index] : nullptr;
+        }
+    }
+
+    // Раскладывает первые count отсортированных пар из entries
+    void lay_out(DynamicArray<Entry> &entries, size_t count)
+    {
+        keys_.clear();
+        values_.clear();
+        size_ = count;
+        if (layout_ == FlatMapLayout::Sorted)
+        {
+            keys_.reserve(count);
+            values_.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                keys_.push_back(std::move(entries[i].first));
+                values_.push_back(std::move(entries[i].second));
+            }
+            return;
+        }
+
+        // Узлы нумеруются с 1, нулевой элемент не используется
+        keys_.resize(count + 1);
+        values_.resize(count + 1);
+        size_t next = 0;
+        eytzinger_fill(entries, next, 1);
+    }
+
+    // Обход дерева в симметричном порядке раздаёт узлам пары по возрастанию
+    void eytzinger_fill(DynamicArray<Entry> &entries, size_t &next, size_t k)
+    {
+        if (k > size_)
+        {
+            return;
+        }
+        eytzinger_fill(entries, next, 2 * k);
+        keys_[k] = std::move(entries[next].first);
+        values_[k] = std::move(entries[next].second);
+        ++next;
+        eytzinger_fill(entries, next, 2 * k + 1);
+    }
+
+    template <typename Fn>
+    void eytzinger_in_order(size_t k, Fn &fn) const
+    {
+        if (k > size_)
+        {
+            return;
+        }
+        eytzinger_in_order(2 * k, fn);
+        fn(keys_[k], values_[k]);
+        eytzinger_in_order(2 * k + 1, fn);
+    }
+
+    // Копирует построенные пары по возрастанию ключей
+    void collect_sorted(DynamicArray<Entry> &entries) const
+    {
+        if (layout_ == FlatMapLayout::Sorted)
+        {
+            for (size_t i = 0; i < size_; ++i)
+            {
+                entries.emplace_back(keys_[i], values_[i]);
+            }
+            return;
+        }
+        auto append = [&entries](const Key &key, const Value &value)
+        {
+            entries.emplace_back(key, value);
+        };
+        eytzinger_in_order(1, append);
+    }
+
+    std::pmr::memory_resource *mr_;
+    FlatMapLayout layout_;
+    Compare compare_;
+    DynamicArray<Key> keys_;
+    DynamicArray<Value> values_;
+    size_t size_{0};
+    std::optional<DynamicArray<Entry>> pending_; // Вставленные, но ещё не разложенные пары
+};
+
+#endif // FLAT_MAP_H
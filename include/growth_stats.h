@@ -0,0 +1,248 @@
+#ifndef GROWTH_STATS_H
+#define GROWTH_STATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define LAB5_HAS_CXXABI 1
+#endif
+#endif
+
+/**
+ * Учёт роста контейнеров. DynamicArray пишет сюда только при сборке с
+ * LAB5_GROWTH_STATS (cmake -DLAB5_GROWTH_STATS=ON); в обычной сборке массив
+ * не содержит ни лишних полей, ни лишних инструкций.
+ *
+ * Счётчики агрегируются по тегу: по умолчанию это имя типа элемента,
+ * DynamicArray::set_growth_tag задаёт своё (например, "parser.tokens").
+ */
+class GrowthCounters
+{
+public:
+    // Буфер заменён новым (старый был непуст)
+    void on_reallocate(size_t elements, size_t bytes, size_t new_capacity)
+    {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+        elements_moved_.fetch_add(elements, std::memory_order_relaxed);
+        bytes_moved_.fetch_add(bytes, std::memory_order_relaxed);
+        update_max(peak_capacity_, new_capacity);
+    }
+
+    // Первое выделение буфера
+    void on_allocate(size_t capacity)
+    {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        update_max(peak_capacity_, capacity);
+    }
+
+    // Массив освобождает буфер: итоговые размер и ёмкость
+    void on_release(size_t size, size_t capacity)
+    {
+        arrays_.fetch_add(1, std::memory_order_relaxed);
+        final_size_.fetch_add(size, std::memory_order_relaxed);
+        final_capacity_.fetch_add(capacity, std::memory_order_relaxed);
+        update_max(max_final_size_, size);
+    }
+
+    void reset()
+    {
+        for (std::atomic<size_t> *counter : {&arrays_, &allocations_, &reallocations_, &elements_moved_,
+                                             &bytes_moved_, &peak_capacity_, &final_size_, &final_capacity_,
+                                             &max_final_size_})
+        {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+
+    size_t get_arrays_count() const { return arrays_.load(std::memory_order_relaxed); }
+    size_t get_allocations_count() const { return allocations_.load(std::memory_order_relaxed); }
+    size_t get_reallocations_count() const { return reallocations_.load(std::memory_order_relaxed); }
+    size_t get_elements_moved() const { return elements_moved_.load(std::memory_order_relaxed); }
+    size_t get_bytes_moved() const { return bytes_moved_.load(std::memory_order_relaxed); }
+    size_t get_peak_capacity() const { return peak_capacity_.load(std::memory_order_relaxed); }
+    size_t get_max_final_size() const { return max_final_size_.load(std::memory_order_relaxed); }
+
+    // Доля ёмкости, которая так и не была занята к моменту освобождения массивов
+    double get_wasted_capacity_ratio() const
+    {
+        const size_t capacity = final_capacity_.load(std::memory_order_relaxed);
+        if (capacity == 0)
+        {
+            return 0.0;
+        }
+        return 1.0 - static_cast<double>(final_size_.load(std::memory_order_relaxed)) / static_cast<double>(capacity);
+    }
+
+    // Среднее число переносов буфера на один массив
+    double get_reallocations_per_array() const
+    {
+        const size_t arrays = get_arrays_count();
+        return arrays > 0 ? static_cast<double>(get_reallocations_count()) / static_cast<double>(arrays) : 0.0;
+    }
+
+    /**
+     * Подсказка для reserve: средний итоговый размер массивов с этим тегом
+     * (с округлением вверх). Не максимум: один большой массив не должен
+     * раздувать резерв всех последующих. 0, если статистики ещё нет.
+     */
+    size_t get_reserve_hint() const
+    {
+        const size_t arrays = get_arrays_count();
+        if (arrays == 0)
+        {
+            return 0;
+        }
+        return (final_size_.load(std::memory_order_relaxed) + arrays - 1) / arrays;
+    }
+
+private:
+    static void update_max(std::atomic<size_t> &target, size_t value)
+    {
+        size_t current = target.load(std::memory_order_relaxed);
+        while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    std::atomic<size_t> arrays_{0};
+    std::atomic<size_t> allocations_{0};
+    std::atomic<size_t> reallocations_{0};
+    std::atomic<size_t> elements_moved_{0};
+    std::atomic<size_t> bytes_moved_{0};
+    std::atomic<size_t> peak_capacity_{0};
+    std::atomic<size_t> final_size_{0};
+    std::atomic<size_t> final_capacity_{0};
+    std::atomic<size_t> max_final_size_{0};
+};
+
+/**
+ * Глобальный реестр счётчиков роста. Счётчики создаются при первом обращении
+ * к тегу и живут до конца программы, поэтому массив хранит на них указатель
+ * и обновляет без блокировок.
+ */
+class GrowthRegistry
+{
+public:
+    static GrowthRegistry &instance()
+    {
+        static GrowthRegistry registry;
+        return registry;
+    }
+
+    GrowthCounters &counters(const std::string &tag)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<GrowthCounters> &slot = counters_[tag];
+        if (!slot)
+        {
+            slot.reset(new GrowthCounters());
+        }
+        return *slot;
+    }
+
+    // Счётчики тега или nullptr, если тег ещё не встречался
+    const GrowthCounters *find(const std::string &tag) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = counters_.find(tag);
+        return it != counters_.end() ? it->second.get() : nullptr;
+    }
+
+    std::vector<std::string> tags() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> result;
+        for (const auto &entry : counters_)
+        {
+            result.push_back(entry.first);
+        }
+        return result;
+    }
+
+    // Подсказка для reserve по тегу; 0, если статистики нет
+    size_t reserve_hint(const std::string &tag) const
+    {
+        const GrowthCounters *counters = find(tag);
+        return counters ? counters->get_reserve_hint() : 0;
+    }
+
+    // Обнуляет счётчики; сами теги остаются (на них ссылаются живые массивы)
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &entry : counters_)
+        {
+            entry.second->reset();
+        }
+    }
+
+    /**
+     * Таблица по всем тегам: строка на тег, поля через " | ".
+     * Формат рассчитан и на чтение глазами, и на разбор скриптом.
+     */
+    void dump(std::ostream &out) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out << "тег | массивов | переносов | перенесено элементов | перенесено байт | пик ёмкости | потери ёмкости, %\n";
+        for (const auto &entry : counters_)
+        {
+            const GrowthCounters &c = *entry.second;
+            out << entry.first << " | "
+                << c.get_arrays_count() << " | "
+                << c.get_reallocations_count() << " | "
+                << c.get_elements_moved() << " | "
+                << c.get_bytes_moved() << " | "
+                << c.get_peak_capacity() << " | "
+                << c.get_wasted_capacity_ratio() * 100.0 << "\n";
+        }
+    }
+
+private:
+    GrowthRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<GrowthCounters>> counters_;
+};
+
+namespace growth_stats_detail
+{
+    inline std::string demangle(const char *name)
+    {
+#ifdef LAB5_HAS_CXXABI
+        int status = 0;
+        char *readable = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status != 0 || !readable)
+        {
+            return name;
+        }
+        std::string result(readable);
+        std::free(readable);
+        return result;
+#else
+        // MSVC и так возвращает читаемое имя
+        return name;
+#endif
+    }
+
+    // Счётчики по умолчанию для массивов с элементами типа T
+    template <typename T>
+    GrowthCounters &type_counters()
+    {
+        static GrowthCounters &counters = GrowthRegistry::instance().counters(demangle(typeid(T).name()));
+        return counters;
+    }
+}
+
+#endif // GROWTH_STATS_H
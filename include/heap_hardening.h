@@ -0,0 +1,158 @@
+#ifndef HEAP_HARDENING_H
+#define HEAP_HARDENING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Вид обнаруженной ошибки работы с памятью
+enum class HeapErrorKind
+{
+    BufferUnderflow, // Повреждена канарейка перед блоком
+    BufferOverflow,  // Повреждена канарейка после блока (запись за пределы, например за capacity)
+    DoubleFree,      // Повторное освобождение уже свободного блока
+    InvalidFree,     // Освобождение указателя, который ресурс не выдавал
+    SizeMismatch,    // bytes/alignment при освобождении не совпадают с выделением
+    UseAfterFree     // Запись в освобождённый блок (испорчен "яд")
+};
+
+inline const char *heap_error_name(HeapErrorKind kind)
+{
+    switch (kind)
+    {
+    case HeapErrorKind::BufferUnderflow:
+        return "buffer-underflow";
+    case HeapErrorKind::BufferOverflow:
+        return "buffer-overflow";
+    case HeapErrorKind::DoubleFree:
+        return "double-free";
+    case HeapErrorKind::InvalidFree:
+        return "invalid-free";
+    case HeapErrorKind::SizeMismatch:
+        return "size-mismatch";
+    case HeapErrorKind::UseAfterFree:
+        return "use-after-free";
+    }
+    return "unknown";
+}
+
+// Исключение с точным описанием ошибки: вид, адрес блока, размеры
+class HeapCorruptionError : public std::runtime_error
+{
+public:
+    HeapCorruptionError(HeapErrorKind kind, const void *address, size_t block_size, const std::string &details)
+        : std::runtime_error(format(kind, address, block_size, details)),
+          kind_(kind), address_(address), block_size_(block_size) {}
+
+    HeapErrorKind kind() const { return kind_; }
+    const void *address() const { return address_; }
+    size_t block_size() const { return block_size_; }
+
+private:
+    static std::string format(HeapErrorKind kind, const void *address, size_t block_size, const std::string &details)
+    {
+        std::ostringstream out;
+        out << "CustomMemoryResource: " << heap_error_name(kind)
+            << " (блок " << address << ", размер " << block_size << " байт)";
+        if (!details.empty())
+        {
+            out << ": " << details;
+        }
+        return out.str();
+    }
+
+    HeapErrorKind kind_;
+    const void *address_;
+    size_t block_size_;
+};
+
+// Реакция на обнаруженную ошибку
+enum class HardeningAction
+{
+    Throw, // Бросить HeapCorruptionError; при освобождении (из noexcept-кода) - как Abort
+    Abort, // Напечатать отчёт в stderr и вызвать std::abort (для боевых машин)
+    Log    // Напечатать отчёт в stderr и продолжить работу
+};
+
+/**
+ * Настройки режима усиленной проверки CustomMemoryResource.
+ * По умолчанию всё выключено; при сборке с LAB5_HARDENED ресурс по
+ * умолчанию использует HardeningOptions::full().
+ */
+struct HardeningOptions
+{
+    bool canaries{false};            // Канарейки по 8 байт до и после каждого блока
+    bool poison{false};              // Заполнять освобождённые блоки kFreedPoison и проверять при повторном выдаче
+    size_t quarantine_size{0};       // Сколько освобождённых блоков держать перед повторным использованием
+    bool guard_pages{false};         // Блоки от guard_page_threshold байт - в mmap с защитной страницей в конце
+    size_t guard_page_threshold{64 * 1024};
+    HardeningAction action{HardeningAction::Throw};
+
+    bool enabled() const { return canaries || poison || quarantine_size != 0 || guard_pages; }
+
+    // Все проверки включены
+    static HardeningOptions full()
+    {
+        HardeningOptions options;
+        options.canaries = true;
+        options.poison = true;
+        options.quarantine_size = 256;
+        options.guard_pages = true;
+        return options;
+    }
+
+    // Настройки, выбранные при компиляции
+    static HardeningOptions compiled_default()
+    {
+#ifdef LAB5_HARDENED
+        return full();
+#else
+        return HardeningOptions();
+#endif
+    }
+};
+
+namespace heap_hardening_detail
+{
+    constexpr size_t kCanarySize = sizeof(uint64_t);
+    constexpr unsigned char kFreedPoison = 0xDD;
+    constexpr uint64_t kCanarySeed = 0xC0DEFACEB16B00B5ull;
+
+    // Канарейка зависит от адреса, чтобы скопированная чужая канарейка не прошла проверку
+    inline uint64_t canary_for(const void *where)
+    {
+        return kCanarySeed ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(where));
+    }
+
+    inline void write_canary(void *where)
+    {
+        const uint64_t value = canary_for(where);
+        std::memcpy(where, &value, kCanarySize);
+    }
+
+    inline bool check_canary(const void *where)
+    {
+        uint64_t value;
+        std::memcpy(&value, where, kCanarySize);
+        return value == canary_for(where);
+    }
+
+    // Возвращает смещение первого байта, отличного от яда, или size, если яд цел
+    inline size_t find_poison_damage(const void *ptr, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(ptr);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (bytes[i] != kFreedPoison)
+            {
+                return i;
+            }
+        }
+        return size;
+    }
+}
+
+#endif // HEAP_HARDENING_H
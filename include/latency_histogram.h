@@ -0,0 +1,151 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Гистограмма задержек в духе HdrHistogram: логарифмически-линейные корзины
+ * с постоянной относительной точностью.
+ *
+ * Значения меньше 2^kPrecisionBits хранятся точно. Каждый следующий отрезок
+ * [2^k, 2^(k+1)) делится на 2^(kPrecisionBits-1) равных корзин, поэтому
+ * ошибка перцентиля не превышает 1/2^(kPrecisionBits-1) (~1.6%) значения
+ * на всём диапазоне uint64_t. Запись - несколько инструкций без ветвлений
+ * по диапазону, размер фиксирован (~30 КБ) и не зависит от числа записей.
+ *
+ * Не потокобезопасна: каждому потоку своя гистограмма, в конце - merge().
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned kPrecisionBits = 7;
+    static constexpr size_t kExactCount = size_t(1) << kPrecisionBits;
+    static constexpr size_t kSubBucketCount = kExactCount / 2;
+    static constexpr size_t kBucketCount = kExactCount + (64 - kPrecisionBits) * kSubBucketCount;
+
+    LatencyHistogram() : counts_(kBucketCount, 0) {}
+
+    void record(uint64_t value)
+    {
+        ++counts_[bucket_index(value)];
+        ++count_;
+        sum_ += value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    // Добавляет записи другой гистограммы
+    void merge(const LatencyHistogram &other)
+    {
+        for (size_t i = 0; i < kBucketCount; ++i)
+        {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    void reset()
+    {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        count_ = 0;
+        sum_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    /**
+     * Значение, не превышаемое percentile процентами записей (0..100).
+     * Возвращается верхняя граница корзины, но не больше максимума.
+     */
+    uint64_t value_at_percentile(double percentile) const
+    {
+        if (count_ == 0)
+        {
+            return 0;
+        }
+        percentile = std::min(std::max(percentile, 0.0), 100.0);
+        uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count_) + 0.5);
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBucketCount; ++i)
+        {
+            seen += counts_[i];
+            if (seen >= rank)
+            {
+                return std::min(std::max(bucket_upper(i), min_), max_);
+            }
+        }
+        return max_;
+    }
+
+    uint64_t get_count() const { return count_; }
+    uint64_t get_min() const { return count_ == 0 ? 0 : min_; }
+    uint64_t get_max() const { return max_; }
+    double get_mean() const { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+    // Номер корзины значения и её границы (включительно)
+    static size_t bucket_index(uint64_t value)
+    {
+        if (value < kExactCount)
+        {
+            return static_cast<size_t>(value);
+        }
+        const unsigned shift = highest_bit(value) - (kPrecisionBits - 1);
+        const size_t sub = static_cast<size_t>(value >> shift) - kSubBucketCount;
+        return kExactCount + (shift - 1) * kSubBucketCount + sub;
+    }
+
+    static uint64_t bucket_lower(size_t index)
+    {
+        if (index < kExactCount)
+        {
+            return index;
+        }
+        const size_t k = index - kExactCount;
+        const unsigned shift = static_cast<unsigned>(k / kSubBucketCount) + 1;
+        return static_cast<uint64_t>(kSubBucketCount + k % kSubBucketCount) << shift;
+    }
+
+    static uint64_t bucket_upper(size_t index)
+    {
+        if (index < kExactCount)
+        {
+            return index;
+        }
+        const size_t k = index - kExactCount;
+        const unsigned shift = static_cast<unsigned>(k / kSubBucketCount) + 1;
+        return bucket_lower(index) + ((uint64_t(1) << shift) - 1);
+    }
+
+private:
+    // Номер старшего единичного бита (value != 0)
+    static unsigned highest_bit(uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1)
+        {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    std::vector<uint64_t> counts_;
+    uint64_t count_{0};
+    uint64_t sum_{0};
+    uint64_t min_{std::numeric_limits<uint64_t>::max()};
+    uint64_t max_{0};
+};
+
+#endif // LATENCY_HISTOGRAM_H
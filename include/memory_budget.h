@@ -0,0 +1,108 @@
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Лимит памяти в байтах с иерархией: бюджет ресурса может входить в бюджет
+ * сервиса, а тот - в общий бюджет процесса. Байты учитываются на всех уровнях
+ * сразу; запрос отклоняется, если переполнится хотя бы один из них.
+ *
+ * Счётчики атомарные, поэтому один родительский бюджет можно делить между
+ * ресурсами из разных потоков. Учёт стоит одного fetch_add на уровень и
+ * делается только тогда, когда ресурс берёт новую память у системы.
+ * Бюджет должен жить дольше дочерних бюджетов и ресурсов, которые его используют.
+ */
+class MemoryBudget
+{
+public:
+    static constexpr size_t kUnlimited = SIZE_MAX;
+
+    explicit MemoryBudget(size_t limit = kUnlimited, MemoryBudget *parent = nullptr, std::string name = "")
+        : limit_(limit), parent_(parent), name_(std::move(name)) {}
+
+    MemoryBudget(const MemoryBudget &) = delete;
+    MemoryBudget &operator=(const MemoryBudget &) = delete;
+
+    /**
+     * Учитывает bytes на этом уровне и у всех предков. Если какой-то уровень
+     * переполнен, уже учтённое откатывается и возвращается этот уровень;
+     * при успехе возвращается nullptr.
+     */
+    MemoryBudget *try_charge(size_t bytes)
+    {
+        for (MemoryBudget *level = this; level != nullptr; level = level->parent_)
+        {
+            if (!level->charge_local(bytes))
+            {
+                for (MemoryBudget *done = this; done != level; done = done->parent_)
+                {
+                    done->used_.fetch_sub(bytes, std::memory_order_relaxed);
+                }
+                return level;
+            }
+        }
+        return nullptr;
+    }
+
+    // Возвращает bytes на всех уровнях
+    void release(size_t bytes)
+    {
+        for (MemoryBudget *level = this; level != nullptr; level = level->parent_)
+        {
+            level->used_.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    // Новый лимит действует для следующих запросов; уже учтённое не отбирается
+    void set_limit(size_t limit) { limit_.store(limit, std::memory_order_relaxed); }
+
+    size_t get_limit() const { return limit_.load(std::memory_order_relaxed); }
+    size_t get_used() const { return used_.load(std::memory_order_relaxed); }
+    size_t get_peak() const { return peak_.load(std::memory_order_relaxed); }
+
+    size_t get_available() const
+    {
+        const size_t limit = get_limit();
+        const size_t used = get_used();
+        return used < limit ? limit - used : 0;
+    }
+
+    // Сколько запросов отклонено на этом уровне
+    size_t get_rejections_count() const { return rejections_.load(std::memory_order_relaxed); }
+
+    MemoryBudget *get_parent() const { return parent_; }
+    const std::string &get_name() const { return name_; }
+
+private:
+    bool charge_local(size_t bytes)
+    {
+        const size_t limit = limit_.load(std::memory_order_relaxed);
+        const size_t previous = used_.fetch_add(bytes, std::memory_order_relaxed);
+        if (previous + bytes > limit || previous + bytes < previous)
+        {
+            used_.fetch_sub(bytes, std::memory_order_relaxed);
+            rejections_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        size_t peak = peak_.load(std::memory_order_relaxed);
+        while (previous + bytes > peak &&
+               !peak_.compare_exchange_weak(peak, previous + bytes, std::memory_order_relaxed))
+        {
+        }
+        return true;
+    }
+
+    std::atomic<size_t> limit_;
+    std::atomic<size_t> used_{0};
+    std::atomic<size_t> peak_{0};
+    std::atomic<size_t> rejections_{0};
+    MemoryBudget *parent_;
+    std::string name_;
+};
+
+#endif // MEMORY_BUDGET_H
@@ -0,0 +1,215 @@
+#ifndef PAGE_ALLOCATOR_H
+#define PAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define LAB5_HAS_MMAP 1
+#else
+#define LAB5_HAS_MMAP 0
+#endif
+
+// Регион памяти, полученный напрямую у ОС через mmap
+struct MappedRegion
+{
+    void *ptr{nullptr}; // Начало региона (nullptr, если отобразить не удалось)
+    size_t size{0};     // Размер отображения в байтах (нужен для munmap)
+    bool hugetlb{false}; // true = регион из пула MAP_HUGETLB, false = обычные страницы (+ MADV_HUGEPAGE)
+};
+
+/**
+ * Тонкая обёртка над mmap/munmap для больших выделений.
+ * На платформах без mmap все функции возвращают пустой регион,
+ * и вызывающий код откатывается на ::operator new.
+ */
+class PageAllocator
+{
+public:
+    // Размер большой страницы x86-64/AArch64 по умолчанию
+    static constexpr size_t kHugePageSize = size_t(2) * 1024 * 1024;
+
+    static bool supported() { return LAB5_HAS_MMAP != 0; }
+
+    static size_t page_size()
+    {
+#if LAB5_HAS_MMAP
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    static size_t round_up(size_t bytes, size_t granularity)
+    {
+        return (bytes + granularity - 1) / granularity * granularity;
+    }
+
+    /**
+     * Отображает регион размером не меньше bytes, выровненный на 2 МБ.
+     * Если try_hugetlb == true, сначала пробует MAP_HUGETLB (нужны заранее
+     * зарезервированные страницы в /proc/sys/vm/nr_hugepages), затем
+     * откатывается на обычное отображение с подсказкой MADV_HUGEPAGE.
+     */
+    static MappedRegion map_huge(size_t bytes, bool try_hugetlb)
+    {
+        MappedRegion region;
+#if LAB5_HAS_MMAP
+        const size_t size = round_up(bytes, kHugePageSize);
+
+#ifdef MAP_HUGETLB
+        if (try_hugetlb)
+        {
+            void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED)
+            {
+                region.ptr = ptr;
+                region.size = size;
+                region.hugetlb = true;
+                return region;
+            }
+        }
+#else
+        (void)try_hugetlb;
+#endif
+
+        // Берём с запасом в одну большую страницу, чтобы вырезать из середины
+        // выровненный на 2 МБ кусок, а лишние хвосты вернуть ОС
+        const size_t span = size + kHugePageSize;
+        void *raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+        {
+            return region;
+        }
+
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (begin + kHugePageSize - 1) & ~(uintptr_t(kHugePageSize) - 1);
+        const size_t head = aligned - begin;
+        const size_t tail = span - head - size;
+        if (head != 0)
+        {
+            ::munmap(raw, head);
+        }
+        if (tail != 0)
+        {
+            ::munmap(reinterpret_cast<void *>(aligned + size), tail);
+        }
+
+#ifdef MADV_HUGEPAGE
+        // Подсказка ядру: собрать регион из прозрачных больших страниц (THP)
+        ::madvise(reinterpret_cast<void *>(aligned), size, MADV_HUGEPAGE);
+#endif
+
+        region.ptr = reinterpret_cast<void *>(aligned);
+        region.size = size;
+#else
+        (void)bytes;
+        (void)try_hugetlb;
+#endif
+        return region;
+    }
+
+    /**
+     * Отображает регион из round_up(bytes, page) байт плюс одну защитную
+     * страницу PROT_NONE в конце: любая запись за границу региона сразу
+     * приводит к SIGSEGV. size в результате включает защитную страницу.
+     */
+    static MappedRegion map_guarded(size_t bytes)
+    {
+        MappedRegion region;
+#if LAB5_HAS_MMAP
+        const size_t page = page_size();
+        const size_t size = round_up(bytes, page) + page;
+        void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            return region;
+        }
+        if (::mprotect(static_cast<char *>(ptr) + size - page, page, PROT_NONE) != 0)
+        {
+            ::munmap(ptr, size);
+            return region;
+        }
+        region.ptr = ptr;
+        region.size = size;
+#else
+        (void)bytes;
+#endif
+        return region;
+    }
+
+    /**
+     * Отображает регион из round_up(bytes, page) байт с уже подгруженными
+     * страницами (MAP_POPULATE): первое обращение не вызывает page fault.
+     * Без MAP_POPULATE страницы подгружаются записью в каждую.
+     */
+    static MappedRegion map_populated(size_t bytes)
+    {
+        MappedRegion region;
+#if LAB5_HAS_MMAP
+        const size_t size = round_up(bytes, page_size());
+#ifdef MAP_POPULATE
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+#else
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#endif
+        void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            return region;
+        }
+#ifndef MAP_POPULATE
+        prefault(ptr, size);
+#endif
+        region.ptr = ptr;
+        region.size = size;
+#else
+        (void)bytes;
+#endif
+        return region;
+    }
+
+    // Подгружает страницы региона, записывая по байту в каждую
+    static void prefault(void *ptr, size_t size)
+    {
+        volatile char *bytes = static_cast<char *>(ptr);
+        for (size_t offset = 0; offset < size; offset += page_size())
+        {
+            bytes[offset] = 0;
+        }
+    }
+
+    // Открывает (accessible == true) или закрывает доступ к страницам региона
+    static bool protect(void *ptr, size_t size, bool accessible)
+    {
+#if LAB5_HAS_MMAP
+        return ::mprotect(ptr, size, accessible ? (PROT_READ | PROT_WRITE) : PROT_NONE) == 0;
+#else
+        (void)ptr;
+        (void)size;
+        (void)accessible;
+        return false;
+#endif
+    }
+
+    static void unmap(void *ptr, size_t size)
+    {
+#if LAB5_HAS_MMAP
+        if (ptr)
+        {
+            ::munmap(ptr, size);
+        }
+#else
+        (void)ptr;
+        (void)size;
+#endif
+    }
+};
+
+#endif // PAGE_ALLOCATOR_H
@@ -0,0 +1,354 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "dynamic_array.h"
+
+/**
+ * Поразрядная сортировка DynamicArray по байтам ключа (LSD, 8 бит за проход).
+ * Подходит для целых и вещественных ключей: они переводятся в беззнаковые
+ * биты с тем же порядком. Сортировка устойчивая; проходы по байтам, у которых
+ * все ключи совпадают, пропускаются. Вспомогательные буферы берутся из
+ * memory_resource самого массива.
+ *
+ * Вещественные ключи упорядочиваются как числа: -0.0 встаёт перед 0.0,
+ * NaN со знаком - в начало, без знака - в конец.
+ */
+namespace radix_sort_detail
+{
+    template <size_t Size>
+    struct UnsignedOfSize;
+
+    template <>
+    struct UnsignedOfSize<1>
+    {
+        using type = uint8_t;
+    };
+
+    template <>
+    struct UnsignedOfSize<2>
+    {
+        using type = uint16_t;
+    };
+
+    template <>
+    struct UnsignedOfSize<4>
+    {
+        using type = uint32_t;
+    };
+
+    template <>
+    struct UnsignedOfSize<8>
+    {
+        using type = uint64_t;
+    };
+
+    template <typename K>
+    constexpr bool is_radix_key()
+    {
+        return std::is_arithmetic<K>::value && !std::is_same<K, bool>::value && sizeof(K) <= 8 &&
+               (!std::is_floating_point<K>::value || sizeof(K) == 4 || sizeof(K) == 8);
+    }
+
+    template <typename K>
+    using KeyBits = typename UnsignedOfSize<sizeof(K)>::type;
+
+    // Переводит ключ в беззнаковые биты, сравнение которых совпадает со сравнением ключей
+    template <typename K>
+    KeyBits<K> encode_key(K key)
+    {
+        using Bits = KeyBits<K>;
+        constexpr Bits kSign = Bits(1) << (sizeof(Bits) * 8 - 1);
+        if constexpr (std::is_floating_point<K>::value)
+        {
+            Bits bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            return (bits & kSign) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | kSign);
+        }
+        else if constexpr (std::is_signed<K>::value)
+        {
+            return static_cast<Bits>(static_cast<Bits>(key) ^ kSign);
+        }
+        else
+        {
+            return key;
+        }
+    }
+
+    /**
+     * LSD-проходы по младшим bytes байтам ключа bits(element).
+     * Элементы перекладываются между data и tmp; возвращает указатель на буфер,
+     * в котором оказался результат.
+     */
+    template <typename T, typename Bits, typename GetBits>
+    T *lsd_passes(T *data, T *tmp, size_t n, unsigned bytes, GetBits bits)
+    {
+        size_t counts[sizeof(Bits)][256] = {};
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Bits key = bits(data[i]);
+            for (unsigned d = 0; d < bytes; ++d)
+            {
+                ++counts[d][(key >> (d * 8)) & 0xFF];
+            }
+        }
+
+        T *src = data;
+        T *dst = tmp;
+        for (unsigned d = 0; d < bytes; ++d)
+        {
+            const unsigned shift = d * 8;
+            if (counts[d][(bits(src[0]) >> shift) & 0xFF] == n)
+            {
+                continue; // Во всех ключах этот байт одинаков
+            }
+
+            size_t offsets[256];
+            size_t sum = 0;
+            for (unsigned b = 0; b < 256; ++b)
+            {
+                offsets[b] = sum;
+                sum += counts[d][b];
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                dst[offsets[(bits(src[i]) >> shift) & 0xFF]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+        return src;
+    }
+
+    // Пара "ключ - исходная позиция" для сортировки записей по извлечённому ключу
+    template <typename Bits>
+    struct KeyIndex
+    {
+        Bits key;
+        size_t index;
+    };
+
+    // Выполняет fn(t) для t = 0..threads-1, последний кусок работы - в вызывающем потоке
+    template <typename Fn>
+    void run_parallel(size_t threads, Fn &&fn)
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (size_t t = 1; t < threads; ++t)
+        {
+            workers.emplace_back([&fn, t]
+                                 { fn(t); });
+        }
+        fn(0);
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
+
+// Сортирует массив целых или вещественных чисел по возрастанию
+template <typename T>
+void radix_sort(DynamicArray<T> &arr)
+{
+    using namespace radix_sort_detail;
+    static_assert(is_radix_key<T>(), "radix_sort: нужен целый или вещественный тип (не bool, не long double)");
+    using Bits = KeyBits<T>;
+
+    const size_t n = arr.size();
+    if (n < 2)
+    {
+        return;
+    }
+
+    DynamicArray<T> scratch(arr.get_allocator().resource());
+    scratch.resize_uninitialized(n);
+    T *result = lsd_passes<T, Bits>(arr.data(), scratch.data(), n, sizeof(Bits), [](T value)
+                                    { return encode_key(value); });
+    if (result != arr.data())
+    {
+        std::memcpy(arr.data(), result, n * sizeof(T));
+    }
+}
+
+/**
+ * Сортирует записи по ключу key(record), например [](const Person &p) { return p.age; }.
+ * Сначала сортируются пары (ключ, позиция), затем записи переставляются:
+ * тривиально копируемые - через буфер, остальные - перемещением по циклам
+ * перестановки, без копий.
+ */
+template <typename T, typename KeyFn>
+void radix_sort(DynamicArray<T> &arr, KeyFn key)
+{
+    using namespace radix_sort_detail;
+    using Key = std::decay_t<decltype(key(std::declval<const T &>()))>;
+    static_assert(is_radix_key<Key>(), "radix_sort: ключ должен быть целым или вещественным числом");
+    using Bits = KeyBits<Key>;
+    using Pair = KeyIndex<Bits>;
+
+    const size_t n = arr.size();
+    if (n < 2)
+    {
+        return;
+    }
+    std::pmr::memory_resource *resource = arr.get_allocator().resource();
+
+    DynamicArray<Pair> pairs(resource);
+    pairs.resize_uninitialized(2 * n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        pairs[i] = Pair{encode_key(key(arr[i])), i};
+    }
+    const Pair *order = lsd_passes<Pair, Bits>(pairs.data(), pairs.data() + n, n, sizeof(Bits), [](const Pair &pair)
+                                               { return pair.key; });
+
+    if constexpr (std::is_trivially_copyable<T>::value && std::is_trivially_default_constructible<T>::value)
+    {
+        DynamicArray<T> sorted(resource);
+        sorted.resize_uninitialized(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            sorted[i] = arr[order[i].index];
+        }
+        std::memcpy(static_cast<void *>(arr.data()), sorted.data(), n * sizeof(T));
+    }
+    else
+    {
+        // order[i].index - откуда взять элемент для позиции i; пройденные позиции помечаются index = i
+        Pair *perm = const_cast<Pair *>(order);
+        for (size_t start = 0; start < n; ++start)
+        {
+            if (perm[start].index == start)
+            {
+                continue;
+            }
+            T saved = std::move(arr[start]);
+            size_t pos = start;
+            for (;;)
+            {
+                const size_t from = perm[pos].index;
+                perm[pos].index = pos;
+                if (from == start)
+                {
+                    arr[pos] = std::move(saved);
+                    break;
+                }
+                arr[pos] = std::move(arr[from]);
+                pos = from;
+            }
+        }
+    }
+}
+
+/**
+ * Многопоточная MSD-сортировка для больших массивов чисел: старший байт
+ * раскладывается параллельно (каждый поток считает гистограмму своей части
+ * и пишет в свои диапазоны корзин), затем 256 корзин независимо сортируются
+ * LSD-проходами по остальным байтам; потоки разбирают корзины от крупных к мелким.
+ * threads = 0 - по числу ядер. Массивы меньше kParallelRadixThreshold
+ * сортируются однопоточным radix_sort.
+ */
+constexpr size_t kParallelRadixThreshold = 1 << 16;
+
+template <typename T>
+void parallel_radix_sort(DynamicArray<T> &arr, size_t threads = 0)
+{
+    using namespace radix_sort_detail;
+    static_assert(is_radix_key<T>(), "parallel_radix_sort: нужен целый или вещественный тип (не bool, не long double)");
+    using Bits = KeyBits<T>;
+
+    const size_t n = arr.size();
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (threads == 1 || n < kParallelRadixThreshold || sizeof(T) == 1)
+    {
+        radix_sort(arr);
+        return;
+    }
+
+    DynamicArray<T> scratch(arr.get_allocator().resource());
+    scratch.resize_uninitialized(n);
+    T *data = arr.data();
+    T *tmp = scratch.data();
+    constexpr unsigned kTopShift = (sizeof(Bits) - 1) * 8;
+    auto top_digit = [](T value)
+    {
+        return static_cast<size_t>(encode_key(value) >> kTopShift);
+    };
+    auto slice_begin = [n, threads](size_t t)
+    {
+        return n / threads * t + std::min(t, n % threads);
+    };
+
+    // Гистограммы старшего байта по частям массива
+    std::vector<std::array<size_t, 256>> offsets(threads);
+    run_parallel(threads, [&](size_t t)
+                 {
+                     std::array<size_t, 256> &counts = offsets[t];
+                     counts.fill(0);
+                     for (size_t i = slice_begin(t); i < slice_begin(t + 1); ++i)
+                     {
+                         ++counts[top_digit(data[i])];
+                     } });
+
+    // Корзина b: сначала элементы потока 0, потом потока 1 и т.д.
+    size_t bucket_begin[257];
+    size_t sum = 0;
+    for (size_t b = 0; b < 256; ++b)
+    {
+        bucket_begin[b] = sum;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            const size_t count = offsets[t][b];
+            offsets[t][b] = sum;
+            sum += count;
+        }
+    }
+    bucket_begin[256] = n;
+
+    run_parallel(threads, [&](size_t t)
+                 {
+                     std::array<size_t, 256> &next = offsets[t];
+                     for (size_t i = slice_begin(t); i < slice_begin(t + 1); ++i)
+                     {
+                         tmp[next[top_digit(data[i])]++] = data[i];
+                     } });
+
+    // Корзины сортируются независимо, крупные - первыми
+    std::array<size_t, 256> buckets;
+    for (size_t b = 0; b < 256; ++b)
+    {
+        buckets[b] = b;
+    }
+    std::sort(buckets.begin(), buckets.end(), [&bucket_begin](size_t a, size_t b)
+              { return bucket_begin[a + 1] - bucket_begin[a] > bucket_begin[b + 1] - bucket_begin[b]; });
+
+    std::atomic<size_t> next_bucket{0};
+    run_parallel(threads, [&](size_t)
+                 {
+                     for (size_t i = next_bucket.fetch_add(1); i < 256; i = next_bucket.fetch_add(1))
+                     {
+                         const size_t begin = bucket_begin[buckets[i]];
+                         const size_t count = bucket_begin[buckets[i] + 1] - begin;
+                         if (count == 0)
+                         {
+                             continue;
+                         }
+                         T *result = lsd_passes<T, Bits>(tmp + begin, data + begin, count, sizeof(Bits) - 1, [](T value)
+                                                         { return encode_key(value); });
+                         if (result != data + begin)
+                         {
+                             std::memcpy(data + begin, result, count * sizeof(T));
+                         }
+                     } });
+}
+
+#endif // RADIX_SORT_H
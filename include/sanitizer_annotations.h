@@ -0,0 +1,129 @@
+#ifndef SANITIZER_ANNOTATIONS_H
+#define SANITIZER_ANNOTATIONS_H
+
+#include <cstddef>
+
+// Определяем, под каким инструментом собран код
+#if defined(__SANITIZE_ADDRESS__)
+#define LAB5_ASAN 1
+#endif
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#ifndef LAB5_ASAN
+#define LAB5_ASAN 1
+#endif
+#endif
+#if __has_feature(memory_sanitizer)
+#define LAB5_MSAN 1
+#endif
+#endif
+
+#ifndef LAB5_ASAN
+#define LAB5_ASAN 0
+#endif
+#ifndef LAB5_MSAN
+#define LAB5_MSAN 0
+#endif
+
+#if LAB5_ASAN
+#include <sanitizer/asan_interface.h>
+#endif
+#if LAB5_MSAN
+#include <sanitizer/msan_interface.h>
+#endif
+
+// Клиентские запросы Valgrind включаются явно (-DLAB5_VALGRIND=ON) и только при наличии заголовка
+#if defined(LAB5_VALGRIND) && defined(__has_include)
+#if __has_include(<valgrind/memcheck.h>)
+#include <valgrind/memcheck.h>
+#define LAB5_HAS_VALGRIND 1
+#endif
+#endif
+#ifndef LAB5_HAS_VALGRIND
+#define LAB5_HAS_VALGRIND 0
+#endif
+
+/**
+ * Разметка памяти для ASan, MSan и Valgrind memcheck.
+ *
+ * Ресурсы, которые кэшируют освобождённые блоки (CustomMemoryResource,
+ * ThreadCacheResource), сообщают инструментам о смене состояния блока:
+ * освобождённый блок недоступен, повторно выданный - доступен, но не
+ * инициализирован. Без разметки инструменты видят блок живым всё время
+ * и пропускают use-after-free на переиспользованных блоках.
+ *
+ * В обычной сборке все функции пустые и полностью убираются компилятором.
+ */
+class SanitizerAnnotations
+{
+public:
+    static constexpr bool enabled() { return LAB5_ASAN || LAB5_MSAN || LAB5_HAS_VALGRIND; }
+
+    // Память недоступна: любое обращение - ошибка (у MSan - неинициализирована)
+    static void poison(const void *ptr, size_t size)
+    {
+        if (!ptr || size == 0)
+        {
+            return;
+        }
+#if LAB5_ASAN
+        ASAN_POISON_MEMORY_REGION(ptr, size);
+#endif
+#if LAB5_MSAN
+        __msan_poison(ptr, size);
+#endif
+#if LAB5_HAS_VALGRIND
+        VALGRIND_MAKE_MEM_NOACCESS(ptr, size);
+#endif
+    }
+
+    // Память доступна, но её содержимое не определено (как после malloc)
+    static void mark_uninitialized(const void *ptr, size_t size)
+    {
+        if (!ptr || size == 0)
+        {
+            return;
+        }
+#if LAB5_ASAN
+        ASAN_UNPOISON_MEMORY_REGION(ptr, size);
+#endif
+#if LAB5_MSAN
+        __msan_allocated_memory(ptr, size);
+#endif
+#if LAB5_HAS_VALGRIND
+        VALGRIND_MAKE_MEM_UNDEFINED(ptr, size);
+#endif
+    }
+
+    // Память доступна и инициализирована (для служебного чтения самим ресурсом)
+    static void mark_defined(const void *ptr, size_t size)
+    {
+        if (!ptr || size == 0)
+        {
+            return;
+        }
+#if LAB5_ASAN
+        ASAN_UNPOISON_MEMORY_REGION(ptr, size);
+#endif
+#if LAB5_MSAN
+        __msan_unpoison(ptr, size);
+#endif
+#if LAB5_HAS_VALGRIND
+        VALGRIND_MAKE_MEM_DEFINED(ptr, size);
+#endif
+    }
+
+    // Отравлен ли байт по адресу ptr (только под ASan, иначе всегда false)
+    static bool is_poisoned(const void *ptr)
+    {
+#if LAB5_ASAN
+        return __asan_address_is_poisoned(ptr) != 0;
+#else
+        (void)ptr;
+        return false;
+#endif
+    }
+};
+
+#endif // SANITIZER_ANNOTATIONS_H
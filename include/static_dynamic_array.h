@@ -0,0 +1,176 @@
+#ifndef STATIC_DYNAMIC_ARRAY_H
+#define STATIC_DYNAMIC_ARRAY_H
+
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "dynamic_array.h"
+
+/**
+ * Массив фиксированной ёмкости N с хранением внутри объекта.
+ *
+ * В отличие от DynamicArray не использует аллокатор и memory_resource:
+ * все N элементов лежат во встроенном массиве, поэтому контейнер можно
+ * создавать и заполнять в constexpr-контексте (таблицы, вычисленные при
+ * компиляции). Итераторы те же, что у DynamicArray<T>.
+ *
+ * Ограничение C++17: ячейки за пределами size() тоже хранят объекты
+ * (созданные конструктором по умолчанию), поэтому T должен быть
+ * конструируемым по умолчанию. pop_back/clear сбрасывают ячейку в T{}.
+ */
+template <typename T, size_t N>
+class StaticDynamicArray
+{
+    static_assert(std::is_default_constructible<T>::value,
+                  "StaticDynamicArray: T должен иметь конструктор по умолчанию");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+    using iterator = typename DynamicArray<T>::Iterator;
+    using const_iterator = typename DynamicArray<T>::ConstIterator;
+
+    // Конструкторы
+    constexpr StaticDynamicArray() = default;
+
+    constexpr StaticDynamicArray(std::initializer_list<T> init)
+    {
+        if (init.size() > N)
+        {
+            throw std::length_error("StaticDynamicArray: слишком много элементов");
+        }
+        for (const T &value : init)
+        {
+            data_[size_++] = value;
+        }
+    }
+
+    constexpr StaticDynamicArray(size_type count, const T &value)
+    {
+        resize(count, value);
+    }
+
+    // Итераторы
+    constexpr iterator begin() { return iterator(data_); }
+    constexpr iterator end() { return iterator(data_ + size_); }
+    constexpr const_iterator begin() const { return const_iterator(data_); }
+    constexpr const_iterator end() const { return const_iterator(data_ + size_); }
+    constexpr const_iterator cbegin() const { return const_iterator(data_); }
+    constexpr const_iterator cend() const { return const_iterator(data_ + size_); }
+
+    // Доступ к элементам
+    constexpr reference operator[](size_type index) { return data_[index]; }
+    constexpr const_reference operator[](size_type index) const { return data_[index]; }
+
+    constexpr reference at(size_type index)
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("StaticDynamicArray::at: индекс вне диапазона");
+        }
+        return data_[index];
+    }
+
+    constexpr const_reference at(size_type index) const
+    {
+        if (index >= size_)
+        {
+            throw std::out_of_range("StaticDynamicArray::at: индекс вне диапазона");
+        }
+        return data_[index];
+    }
+
+    constexpr reference front() { return data_[0]; }
+    constexpr const_reference front() const { return data_[0]; }
+    constexpr reference back() { return data_[size_ - 1]; }
+    constexpr const_reference back() const { return data_[size_ - 1]; }
+
+    constexpr pointer data() { return data_; }
+    constexpr const_pointer data() const { return data_; }
+
+    // Размер и емкость
+    constexpr size_type size() const { return size_; }
+    static constexpr size_type capacity() { return N; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr bool full() const { return size_ == N; }
+
+    // Модификаторы
+    constexpr void push_back(const T &value)
+    {
+        check_not_full();
+        data_[size_++] = value;
+    }
+
+    constexpr void push_back(T &&value)
+    {
+        check_not_full();
+        data_[size_++] = std::move(value);
+    }
+
+    template <typename... Args>
+    constexpr reference emplace_back(Args &&...args)
+    {
+        check_not_full();
+        data_[size_] = T(std::forward<Args>(args)...);
+        return data_[size_++];
+    }
+
+    constexpr void pop_back()
+    {
+        if (size_ > 0)
+        {
+            data_[--size_] = T{};
+        }
+    }
+
+    constexpr void clear()
+    {
+        while (size_ > 0)
+        {
+            data_[--size_] = T{};
+        }
+    }
+
+    constexpr void resize(size_type new_size)
+    {
+        resize(new_size, T{});
+    }
+
+    constexpr void resize(size_type new_size, const T &value)
+    {
+        if (new_size > N)
+        {
+            throw std::length_error("StaticDynamicArray::resize: превышена ёмкость");
+        }
+        while (size_ < new_size)
+        {
+            data_[size_++] = value;
+        }
+        while (size_ > new_size)
+        {
+            data_[--size_] = T{};
+        }
+    }
+
+private:
+    constexpr void check_not_full() const
+    {
+        if (size_ == N)
+        {
+            throw std::length_error("StaticDynamicArray::push_back: превышена ёмкость");
+        }
+    }
+
+    // Встроенное хранилище; при N == 0 держим одну ячейку, чтобы массив был корректным
+    T data_[N == 0 ? 1 : N]{};
+    size_type size_{0};
+};
+
+#endif // STATIC_DYNAMIC_ARRAY_H
@@ -0,0 +1,571 @@
+#ifndef STREAMING_LOADER_H
+#define STREAMING_LOADER_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "dynamic_array.h"
+#include "dynamic_array_io.h"
+
+#if LAB5_HAS_POSIX_IO
+#include <cerrno>
+#endif
+
+/**
+ * Конвейерная загрузка файлов в DynamicArray: куски файла фиксированного
+ * размера читаются пулом потоков ввода-вывода (pread), разбираются пулом
+ * рабочих потоков, и готовые пакеты по порядку дописываются в массив.
+ * Чтение следующих кусков идёт одновременно с разбором предыдущих.
+ *
+ * Все выделения памяти (буферы чтения, пакеты, сам массив) делает вызывающий
+ * поток, поэтому подходит и несинхронизированный ресурс вроде CustomMemoryResource.
+ */
+struct StreamingLoadOptions
+{
+    size_t chunk_size{1 << 20};          // Размер куска чтения; округляется вверх до 4 КБ
+    size_t io_threads{2};                // Потоков чтения
+    size_t parse_threads{0};             // Потоков разбора; 0 - по числу ядер
+    size_t max_chunks_in_flight{8};      // Сколько кусков одновременно держится в памяти
+    std::pmr::memory_resource *buffer_resource{nullptr}; // Буферы чтения; nullptr - ресурс массива
+};
+
+struct StreamingLoadStats
+{
+    size_t chunks{0};
+    size_t bytes_read{0};
+    size_t elements{0};
+    size_t skipped_lines{0}; // Строки, для которых разбор вернул false
+    double seconds{0};
+};
+
+namespace streaming_loader_detail
+{
+    constexpr size_t kChunkGranularity = 4096;
+
+    inline size_t chunk_bytes(size_t requested)
+    {
+        const size_t size = std::max(requested, kChunkGranularity);
+        return (size + kChunkGranularity - 1) / kChunkGranularity * kChunkGranularity;
+    }
+
+    // Простой пул потоков; задачи не должны бросать исключения
+    class WorkerPool
+    {
+    public:
+        explicit WorkerPool(size_t threads)
+        {
+            threads = std::max<size_t>(threads, 1);
+            for (size_t i = 0; i < threads; ++i)
+            {
+                workers_.emplace_back([this]
+                                      { run(); });
+            }
+        }
+
+        // Дожидается выполнения всех поставленных задач
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for (std::thread &worker : workers_)
+            {
+                worker.join();
+            }
+        }
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        void submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.push_back(std::move(task));
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        void run()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this]
+                             { return stop_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread> workers_;
+        std::deque<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stop_{false};
+    };
+
+    /**
+     * Завершение задач конвейера: задача под общим мьютексом поднимает свой
+     * флаг готовности, первая ошибка сохраняется и пробрасывается вызывающему потоку.
+     */
+    class PipelineEvents
+    {
+    public:
+        template <typename Fn>
+        std::function<void()> task(bool &done_flag, Fn fn)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++pending_;
+            }
+            return [this, &done_flag, fn]() mutable
+            {
+                std::exception_ptr error;
+                try
+                {
+                    fn();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (error && !error_)
+                    {
+                        error_ = error;
+                    }
+                    done_flag = true;
+                    --pending_;
+                }
+                cv_.notify_all();
+            };
+        }
+
+        // Ждёт, пока ready() не станет истинным или не случится ошибка; false при ошибке
+        template <typename Ready>
+        bool wait(Ready ready)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&]
+                     { return error_ || ready(); });
+            return !error_;
+        }
+
+        // Дожидается завершения всех задач и пробрасывает ошибку, если она была
+        void drain_and_rethrow()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]
+                     { return pending_ == 0; });
+            if (error_)
+            {
+                std::rethrow_exception(error_);
+            }
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        size_t pending_{0};
+        std::exception_ptr error_;
+    };
+
+    // Файл только для чтения с позиционным чтением из нескольких потоков
+    class InputFile
+    {
+    public:
+        explicit InputFile(const std::string &path) : path_(path)
+        {
+#if LAB5_HAS_POSIX_IO
+            fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat st;
+            if (fd_ < 0 || ::fstat(fd_, &st) != 0)
+            {
+                if (fd_ >= 0)
+                {
+                    ::close(fd_);
+                }
+                throw std::runtime_error("StreamingLoader: не удалось открыть " + path);
+            }
+            size_ = static_cast<uint64_t>(st.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+            ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                throw std::runtime_error("StreamingLoader: не удалось открыть " + path);
+            }
+            size_ = static_cast<uint64_t>(file.tellg());
+#endif
+        }
+
+        ~InputFile()
+        {
+#if LAB5_HAS_POSIX_IO
+            ::close(fd_);
+#endif
+        }
+
+        InputFile(const InputFile &) = delete;
+        InputFile &operator=(const InputFile &) = delete;
+
+        uint64_t size() const { return size_; }
+
+        // Читает ровно bytes байт со смещения offset
+        void read_at(void *dst, size_t bytes, uint64_t offset) const
+        {
+#if LAB5_HAS_POSIX_IO
+            char *cur = static_cast<char *>(dst);
+            while (bytes > 0)
+            {
+                const ssize_t got = ::pread(fd_, cur, bytes, static_cast<off_t>(offset));
+                if (got < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (got < 0)
+                {
+                    throw std::runtime_error("StreamingLoader: ошибка чтения " + path_);
+                }
+                if (got == 0)
+                {
+                    throw std::runtime_error("StreamingLoader: файл обрезан " + path_);
+                }
+                cur += got;
+                bytes -= static_cast<size_t>(got);
+                offset += static_cast<uint64_t>(got);
+            }
+#else
+            std::ifstream file(path_, std::ios::binary);
+            file.seekg(static_cast<std::streamoff>(offset));
+            if (!file.read(static_cast<char *>(dst), static_cast<std::streamsize>(bytes)))
+            {
+                throw std::runtime_error("StreamingLoader: ошибка чтения " + path_);
+            }
+#endif
+        }
+
+    private:
+        std::string path_;
+        uint64_t size_{0};
+#if LAB5_HAS_POSIX_IO
+        int fd_{-1};
+#endif
+    };
+
+    inline std::string_view trim_line(const char *begin, const char *end)
+    {
+        if (end > begin && end[-1] == '\r')
+        {
+            --end;
+        }
+        return std::string_view(begin, static_cast<size_t>(end - begin));
+    }
+
+    // Переносит пакет в конец массива; память растёт геометрически
+    template <typename T>
+    void append_batch(DynamicArray<T> &out, DynamicArray<T> &batch)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value && std::is_trivially_default_constructible<T>::value &&
+                      std::is_trivially_destructible<T>::value)
+        {
+            out.append_with(batch.size(), [&batch](T *tail, size_t count)
+                            { std::memcpy(static_cast<void *>(tail), batch.data(), count * sizeof(T)); });
+        }
+        else
+        {
+            if (out.size() + batch.size() > out.capacity())
+            {
+                out.reserve(std::max(out.capacity() * 2, out.size() + batch.size()));
+            }
+            for (T &value : batch)
+            {
+                out.push_back(std::move(value));
+            }
+        }
+    }
+}
+
+/**
+ * Загружает текстовый файл построчно: parse(std::string_view line, T &value)
+ * вызывается для каждой строки (без '\n' и '\r') в рабочих потоках и возвращает
+ * false, если строку нужно пропустить. Элементы дописываются в out в порядке строк.
+ *
+ * parse должен быть потокобезопасным. T не должен выделять память из ресурса
+ * массива (как std::pmr::string): элементы создаются в рабочих потоках.
+ */
+template <typename T, typename Parse>
+StreamingLoadStats load_lines_streaming(const std::string &path, DynamicArray<T> &out, Parse &&parse,
+                                        const StreamingLoadOptions &options = StreamingLoadOptions())
+{
+    static_assert(!std::uses_allocator<T, std::pmr::polymorphic_allocator<T>>::value,
+                  "load_lines_streaming: элементы не должны выделять память из ресурса массива");
+    using namespace streaming_loader_detail;
+
+    struct Chunk
+    {
+        Chunk(std::pmr::memory_resource *mr, size_t bytes)
+            : resource(mr), data(static_cast<char *>(mr->allocate(bytes, alignof(std::max_align_t)))),
+              size(bytes), prefix(mr), batch(mr) {}
+
+        ~Chunk()
+        {
+            resource->deallocate(data, size, alignof(std::max_align_t));
+        }
+
+        std::pmr::memory_resource *resource;
+        char *data{nullptr};
+        size_t size{0};
+        size_t newlines{0};
+        bool read{false};
+        bool parsed{false};
+        std::pmr::string prefix; // Строка, начатая в предыдущих кусках и законченная в этом
+        const char *body_begin{nullptr};
+        const char *body_end{nullptr};
+        DynamicArray<T> batch;
+        size_t skipped{0};
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    InputFile file(path);
+    std::pmr::memory_resource *resource = options.buffer_resource ? options.buffer_resource : out.get_allocator().resource();
+    const size_t chunk_size = chunk_bytes(options.chunk_size);
+    const size_t chunks_count = static_cast<size_t>((file.size() + chunk_size - 1) / chunk_size);
+    const size_t max_in_flight = std::max<size_t>(options.max_chunks_in_flight, 1);
+    const size_t parse_threads = options.parse_threads > 0 ? options.parse_threads
+                                                           : std::max(1u, std::thread::hardware_concurrency());
+
+    StreamingLoadStats stats;
+    stats.chunks = chunks_count;
+    std::vector<std::unique_ptr<Chunk>> chunks(chunks_count);
+    std::pmr::string carry(resource); // Незаконченная строка в конце последнего разобранного куска
+    PipelineEvents events;
+
+    {
+        WorkerPool io_pool(options.io_threads);
+        WorkerPool parse_pool(parse_threads);
+        size_t next_read = 0;
+        size_t next_dispatch = 0;
+        size_t next_append = 0;
+
+        while (next_append < chunks_count)
+        {
+            while (next_read < chunks_count && next_read - next_append < max_in_flight)
+            {
+                const uint64_t offset = static_cast<uint64_t>(next_read) * chunk_size;
+                auto chunk = std::make_unique<Chunk>(resource, static_cast<size_t>(std::min<uint64_t>(chunk_size, file.size() - offset)));
+                Chunk *raw = chunk.get();
+                chunks[next_read++] = std::move(chunk);
+                io_pool.submit(events.task(raw->read, [raw, offset, &file]
+                                           {
+                                               file.read_at(raw->data, raw->size, offset);
+                                               raw->newlines = static_cast<size_t>(std::count(raw->data, raw->data + raw->size, '\n')); }));
+            }
+
+            bool can_dispatch = false;
+            bool can_append = false;
+            if (!events.wait([&]
+                             {
+                                 can_dispatch = next_dispatch < next_read && chunks[next_dispatch]->read;
+                                 can_append = next_append < next_dispatch && chunks[next_append]->parsed;
+                                 return can_dispatch || can_append; }))
+            {
+                break;
+            }
+
+            if (can_dispatch)
+            {
+                // Склейка на границе: первая строка куска дописывается к хвосту предыдущего
+                Chunk &chunk = *chunks[next_dispatch++];
+                const char *begin = chunk.data;
+                const char *end = chunk.data + chunk.size;
+                if (chunk.newlines == 0)
+                {
+                    carry.append(begin, end);
+                    chunk.parsed = true;
+                }
+                else
+                {
+                    const char *first = static_cast<const char *>(std::memchr(begin, '\n', chunk.size));
+                    const char *last = end - 1;
+                    while (*last != '\n')
+                    {
+                        --last;
+                    }
+                    chunk.prefix = std::move(carry);
+                    chunk.prefix.append(begin, first);
+                    chunk.body_begin = first + 1;
+                    chunk.body_end = last + 1;
+                    carry = std::pmr::string(last + 1, end, resource);
+                    chunk.batch.reserve(chunk.newlines);
+
+                    Chunk *raw = &chunk;
+                    parse_pool.submit(events.task(raw->parsed, [raw, &parse]
+                                                  {
+                                                      auto emit = [raw, &parse](std::string_view line)
+                                                      {
+                                                          T value{};
+                                                          if (parse(line, value))
+                                                          {
+                                                              raw->batch.push_back(std::move(value));
+                                                          }
+                                                          else
+                                                          {
+                                                              ++raw->skipped;
+                                                          }
+                                                      };
+                                                      emit(trim_line(raw->prefix.data(), raw->prefix.data() + raw->prefix.size()));
+                                                      for (const char *line = raw->body_begin; line < raw->body_end;)
+                                                      {
+                                                          const char *eol = static_cast<const char *>(
+                                                              std::memchr(line, '\n', static_cast<size_t>(raw->body_end - line)));
+                                                          emit(trim_line(line, eol));
+                                                          line = eol + 1;
+                                                      } }));
+                }
+            }
+
+            if (can_append)
+            {
+                Chunk &chunk = *chunks[next_append];
+                append_batch(out, chunk.batch);
+                stats.elements += chunk.batch.size();
+                stats.skipped_lines += chunk.skipped;
+                stats.bytes_read += chunk.size;
+                chunks[next_append++].reset();
+            }
+        }
+    }
+
+    // Пулы уже остановлены, поэтому буферы, оставшиеся после ошибки, можно освобождать
+    chunks.clear();
+    events.drain_and_rethrow();
+
+    // Последняя строка без завершающего '\n'
+    if (!carry.empty())
+    {
+        T value{};
+        if (parse(trim_line(carry.data(), carry.data() + carry.size()), value))
+        {
+            out.push_back(std::move(value));
+            ++stats.elements;
+        }
+        else
+        {
+            ++stats.skipped_lines;
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+/**
+ * Загружает файл, сохранённый save_array, заменяя содержимое out. Куски payload
+ * читаются параллельно прямо в буфер массива; контрольная сумма считается по
+ * готовым кускам по порядку, пока читаются следующие.
+ */
+template <typename T>
+StreamingLoadStats load_array_streaming(const std::string &path, DynamicArray<T> &out,
+                                        const StreamingLoadOptions &options = StreamingLoadOptions())
+{
+    static_assert(dynamic_array_io_detail::use_raw_payload<T>(),
+                  "load_array_streaming: поддерживаются только тривиально копируемые T без ElementCodec");
+    using namespace streaming_loader_detail;
+
+    const auto start = std::chrono::steady_clock::now();
+    InputFile file(path);
+    ArrayFileHeader header{};
+    if (file.size() < sizeof(header))
+    {
+        throw std::runtime_error("load_array: файл обрезан");
+    }
+    file.read_at(&header, sizeof(header), 0);
+    dynamic_array_io_detail::validate_header<T>(header, file.size());
+
+    out.clear();
+    out.resize_default_init(static_cast<size_t>(header.count));
+    char *payload = reinterpret_cast<char *>(out.data());
+    const size_t payload_bytes = static_cast<size_t>(header.payload_bytes);
+    const size_t chunk_size = chunk_bytes(options.chunk_size);
+    const size_t chunks_count = (payload_bytes + chunk_size - 1) / chunk_size;
+
+    StreamingLoadStats stats;
+    stats.chunks = chunks_count;
+    std::unique_ptr<bool[]> done(new bool[chunks_count]());
+    ArrayChecksum checksum(payload_bytes);
+    PipelineEvents events;
+
+    {
+        WorkerPool io_pool(options.io_threads);
+        for (size_t i = 0; i < chunks_count; ++i)
+        {
+            const size_t offset = i * chunk_size;
+            const size_t bytes = std::min(chunk_size, payload_bytes - offset);
+            io_pool.submit(events.task(done[i], [payload, offset, bytes, &file, &header]
+                                       { file.read_at(payload + offset, bytes, header.payload_offset + offset); }));
+        }
+
+        for (size_t i = 0; i < chunks_count; ++i)
+        {
+            if (!events.wait([&]
+                             { return done[i]; }))
+            {
+                break;
+            }
+            const size_t offset = i * chunk_size;
+            const size_t bytes = std::min(chunk_size, payload_bytes - offset);
+            checksum.update(payload + offset, bytes);
+            stats.bytes_read += bytes;
+        }
+    }
+
+    try
+    {
+        events.drain_and_rethrow();
+    }
+    catch (...)
+    {
+        out.clear();
+        throw;
+    }
+    if (checksum.finish() != header.checksum)
+    {
+        out.clear();
+        throw std::runtime_error("load_array: контрольная сумма не совпадает");
+    }
+
+    stats.elements = out.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+#endif // STREAMING_LOADER_H
@@ -0,0 +1,245 @@
+#ifndef THREAD_CACHE_RESOURCE_H
+#define THREAD_CACHE_RESOURCE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "custom_memory_resource.h"
+#include "sanitizer_annotations.h"
+#include "thread_slot_registry.h"
+
+// Статистика кэша одного потока
+struct ThreadCacheStats
+{
+    std::thread::id thread;
+    size_t hits{0};   // Запросы, обслуженные из кэша потока
+    size_t misses{0}; // Запросы, потребовавшие обращения к upstream
+
+    double hit_rate() const
+    {
+        size_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+/**
+ * Потоковый кэш перед upstream-ресурсом (в духе tcmalloc).
+ *
+ * Мелкие запросы (до kMaxCachedSize байт) округляются до класса размера -
+ * степени двойки - и обслуживаются из "магазина" текущего потока: массива
+ * свободных блоков этого класса. Пустой магазин пополняется, а переполненный
+ * сбрасывается пачками по kBatchSize блоков под одним захватом мьютекса
+ * upstream. Для CustomMemoryResource используются allocate_batch/deallocate_batch.
+ *
+ * Быстрый путь не содержит атомарных read-modify-write операций и блокировок.
+ * Блок можно освободить в любом потоке: он попадёт в магазин освобождающего
+ * потока, так как все блоки одного класса взаимозаменяемы.
+ * Кэш завершившегося потока передаётся следующему новому потоку.
+ */
+class ThreadCacheResource : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t kMinClassSize = 16;
+    static constexpr size_t kMaxCachedSize = 4096;
+    static constexpr size_t kClassCount = 9; // 16, 32, ..., 4096
+    static constexpr size_t kMagazineSize = 64;
+    static constexpr size_t kBatchSize = kMagazineSize / 2;
+    static constexpr size_t kClassAlignment = alignof(std::max_align_t);
+
+    explicit ThreadCacheResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : upstream_(upstream),
+          custom_upstream_(dynamic_cast<CustomMemoryResource *>(upstream)) {}
+
+    ~ThreadCacheResource() override
+    {
+        std::lock_guard<std::mutex> lock(upstream_mutex_);
+        caches_.for_each([this](ThreadCache &cache, std::thread::id)
+                         {
+                             for (size_t cls = 0; cls < kClassCount; ++cls)
+                             {
+                                 Magazine &magazine = cache.magazines[cls];
+                                 release_to_upstream(cls, magazine.blocks, magazine.count);
+                                 magazine.count = 0;
+                             }
+                         });
+    }
+
+    ThreadCacheResource(const ThreadCacheResource &) = delete;
+    ThreadCacheResource &operator=(const ThreadCacheResource &) = delete;
+
+    std::pmr::memory_resource *upstream_resource() const { return upstream_; }
+
+    // Статистика по каждому потоку, когда-либо обращавшемуся к ресурсу
+    std::vector<ThreadCacheStats> get_thread_stats() const
+    {
+        std::vector<ThreadCacheStats> stats;
+        caches_.for_each([&stats](const ThreadCache &cache, std::thread::id owner)
+                         {
+                             ThreadCacheStats entry;
+                             entry.thread = owner;
+                             entry.hits = cache.hits.load(std::memory_order_relaxed);
+                             entry.misses = cache.misses.load(std::memory_order_relaxed);
+                             stats.push_back(entry);
+                         });
+        return stats;
+    }
+
+    // Суммарная статистика по всем потокам
+    ThreadCacheStats get_total_stats() const
+    {
+        ThreadCacheStats total;
+        for (const auto &entry : get_thread_stats())
+        {
+            total.hits += entry.hits;
+            total.misses += entry.misses;
+        }
+        return total;
+    }
+
+protected:
+    LAB5_NOINLINE void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (bytes > kMaxCachedSize || alignment > kClassAlignment)
+        {
+            AllocationCallSite::Scope call_site(LAB5_RETURN_ADDRESS());
+            std::lock_guard<std::mutex> lock(upstream_mutex_);
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        const size_t cls = size_class(bytes);
+        ThreadCache &cache = caches_.local();
+        Magazine &magazine = cache.magazines[cls];
+
+        if (magazine.count != 0)
+        {
+            bump(cache.hits);
+            void *ptr = magazine.blocks[--magazine.count];
+            SanitizerAnnotations::mark_uninitialized(ptr, bytes);
+            return ptr;
+        }
+
+        bump(cache.misses);
+        // Наблюдатели upstream видят стек до кода, вызвавшего кэш
+        AllocationCallSite::Scope call_site(LAB5_RETURN_ADDRESS());
+        refill(cls, magazine);
+        return magazine.blocks[--magazine.count];
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        if (bytes > kMaxCachedSize || alignment > kClassAlignment)
+        {
+            std::lock_guard<std::mutex> lock(upstream_mutex_);
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
+        }
+
+        const size_t cls = size_class(bytes);
+        Magazine &magazine = caches_.local().magazines[cls];
+
+        if (magazine.count == kMagazineSize)
+        {
+            flush(cls, magazine);
+        }
+        // Блок в магазине для санитайзеров недоступен, как освобождённый
+        SanitizerAnnotations::poison(ptr, class_size(cls));
+        magazine.blocks[magazine.count++] = ptr;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    struct Magazine
+    {
+        void *blocks[kMagazineSize];
+        size_t count{0};
+    };
+
+    struct ThreadCache
+    {
+        Magazine magazines[kClassCount];
+        // Пишет только поток-владелец (load + store без RMW), читает get_thread_stats
+        std::atomic<size_t> hits{0};
+        std::atomic<size_t> misses{0};
+    };
+
+    static void bump(std::atomic<size_t> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    static size_t size_class(size_t bytes)
+    {
+        size_t cls = 0;
+        size_t size = kMinClassSize;
+        while (size < bytes)
+        {
+            size <<= 1;
+            ++cls;
+        }
+        return cls;
+    }
+
+    static size_t class_size(size_t cls) { return kMinClassSize << cls; }
+
+    // Пополняет пустой магазин пачкой из kBatchSize блоков
+    void refill(size_t cls, Magazine &magazine)
+    {
+        const size_t size = class_size(cls);
+        std::lock_guard<std::mutex> lock(upstream_mutex_);
+        if (custom_upstream_)
+        {
+            custom_upstream_->allocate_batch(kBatchSize, size, kClassAlignment, magazine.blocks);
+        }
+        else
+        {
+            for (size_t i = 0; i < kBatchSize; ++i)
+            {
+                magazine.blocks[i] = upstream_->allocate(size, kClassAlignment);
+            }
+        }
+        magazine.count = kBatchSize;
+    }
+
+    // Возвращает в upstream старшую половину переполненного магазина
+    void flush(size_t cls, Magazine &magazine)
+    {
+        std::lock_guard<std::mutex> lock(upstream_mutex_);
+        release_to_upstream(cls, magazine.blocks + kBatchSize, kMagazineSize - kBatchSize);
+        magazine.count = kBatchSize;
+    }
+
+    // Вызывается под upstream_mutex_
+    void release_to_upstream(size_t cls, void *const *blocks, size_t count)
+    {
+        const size_t size = class_size(cls);
+        for (size_t i = 0; i < count; ++i)
+        {
+            // upstream может выдать блок дальше без своей разметки
+            SanitizerAnnotations::mark_defined(blocks[i], size);
+        }
+        if (custom_upstream_)
+        {
+            custom_upstream_->deallocate_batch(blocks, count, size, kClassAlignment);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            upstream_->deallocate(blocks[i], size, kClassAlignment);
+        }
+    }
+
+    std::pmr::memory_resource *upstream_;
+    CustomMemoryResource *custom_upstream_;
+
+    std::mutex upstream_mutex_;
+    ThreadSlotRegistry<ThreadCache> caches_;
+};
+
+#endif // THREAD_CACHE_RESOURCE_H
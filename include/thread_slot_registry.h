@@ -0,0 +1,199 @@
+#ifndef THREAD_SLOT_REGISTRY_H
+#define THREAD_SLOT_REGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace thread_slot_detail
+{
+    // Идентификаторы живых реестров: по ним завершающийся поток понимает,
+    // можно ли ещё трогать свои слоты
+    inline std::mutex &registry_mutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    inline std::unordered_set<uint64_t> &live_ids()
+    {
+        static std::unordered_set<uint64_t> ids;
+        return ids;
+    }
+
+    inline uint64_t next_id()
+    {
+        static std::atomic<uint64_t> counter{1};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Реестр "по одному слоту Slot на поток" для объекта-владельца
+ * (ThreadCacheResource, EpochDomain).
+ *
+ * local() возвращает слот текущего потока; повторный вызов из того же потока
+ * стоит одно сравнение с thread_local кэшем. Слоты принадлежат реестру и живут
+ * до его уничтожения. Слот завершившегося потока помечается брошенным и
+ * отдаётся следующему потоку, впервые обратившемуся к реестру.
+ */
+template <typename Slot>
+class ThreadSlotRegistry
+{
+public:
+    ThreadSlotRegistry() : id_(thread_slot_detail::next_id())
+    {
+        std::lock_guard<std::mutex> lock(thread_slot_detail::registry_mutex());
+        thread_slot_detail::live_ids().insert(id_);
+    }
+
+    ~ThreadSlotRegistry()
+    {
+        // После этого завершающиеся потоки больше не трогают наши слоты
+        std::lock_guard<std::mutex> lock(thread_slot_detail::registry_mutex());
+        thread_slot_detail::live_ids().erase(id_);
+    }
+
+    ThreadSlotRegistry(const ThreadSlotRegistry &) = delete;
+    ThreadSlotRegistry &operator=(const ThreadSlotRegistry &) = delete;
+
+    Slot &local()
+    {
+        TlsSlots &slots = tls();
+        if (slots.last_id == id_)
+        {
+            return *slots.last_slot;
+        }
+        return find_or_create(slots);
+    }
+
+    // Обходит все слоты: f(Slot &, std::thread::id владельца)
+    template <typename F>
+    void for_each(F &&f)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &entry : entries_)
+        {
+            f(entry->slot, entry->owner);
+        }
+    }
+
+    template <typename F>
+    void for_each(F &&f) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &entry : entries_)
+        {
+            f(static_cast<const Slot &>(entry->slot), entry->owner);
+        }
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+private:
+    struct Entry
+    {
+        Slot slot;
+        std::thread::id owner;
+        std::atomic<bool> abandoned{false};
+    };
+
+    struct TlsEntry
+    {
+        uint64_t registry_id;
+        Entry *entry;
+    };
+
+    struct TlsSlots
+    {
+        uint64_t last_id{0};
+        Slot *last_slot{nullptr};
+        std::vector<TlsEntry> entries;
+
+        // При завершении потока отдаём слоты ещё живых реестров другим потокам
+        ~TlsSlots()
+        {
+            std::lock_guard<std::mutex> lock(thread_slot_detail::registry_mutex());
+            for (const TlsEntry &tls_entry : entries)
+            {
+                if (thread_slot_detail::live_ids().count(tls_entry.registry_id) != 0)
+                {
+                    tls_entry.entry->abandoned.store(true, std::memory_order_release);
+                }
+            }
+        }
+    };
+
+    static TlsSlots &tls()
+    {
+        thread_local TlsSlots slots;
+        return slots;
+    }
+
+    Slot &find_or_create(TlsSlots &slots)
+    {
+        for (const TlsEntry &tls_entry : slots.entries)
+        {
+            if (tls_entry.registry_id == id_)
+            {
+                slots.last_id = id_;
+                slots.last_slot = &tls_entry.entry->slot;
+                return tls_entry.entry->slot;
+            }
+        }
+
+        Entry *entry = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Сначала пробуем забрать слот завершившегося потока
+            for (auto &candidate : entries_)
+            {
+                bool expected = true;
+                if (candidate->abandoned.compare_exchange_strong(expected, false, std::memory_order_acq_rel))
+                {
+                    entry = candidate.get();
+                    break;
+                }
+            }
+            if (!entry)
+            {
+                entries_.push_back(std::make_unique<Entry>());
+                entry = entries_.back().get();
+            }
+            entry->owner = std::this_thread::get_id();
+        }
+
+        {
+            // Убираем записи об уже уничтоженных реестрах
+            std::lock_guard<std::mutex> lock(thread_slot_detail::registry_mutex());
+            std::vector<TlsEntry> alive;
+            for (const TlsEntry &tls_entry : slots.entries)
+            {
+                if (thread_slot_detail::live_ids().count(tls_entry.registry_id) != 0)
+                {
+                    alive.push_back(tls_entry);
+                }
+            }
+            alive.push_back({id_, entry});
+            slots.entries.swap(alive);
+        }
+
+        slots.last_id = id_;
+        slots.last_slot = &entry->slot;
+        return entry->slot;
+    }
+
+    const uint64_t id_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+#endif // THREAD_SLOT_REGISTRY_H
@@ -0,0 +1,183 @@
+#ifndef WARM_PROFILE_H
+#define WARM_PROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Сколько блоков данного размера и выравнивания держать в ресурсе
+struct WarmProfileEntry
+{
+    size_t size;
+    size_t alignment;
+    size_t count;
+};
+
+/**
+ * Распределение размеров блоков ресурса в установившемся режиме.
+ * Снимается через CustomMemoryResource::capture_warm_profile, сохраняется
+ * в файл перед остановкой и при следующем запуске передаётся в
+ * CustomMemoryResource::prewarm, чтобы первые запросы сразу получали
+ * готовые блоки из кэша.
+ *
+ * Формат файла - текст: строка "LAB5WARM 1", затем по строке
+ * "размер выравнивание число" на каждый класс блоков.
+ */
+class WarmProfile
+{
+public:
+    static constexpr const char *kMagic = "LAB5WARM";
+    static constexpr unsigned kVersion = 1;
+
+    // Предел региона прогрева (1 ТБ): профиль больше него заведомо повреждён
+    static constexpr size_t kMaxRegionBytes = static_cast<size_t>(
+        uint64_t(1) << 40 < SIZE_MAX ? uint64_t(1) << 40 : SIZE_MAX);
+
+    /**
+     * Сдвигает конец региона total на count блоков класса (size, alignment),
+     * выравнивая начало класса. Возвращает false и не меняет total, если
+     * регион вышел бы за kMaxRegionBytes (в том числе при переполнении size_t).
+     */
+    static bool extend_region(size_t &total, size_t size, size_t alignment, size_t count)
+    {
+        if (size > kMaxRegionBytes || alignment == 0 || alignment > kMaxRegionBytes || total > kMaxRegionBytes)
+        {
+            return false;
+        }
+        const size_t stride = round_up(size != 0 ? size : 1, alignment);
+        const size_t offset = round_up(total, alignment);
+        if (offset > kMaxRegionBytes || count > (kMaxRegionBytes - offset) / stride)
+        {
+            return false;
+        }
+        total = offset + stride * count;
+        return true;
+    }
+
+    // Добавляет count блоков; одинаковые классы суммируются
+    void add(size_t size, size_t alignment, size_t count = 1)
+    {
+        if (count != 0)
+        {
+            counts_[{size, alignment}] += count;
+        }
+    }
+
+    // Классы блоков по возрастанию размера
+    std::vector<WarmProfileEntry> entries() const
+    {
+        std::vector<WarmProfileEntry> result;
+        result.reserve(counts_.size());
+        for (const auto &item : counts_)
+        {
+            result.push_back({item.first.first, item.first.second, item.second});
+        }
+        return result;
+    }
+
+    bool empty() const { return counts_.empty(); }
+
+    size_t get_blocks_count() const
+    {
+        size_t total = 0;
+        for (const auto &item : counts_)
+        {
+            total += item.second;
+        }
+        return total;
+    }
+
+    // Суммарный размер блоков без учёта выравнивания
+    size_t get_total_bytes() const
+    {
+        size_t total = 0;
+        for (const auto &item : counts_)
+        {
+            total += item.first.first * item.second;
+        }
+        return total;
+    }
+
+    void save(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("WarmProfile: не удалось открыть " + path);
+        }
+        file << kMagic << ' ' << kVersion << '\n';
+        for (const auto &item : counts_)
+        {
+            file << item.first.first << ' ' << item.first.second << ' ' << item.second << '\n';
+        }
+        if (!file.flush())
+        {
+            throw std::runtime_error("WarmProfile: ошибка записи в " + path);
+        }
+    }
+
+    static WarmProfile load(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("WarmProfile: не удалось открыть " + path);
+        }
+
+        std::string magic;
+        unsigned version = 0;
+        if (!(file >> magic >> version) || magic != kMagic)
+        {
+            throw std::runtime_error("WarmProfile: это не профиль прогрева LAB5WARM");
+        }
+        if (version != kVersion)
+        {
+            throw std::runtime_error("WarmProfile: неподдерживаемая версия профиля");
+        }
+
+        WarmProfile profile;
+        size_t total = 0;
+        std::string line;
+        std::getline(file, line);
+        while (std::getline(file, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            std::istringstream fields(line);
+            size_t size = 0;
+            size_t alignment = 0;
+            size_t count = 0;
+            std::string extra;
+            if (!(fields >> size >> alignment >> count) || (fields >> extra) ||
+                alignment == 0 || (alignment & (alignment - 1)) != 0)
+            {
+                throw std::runtime_error("WarmProfile: повреждённая строка профиля: " + line);
+            }
+            if (!extend_region(total, size, alignment, count))
+            {
+                throw std::runtime_error("WarmProfile: профиль больше допустимого региона: " + line);
+            }
+            profile.add(size, alignment, count);
+        }
+        return profile;
+    }
+
+private:
+    // alignment - степень двойки, value + alignment - 1 не переполняется (оба не больше kMaxRegionBytes)
+    static size_t round_up(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    std::map<std::pair<size_t, size_t>, size_t> counts_;
+};
+
+#endif // WARM_PROFILE_H
@@ -0,0 +1,425 @@
+// lab5_load: многопоточный генератор нагрузки на DynamicArray и memory_resource.
+//
+// Запуск: lab5_load [нагрузка] [ресурс] [потоков] [push_back_на_поток]
+//   нагрузка: append, churn, mixed, producer-consumer или all (по умолчанию all)
+//   ресурс:   custom, custom-best, thread-cache, pool, new-delete или all (по умолчанию all)
+// По умолчанию 4 потока и 200K push_back на поток.
+//
+// Для каждой пары выводятся p50/p99/p99.9/max задержек allocate, deallocate
+// и push_back в наносекундах (LatencyHistogram) и пропускная способность.
+// CustomMemoryResource не потокобезопасен, поэтому custom и custom-best
+// работают за мьютексом, а thread-cache - через ThreadCacheResource.
+// В каждое значение входит чтение часов; его стоимость выводится в начале.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include "latency_histogram.h"
+#include "thread_cache_resource.h"
+
+// Гистограммы одного рабочего потока
+struct ThreadLatencies
+{
+    LatencyHistogram allocate;
+    LatencyHistogram deallocate;
+    LatencyHistogram push_back;
+};
+
+static thread_local ThreadLatencies *tl_latencies = nullptr;
+
+static uint64_t now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+// Замеряет allocate/deallocate upstream-ресурса в гистограммы текущего потока
+class TimedResource : public std::pmr::memory_resource
+{
+public:
+    explicit TimedResource(std::pmr::memory_resource *upstream) : upstream_(upstream) {}
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        const uint64_t start = now_ns();
+        void *ptr = upstream_->allocate(bytes, alignment);
+        if (tl_latencies)
+        {
+            tl_latencies->allocate.record(now_ns() - start);
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        const uint64_t start = now_ns();
+        upstream_->deallocate(ptr, bytes, alignment);
+        if (tl_latencies)
+        {
+            tl_latencies->deallocate.record(now_ns() - start);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource *upstream_;
+};
+
+// Делает непотокобезопасный ресурс доступным из нескольких потоков
+class LockedResource : public std::pmr::memory_resource
+{
+public:
+    explicit LockedResource(std::pmr::memory_resource *upstream) : upstream_(upstream) {}
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource *upstream_;
+    std::mutex mutex_;
+};
+
+using Array = DynamicArray<uint64_t>;
+
+static void timed_push_back(Array &arr, uint64_t value, ThreadLatencies &latencies)
+{
+    const uint64_t start = now_ns();
+    arr.push_back(value);
+    latencies.push_back.record(now_ns() - start);
+}
+
+// Массивы растут до 64K элементов и уничтожаются: много перевыделений
+static void run_append(std::pmr::memory_resource *mr, ThreadLatencies &latencies, size_t pushes, unsigned)
+{
+    const size_t kLength = 64 * 1024;
+    size_t done = 0;
+    while (done < pushes)
+    {
+        Array arr(mr);
+        for (size_t i = 0; i < kLength && done < pushes; ++i, ++done)
+        {
+            timed_push_back(arr, i, latencies);
+        }
+    }
+}
+
+/**
+ * Заменяет случайные массивы в наборе живых: длины берутся из
+ * length(rng), поэтому освобождения перемешаны с выделениями.
+ */
+template <typename Length>
+static void run_replace(std::pmr::memory_resource *mr, ThreadLatencies &latencies, size_t pushes, unsigned seed,
+                        size_t live, Length length)
+{
+    std::mt19937 rng(seed);
+    std::vector<std::optional<Array>> slots(live);
+    size_t done = 0;
+    while (done < pushes)
+    {
+        std::optional<Array> &slot = slots[rng() % live];
+        slot.emplace(mr);
+        const size_t count = length(rng);
+        for (size_t i = 0; i < count && done < pushes; ++i, ++done)
+        {
+            timed_push_back(*slot, i, latencies);
+        }
+    }
+}
+
+// Мелкие массивы 1..64 элемента в наборе из 256 живых
+static void run_churn(std::pmr::memory_resource *mr, ThreadLatencies &latencies, size_t pushes, unsigned seed)
+{
+    run_replace(mr, latencies, pushes, seed, 256, [](std::mt19937 &rng)
+                { return size_t(1) + rng() % 64; });
+}
+
+// 80% массивов до 16 элементов, 18% до 1024, 2% до 64K
+static void run_mixed(std::pmr::memory_resource *mr, ThreadLatencies &latencies, size_t pushes, unsigned seed)
+{
+    run_replace(mr, latencies, pushes, seed, 64, [](std::mt19937 &rng)
+                {
+                    const unsigned roll = rng() % 100;
+                    const size_t limit = roll < 80 ? 16 : roll < 98 ? 1024 : 64 * 1024;
+                    return size_t(1) + rng() % limit; });
+}
+
+// Очередь готовых массивов от производителей к потребителям
+class ArrayQueue
+{
+public:
+    static constexpr size_t kCapacity = 1024;
+
+    void push(std::unique_ptr<Array> arr)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this]
+                       { return queue_.size() < kCapacity; });
+        queue_.push_back(std::move(arr));
+        not_empty_.notify_one();
+    }
+
+    // nullptr - производители закончили и очередь пуста
+    std::unique_ptr<Array> pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this]
+                        { return !queue_.empty() || producers_ == 0; });
+        if (queue_.empty())
+        {
+            return nullptr;
+        }
+        std::unique_ptr<Array> arr = std::move(queue_.front());
+        queue_.pop_front();
+        not_full_.notify_one();
+        return arr;
+    }
+
+    void set_producers(size_t producers) { producers_ = producers; }
+
+    void producer_done()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--producers_ == 0)
+        {
+            not_empty_.notify_all();
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::unique_ptr<Array>> queue_;
+    size_t producers_{0};
+};
+
+// Половина потоков строит массивы, другая освобождает их: блоки уходят в чужой поток
+static void run_producer(std::pmr::memory_resource *mr, ThreadLatencies &latencies, size_t pushes, unsigned seed,
+                         ArrayQueue &queue)
+{
+    std::mt19937 rng(seed);
+    size_t done = 0;
+    while (done < pushes)
+    {
+        auto arr = std::make_unique<Array>(mr);
+        const size_t count = 1 + rng() % 256;
+        for (size_t i = 0; i < count && done < pushes; ++i, ++done)
+        {
+            timed_push_back(*arr, i, latencies);
+        }
+        queue.push(std::move(arr));
+    }
+    queue.producer_done();
+}
+
+static void run_consumer(ArrayQueue &queue)
+{
+    while (std::unique_ptr<Array> arr = queue.pop())
+    {
+    }
+}
+
+static void print_row(const char *name, const LatencyHistogram &histogram)
+{
+    std::cout << name << " | " << histogram.get_count()
+              << " | " << histogram.value_at_percentile(50.0)
+              << " | " << histogram.value_at_percentile(99.0)
+              << " | " << histogram.value_at_percentile(99.9)
+              << " | " << histogram.get_max() << "\n";
+}
+
+static void run_workload(const std::string &workload, const std::string &resource_name,
+                         std::pmr::memory_resource *resource, size_t threads, size_t pushes)
+{
+    TimedResource timed(resource);
+    std::vector<ThreadLatencies> latencies(threads);
+    ArrayQueue queue;
+    const bool pipeline = workload == "producer-consumer";
+    const size_t producers = pipeline ? std::max<size_t>(1, threads / 2) : threads;
+    queue.set_producers(producers);
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]
+                             {
+                                 ThreadLatencies &mine = latencies[t];
+                                 tl_latencies = &mine;
+                                 const unsigned seed = static_cast<unsigned>(t + 1);
+                                 while (!start.load(std::memory_order_acquire))
+                                 {
+                                     std::this_thread::yield();
+                                 }
+                                 if (workload == "append")
+                                 {
+                                     run_append(&timed, mine, pushes, seed);
+                                 }
+                                 else if (workload == "churn")
+                                 {
+                                     run_churn(&timed, mine, pushes, seed);
+                                 }
+                                 else if (workload == "mixed")
+                                 {
+                                     run_mixed(&timed, mine, pushes, seed);
+                                 }
+                                 else if (t < producers)
+                                 {
+                                     run_producer(&timed, mine, pushes, seed, queue);
+                                 }
+                                 else
+                                 {
+                                     run_consumer(queue);
+                                 }
+                                 tl_latencies = nullptr; });
+    }
+
+    const uint64_t begin = now_ns();
+    start.store(true, std::memory_order_release);
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    const double seconds = static_cast<double>(now_ns() - begin) / 1e9;
+
+    ThreadLatencies total;
+    for (const ThreadLatencies &mine : latencies)
+    {
+        total.allocate.merge(mine.allocate);
+        total.deallocate.merge(mine.deallocate);
+        total.push_back.merge(mine.push_back);
+    }
+
+    std::cout << "\n== " << workload << " / " << resource_name << ": " << threads << " потоков, "
+              << static_cast<double>(total.push_back.get_count()) / seconds / 1e6 << " млн push_back/с\n";
+    std::cout << "операция | число | p50, нс | p99, нс | p99.9, нс | max, нс\n";
+    print_row("allocate", total.allocate);
+    print_row("deallocate", total.deallocate);
+    print_row("push_back", total.push_back);
+}
+
+static bool run_on(const std::string &name, const std::string &workload, size_t threads, size_t pushes)
+{
+    if (name == "custom" || name == "custom-best")
+    {
+        CustomMemoryResource mr;
+        if (name == "custom-best")
+        {
+            mr.set_placement_policy(PlacementPolicy::BestFit);
+        }
+        LockedResource locked(&mr);
+        run_workload(workload, name, &locked, threads, pushes);
+        return true;
+    }
+    if (name == "thread-cache")
+    {
+        CustomMemoryResource upstream;
+        ThreadCacheResource cache(&upstream);
+        run_workload(workload, name, &cache, threads, pushes);
+        return true;
+    }
+    if (name == "pool")
+    {
+        std::pmr::synchronized_pool_resource pool;
+        run_workload(workload, name, &pool, threads, pushes);
+        return true;
+    }
+    if (name == "new-delete")
+    {
+        run_workload(workload, name, std::pmr::new_delete_resource(), threads, pushes);
+        return true;
+    }
+    std::cerr << "Неизвестный ресурс: " << name << "\n";
+    return false;
+}
+
+// Минимальная стоимость пары чтений часов - нижняя граница любого замера
+static uint64_t clock_overhead_ns()
+{
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint64_t start = now_ns();
+        best = std::min(best, now_ns() - start);
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    const std::string workload = argc > 1 ? argv[1] : "all";
+    const std::string resource = argc > 2 ? argv[2] : "all";
+    const size_t threads = argc > 3 ? static_cast<size_t>(std::atoll(argv[3])) : 4;
+    const size_t pushes = argc > 4 ? static_cast<size_t>(std::atoll(argv[4])) : 200000;
+
+    const std::vector<std::string> all_workloads = {"append", "churn", "mixed", "producer-consumer"};
+    const std::vector<std::string> all_resources = {"custom", "custom-best", "thread-cache", "pool", "new-delete"};
+
+    std::vector<std::string> workloads = workload == "all" ? all_workloads : std::vector<std::string>{workload};
+    std::vector<std::string> resources = resource == "all" ? all_resources : std::vector<std::string>{resource};
+    for (const std::string &name : workloads)
+    {
+        if (std::find(all_workloads.begin(), all_workloads.end(), name) == all_workloads.end())
+        {
+            std::cerr << "Неизвестная нагрузка: " << name << "\n"
+                      << "Использование: lab5_load [нагрузка] [ресурс] [потоков] [push_back_на_поток]\n";
+            return 1;
+        }
+    }
+    if (threads == 0)
+    {
+        std::cerr << "Нужен хотя бы один поток\n";
+        return 1;
+    }
+
+    std::cout << "Чтение часов: ~" << clock_overhead_ns() << " нс (входит в каждый замер)\n";
+    for (const std::string &name : workloads)
+    {
+        // Производителю и потребителю нужен хотя бы один поток каждому
+        const size_t workers = name == "producer-consumer" ? std::max<size_t>(threads, 2) : threads;
+        for (const std::string &resource_name : resources)
+        {
+            if (!run_on(resource_name, name, workers, pushes))
+            {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
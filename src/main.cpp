@@ -1,7 +1,9 @@
+#include <filesystem>
 #include <iostream>
 #include <string>
 #include "custom_memory_resource.h"
 #include "dynamic_array.h"
+#include "dynamic_array_io.h"
 
 struct Person
 {
@@ -18,6 +20,26 @@ struct Person
     }
 };
 
+// Кодек для сохранения Person в бинарный файл (save_array / load_array)
+template <>
+struct ElementCodec<Person>
+{
+    static constexpr uint32_t type_tag = 0x50455253; // "PERS"
+
+    static void encode(const Person &person, ByteWriter &out)
+    {
+        out.write_string(person.name);
+        out.write<int32_t>(person.age);
+    }
+
+    static Person decode(ByteReader &in)
+    {
+        std::string name = in.read_string();
+        int age = in.read<int32_t>();
+        return Person(std::move(name), age);
+    }
+};
+
 int main()
 {
 
@@ -68,6 +90,22 @@ int main()
     }
     std::cout << "\n\n";
 
+    // Пример 4: Сохранение в файл и загрузка
+    std::cout << "4. Сохранение и загрузка Person:\n";
+    const std::string path = (std::filesystem::temp_directory_path() / "lab5_people.bin").string();
+    save_array(path, people);
+
+    DynamicArray<Person> loaded(&mr);
+    load_array(path, loaded);
+    std::filesystem::remove(path);
+
+    std::cout << "   Загружено: ";
+    for (const auto &person : loaded)
+    {
+        std::cout << person << " ";
+    }
+    std::cout << "\n\n";
+
     std::cout << "=== Программа завершена успешно ===\n";
 
     return 0;
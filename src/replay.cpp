@@ -0,0 +1,215 @@
+// lab5_replay: проигрывание журнала выделений (TraceRecorder) на разных memory_resource.
+//
+// Запуск:
+//   lab5_replay <журнал> [ресурс...]      - проиграть журнал; по умолчанию на всех ресурсах
+//   lab5_replay --record-demo <журнал>    - записать демонстрационный журнал (DynamicArray)
+//
+// Ресурсы: custom-first, custom-best, custom-good, thread-cache, pool, monotonic, new-delete.
+// Для каждого выводится пропускная способность, пик памяти, взятой ресурсом у
+// системы, и фрагментация = 1 - пик живых байт / пик памяти ресурса.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "allocation_trace.h"
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include "thread_cache_resource.h"
+
+// Считает байты, которые ресурс-надстройка взял у системы
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t get_peak_bytes() const { return peak_; }
+
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        void *ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        current_ += bytes;
+        peak_ = std::max(peak_, current_);
+        return ptr;
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        current_ -= bytes;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    size_t current_{0};
+    size_t peak_{0};
+};
+
+static void print_row(const std::string &name, const TraceReplayStats &stats, size_t footprint)
+{
+    double fragmentation = footprint > 0 ? 1.0 - static_cast<double>(stats.peak_live_bytes) / static_cast<double>(footprint) : 0.0;
+    std::cout << name << " | "
+              << stats.ops_per_second() / 1e6 << " | "
+              << footprint / 1024 << " | "
+              << fragmentation * 100.0 << "\n";
+}
+
+static bool replay_on(const std::string &name, const TraceProgram &program)
+{
+    if (name == "custom-first" || name == "custom-best" || name == "custom-good")
+    {
+        CustomMemoryResource mr;
+        mr.set_placement_policy(name == "custom-first"  ? PlacementPolicy::FirstFit
+                                : name == "custom-best" ? PlacementPolicy::BestFit
+                                                        : PlacementPolicy::GoodFit);
+        size_t peak = 0;
+        TraceReplayStats stats = replay_trace(program, mr,
+                                              [&mr, &peak](const TraceReplayStats &)
+                                              {
+                                                  peak = std::max(peak, mr.get_footprint_bytes());
+                                              });
+        print_row(name, stats, peak);
+        return true;
+    }
+    if (name == "thread-cache")
+    {
+        CustomMemoryResource upstream;
+        TraceReplayStats stats;
+        size_t peak = 0;
+        {
+            ThreadCacheResource cache(&upstream);
+            stats = replay_trace(program, cache,
+                                 [&upstream, &peak](const TraceReplayStats &)
+                                 {
+                                     peak = std::max(peak, upstream.get_footprint_bytes());
+                                 });
+        }
+        print_row(name, stats, peak);
+        return true;
+    }
+    if (name == "pool" || name == "monotonic" || name == "new-delete")
+    {
+        CountingResource counting;
+        TraceReplayStats stats;
+        if (name == "pool")
+        {
+            std::pmr::unsynchronized_pool_resource pool(&counting);
+            stats = replay_trace(program, pool);
+        }
+        else if (name == "monotonic")
+        {
+            std::pmr::monotonic_buffer_resource monotonic(&counting);
+            stats = replay_trace(program, monotonic);
+        }
+        else
+        {
+            stats = replay_trace(program, counting);
+        }
+        print_row(name, stats, counting.get_peak_bytes());
+        return true;
+    }
+    std::cerr << "Неизвестный ресурс: " << name << "\n";
+    return false;
+}
+
+// Демонстрационная нагрузка: массивы разных типов растут и освобождаются
+static int record_demo(const char *path)
+{
+    std::ofstream out(path, std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Не удалось открыть " << path << "\n";
+        return 1;
+    }
+
+    CustomMemoryResource mr;
+    TraceRecorder recorder(out);
+    mr.add_observer(&recorder);
+    for (int round = 0; round < 200; ++round)
+    {
+        DynamicArray<int> numbers(&mr);
+        DynamicArray<double> values(&mr);
+        for (int i = 0; i < 50 + round * 10; ++i)
+        {
+            numbers.push_back(i);
+            if (i % 3 == 0)
+            {
+                values.push_back(i * 0.5);
+            }
+        }
+        DynamicArray<std::pmr::string> names(&mr);
+        for (int i = 0; i < round % 20; ++i)
+        {
+            names.push_back(std::pmr::string("элемент номер " + std::to_string(i), &mr));
+        }
+    }
+    mr.remove_observer(&recorder);
+    recorder.flush();
+
+    std::cout << "Записано операций: " << recorder.get_records_count() << " в " << path << "\n";
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Использование: lab5_replay <журнал> [ресурс...]\n"
+                  << "               lab5_replay --record-demo <журнал>\n";
+        return 1;
+    }
+    if (std::string(argv[1]) == "--record-demo")
+    {
+        if (argc < 3)
+        {
+            std::cerr << "Укажите файл журнала\n";
+            return 1;
+        }
+        return record_demo(argv[2]);
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Не удалось открыть " << argv[1] << "\n";
+        return 1;
+    }
+
+    try
+    {
+        TraceReader reader(in);
+        TraceProgram program(reader);
+
+        std::vector<std::string> resources;
+        for (int i = 2; i < argc; ++i)
+        {
+            resources.push_back(argv[i]);
+        }
+        if (resources.empty())
+        {
+            resources = {"custom-first", "custom-best", "custom-good", "thread-cache", "pool", "monotonic", "new-delete"};
+        }
+
+        std::cout << "Операций: " << program.steps().size()
+                  << ", длительность записи: " << program.recorded_ns() / 1e6 << " мс\n";
+        std::cout << "ресурс | млн оп/с | пик памяти, КБ | фрагментация, %\n";
+        for (const std::string &name : resources)
+        {
+            if (!replay_on(name, program))
+            {
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
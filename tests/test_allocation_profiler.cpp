@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "allocation_profiler.h"
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include "thread_cache_resource.h"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Одно место вызова для разных ресурсов
+static LAB5_NOINLINE void *allocate_from(std::pmr::memory_resource *resource, size_t bytes)
+{
+    return resource->allocate(bytes);
+}
+
+// Тесты для AllocationProfiler
+class AllocationProfilerTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+};
+
+TEST_F(AllocationProfilerTest, DisabledByDefault)
+{
+    AllocationProfiler profiler(1);
+
+    void *ptr = mr->allocate(100);
+    mr->deallocate(ptr, 100);
+
+    EXPECT_EQ(profiler.get_sites_count(), 0);
+}
+
+TEST_F(AllocationProfilerTest, SamplesEveryAllocationWithPeriodOne)
+{
+    AllocationProfiler profiler(1);
+    mr->add_observer(&profiler);
+
+    void *ptr1 = mr->allocate(100);
+    void *ptr2 = mr->allocate(200);
+
+    EXPECT_EQ(profiler.get_live_samples_count(), 2);
+    EXPECT_NEAR(profiler.get_estimated_live_bytes(), 300, 1);
+
+    mr->deallocate(ptr1, 100);
+    EXPECT_EQ(profiler.get_live_samples_count(), 1);
+    EXPECT_NEAR(profiler.get_estimated_live_bytes(), 200, 1);
+
+    mr->deallocate(ptr2, 200);
+    EXPECT_EQ(profiler.get_live_samples_count(), 0);
+    EXPECT_NEAR(profiler.get_estimated_live_bytes(), 0, 1e-9);
+
+    mr->remove_observer(&profiler);
+}
+
+TEST_F(AllocationProfilerTest, EstimateIsCloseToRealLiveHeap)
+{
+    AllocationProfiler profiler(4096);
+    mr->add_observer(&profiler);
+
+    DynamicArray<void *> blocks;
+    size_t live = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        size_t bytes = 64 + (i % 16) * 32;
+        blocks.push_back(mr->allocate(bytes));
+        live += bytes;
+    }
+
+    // Сэмплирование даёт несмещённую оценку с погрешностью в несколько процентов
+    EXPECT_NEAR(profiler.get_estimated_live_bytes(), static_cast<double>(live), live * 0.1);
+    EXPECT_LT(profiler.get_live_samples_count(), blocks.size());
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        mr->deallocate(blocks[i], 64 + (i % 16) * 32);
+    }
+    EXPECT_EQ(profiler.get_live_samples_count(), 0);
+
+    mr->remove_observer(&profiler);
+}
+
+TEST_F(AllocationProfilerTest, FoldedOutputFormat)
+{
+    AllocationProfiler profiler(1);
+    mr->add_observer(&profiler);
+
+    void *ptr = mr->allocate(1000);
+
+    std::ostringstream os;
+    profiler.write_folded(os);
+    std::string line = os.str();
+
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.back(), '\n');
+    // Последнее поле строки - число байт
+    EXPECT_EQ(line.substr(line.rfind(' ') + 1), "1000\n");
+
+    mr->deallocate(ptr, 1000);
+
+    // После освобождения живая куча пуста, но общий профиль сохраняется
+    std::ostringstream live;
+    profiler.write_folded(live);
+    EXPECT_TRUE(live.str().empty());
+
+    std::ostringstream total;
+    profiler.write_folded(total, false);
+    EXPECT_FALSE(total.str().empty());
+
+    mr->remove_observer(&profiler);
+}
+
+TEST_F(AllocationProfilerTest, BatchPathTrimsAllocatorFrames)
+{
+    AllocationProfiler profiler(1);
+    mr->add_observer(&profiler);
+
+    // Прямой вызов и промах ThreadCacheResource (allocate_batch) из одной функции
+    void *direct = allocate_from(mr, 64);
+    ThreadCacheResource cache(mr);
+    void *cached = allocate_from(&cache, 64);
+
+    std::ostringstream os;
+    profiler.write_folded(os);
+    std::istringstream lines(os.str());
+    std::string line;
+    std::vector<size_t> depths;
+    while (std::getline(lines, line))
+    {
+        depths.push_back(static_cast<size_t>(std::count(line.begin(), line.end(), ';')));
+    }
+    // Оба стека обрезаны по allocate_from, а выше неё глубина одинакова
+    ASSERT_EQ(depths.size(), 2u);
+    EXPECT_EQ(depths[0], depths[1]);
+
+    cache.deallocate(cached, 64);
+    mr->deallocate(direct, 64);
+    mr->remove_observer(&profiler);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "allocation_trace.h"
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include <sstream>
+
+// Тесты для TraceRecorder, TraceReader и replay_trace
+class AllocationTraceTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+};
+
+TEST_F(AllocationTraceTest, RecordsAndReadsBack)
+{
+    std::stringstream log;
+    {
+        TraceRecorder recorder(log);
+        mr->add_observer(&recorder);
+
+        void *a = mr->allocate(100, 8);
+        void *b = mr->allocate(5000, 64);
+        mr->deallocate(a, 100, 8);
+        mr->deallocate(b, 5000, 64);
+
+        mr->remove_observer(&recorder);
+        EXPECT_EQ(recorder.get_records_count(), 4);
+    }
+
+    TraceReader reader(log);
+    TraceRecord record;
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.op, TraceOp::Allocate);
+    EXPECT_EQ(record.id, 0);
+    EXPECT_EQ(record.size, 100);
+    EXPECT_EQ(record.alignment, 8);
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.op, TraceOp::Allocate);
+    EXPECT_EQ(record.id, 1);
+    EXPECT_EQ(record.size, 5000);
+    EXPECT_EQ(record.alignment, 64);
+
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.op, TraceOp::Deallocate);
+    EXPECT_EQ(record.id, 0);
+
+    uint64_t previous = record.timestamp_ns;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.op, TraceOp::Deallocate);
+    EXPECT_EQ(record.id, 1);
+    EXPECT_GE(record.timestamp_ns, previous);
+
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(AllocationTraceTest, RecordsAreCompact)
+{
+    std::stringstream log;
+    size_t records;
+    {
+        TraceRecorder recorder(log);
+        mr->add_observer(&recorder);
+        for (int i = 0; i < 1000; ++i)
+        {
+            mr->deallocate(mr->allocate(64), 64);
+        }
+        mr->remove_observer(&recorder);
+        records = recorder.get_records_count();
+    }
+
+    EXPECT_EQ(records, 2000);
+    EXPECT_LT(log.str().size(), records * 10);
+}
+
+TEST_F(AllocationTraceTest, UnknownDeallocationIsSkipped)
+{
+    void *before = mr->allocate(32);
+
+    std::stringstream log;
+    {
+        TraceRecorder recorder(log);
+        mr->add_observer(&recorder);
+        mr->deallocate(before, 32);
+        mr->remove_observer(&recorder);
+        EXPECT_EQ(recorder.get_records_count(), 0);
+    }
+
+    TraceReader reader(log);
+    TraceRecord record;
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(AllocationTraceTest, ReplayReproducesWorkload)
+{
+    std::stringstream log;
+    {
+        TraceRecorder recorder(log);
+        mr->add_observer(&recorder);
+        {
+            DynamicArray<int> arr(mr);
+            for (int i = 0; i < 100; ++i)
+            {
+                arr.push_back(i);
+            }
+        }
+        void *leaked = mr->allocate(256);
+        (void)leaked;
+        mr->remove_observer(&recorder);
+    }
+
+    TraceReader reader(log);
+    TraceProgram program(reader);
+
+    CustomMemoryResource target;
+    size_t steps = 0;
+    TraceReplayStats stats = replay_trace(program, target, [&steps](const TraceReplayStats &)
+                                          { ++steps; });
+
+    // push_back удваивает ёмкость: 1, 2, 4, ..., 128 элементов - 8 выделений
+    EXPECT_EQ(stats.allocations, 9);
+    EXPECT_EQ(stats.deallocations, 8);
+    EXPECT_EQ(steps, 17);
+    EXPECT_EQ(stats.live_blocks_at_end, 1);
+    // Пик: буфер на 64 int ещё жив, пока выделяется буфер на 128
+    EXPECT_EQ(stats.peak_live_bytes, (64 + 128) * sizeof(int));
+    EXPECT_EQ(target.get_allocated_blocks_count(), 0);
+}
+
+TEST_F(AllocationTraceTest, ReplayOnStandardResource)
+{
+    std::stringstream log;
+    {
+        TraceRecorder recorder(log);
+        mr->add_observer(&recorder);
+        void *ptrs[10];
+        mr->allocate_batch(10, 48, 16, ptrs);
+        mr->deallocate_batch(ptrs, 10, 48, 16);
+        mr->remove_observer(&recorder);
+    }
+
+    TraceReader reader(log);
+    TraceProgram program(reader);
+    std::pmr::unsynchronized_pool_resource pool;
+    TraceReplayStats stats = replay_trace(program, pool);
+
+    EXPECT_EQ(stats.allocations, 10);
+    EXPECT_EQ(stats.deallocations, 10);
+    EXPECT_EQ(stats.peak_live_bytes, 480);
+}
+
+TEST_F(AllocationTraceTest, RejectsForeignData)
+{
+    std::stringstream garbage("definitely not a trace");
+    EXPECT_THROW(TraceReader reader(garbage), std::runtime_error);
+}
+
+TEST_F(AllocationTraceTest, TruncatedLogThrows)
+{
+    std::stringstream log;
+    {
+        TraceRecorder recorder(log);
+        recorder.on_allocate(reinterpret_cast<void *>(0x1000), 1000000, 8);
+    }
+    std::string data = log.str();
+    data.pop_back();
+
+    std::stringstream truncated(data);
+    TraceReader reader(truncated);
+    TraceRecord record;
+    EXPECT_THROW(reader.next(record), std::runtime_error);
+}
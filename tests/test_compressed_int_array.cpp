@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include "compressed_int_array.h"
+#include "custom_memory_resource.h"
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Тесты для CompressedIntArray
+class CompressedIntArrayTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+
+    // Проверяет доступ по индексу, распаковку блоков и полную распаковку
+    template <typename T>
+    void check_round_trip(const std::vector<T> &values)
+    {
+        CompressedIntArray<T> arr(mr);
+        arr.append(values.data(), values.size());
+        ASSERT_EQ(arr.size(), values.size());
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            ASSERT_EQ(arr[i], values[i]) << "индекс " << i;
+        }
+
+        std::vector<T> scanned;
+        arr.for_each_block([&scanned](const T *block, size_t count)
+                           { scanned.insert(scanned.end(), block, block + count); });
+        EXPECT_EQ(scanned, values);
+
+        DynamicArray<T> decoded(mr);
+        arr.decode(decoded);
+        EXPECT_EQ(std::vector<T>(decoded.begin(), decoded.end()), values);
+    }
+};
+
+TEST_F(CompressedIntArrayTest, SmallIdsUseFrameOfReference)
+{
+    std::mt19937 rng(1);
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 10000; ++i)
+    {
+        ids.push_back(1000000 + rng() % 1000);
+    }
+    check_round_trip(ids);
+
+    CompressedIntArray<uint32_t> arr(mr);
+    arr.append(ids.data(), ids.size());
+    EXPECT_EQ(arr.get_block_encoding(0), BlockEncoding::FrameOfReference);
+    EXPECT_EQ(arr.get_block_width(0), 10u);
+    EXPECT_GE(arr.get_compression_ratio(), 2.5);
+}
+
+TEST_F(CompressedIntArrayTest, TimestampsUseDeltas)
+{
+    std::mt19937 rng(2);
+    std::vector<uint64_t> timestamps;
+    uint64_t now = 1700000000000000ull;
+    for (int i = 0; i < 10000; ++i)
+    {
+        now += 1000 + rng() % 50;
+        timestamps.push_back(now);
+    }
+    check_round_trip(timestamps);
+
+    CompressedIntArray<uint64_t> arr(mr);
+    arr.append(timestamps.data(), timestamps.size());
+    EXPECT_EQ(arr.get_block_encoding(0), BlockEncoding::Delta);
+    EXPECT_GE(arr.get_compression_ratio(), 6.0);
+}
+
+TEST_F(CompressedIntArrayTest, DecreasingSequence)
+{
+    std::vector<uint64_t> values;
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        values.push_back(5000000 - i * 3);
+    }
+    check_round_trip(values);
+}
+
+TEST_F(CompressedIntArrayTest, FullWidthValues)
+{
+    std::mt19937_64 rng(3);
+    std::vector<uint64_t> wide;
+    std::vector<uint32_t> narrow;
+    for (int i = 0; i < 1000; ++i)
+    {
+        wide.push_back(rng());
+        narrow.push_back(static_cast<uint32_t>(rng()));
+    }
+    wide[5] = 0;
+    wide[6] = std::numeric_limits<uint64_t>::max();
+    check_round_trip(wide);
+    check_round_trip(narrow);
+
+    CompressedIntArray<uint64_t> arr(mr);
+    arr.append(wide.data(), wide.size());
+    EXPECT_EQ(arr.get_block_width(0), 64u);
+}
+
+TEST_F(CompressedIntArrayTest, ConstantBlocksTakeNoWords)
+{
+    std::vector<uint32_t> values(8 * CompressedIntArray<uint32_t>::kBlockSize, 42u);
+    check_round_trip(values);
+
+    CompressedIntArray<uint32_t> arr(mr);
+    arr.append(values.data(), values.size());
+    EXPECT_EQ(arr.get_block_width(0), 0u);
+    EXPECT_GT(arr.get_compression_ratio(), 10.0);
+}
+
+TEST_F(CompressedIntArrayTest, EveryWidthRoundTrips)
+{
+    std::mt19937_64 rng(4);
+    for (unsigned width = 1; width <= 64; ++width)
+    {
+        const uint64_t mask = width == 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1;
+        std::vector<uint64_t> values;
+        for (size_t i = 0; i < CompressedIntArray<uint64_t>::kBlockSize; ++i)
+        {
+            values.push_back(rng() & mask);
+        }
+        values[0] = 0;
+        values[1] = mask;
+        check_round_trip(values);
+    }
+}
+
+TEST_F(CompressedIntArrayTest, TailStaysUncompressed)
+{
+    CompressedIntArray<uint16_t> arr(mr);
+    for (uint16_t i = 0; i < 130; ++i)
+    {
+        arr.push_back(static_cast<uint16_t>(i * 7));
+    }
+    EXPECT_EQ(arr.blocks_count(), 2u);
+    EXPECT_EQ(arr[129], 129 * 7);
+    EXPECT_EQ(arr[127], 127 * 7);
+
+    uint16_t block[CompressedIntArray<uint16_t>::kBlockSize];
+    EXPECT_EQ(arr.decode_block(1, block), 2u);
+    EXPECT_EQ(block[1], 129 * 7);
+}
+
+TEST_F(CompressedIntArrayTest, AtChecksBounds)
+{
+    CompressedIntArray<uint32_t> arr(mr);
+    EXPECT_TRUE(arr.empty());
+    EXPECT_THROW(arr.at(0), std::out_of_range);
+    arr.push_back(1);
+    EXPECT_EQ(arr.at(0), 1u);
+    EXPECT_THROW(arr.at(1), std::out_of_range);
+
+    arr.clear();
+    EXPECT_EQ(arr.size(), 0u);
+}
+
+TEST_F(CompressedIntArrayTest, StorageComesFromResource)
+{
+    const size_t before = mr->get_total_allocated_bytes();
+    CompressedIntArray<uint32_t> arr(mr);
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        arr.push_back(i);
+    }
+    EXPECT_GT(mr->get_total_allocated_bytes(), before);
+}
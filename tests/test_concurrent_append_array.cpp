@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include "concurrent_append_array.h"
+#include "custom_memory_resource.h"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Элемент с бросающим конструктором и счётчиком живых объектов
+struct PickyValue
+{
+    static int alive;
+    int value;
+
+    PickyValue(int v) : value(v)
+    {
+        check();
+        ++alive;
+    }
+
+    PickyValue(const PickyValue &other) : value(other.value)
+    {
+        check();
+        ++alive;
+    }
+
+    // Перед исключением успевает добавить элемент следом, как параллельный писатель
+    PickyValue(ConcurrentAppendArray<PickyValue> *arr, int v) : value(v)
+    {
+        arr->emplace_back(v + 1);
+        throw std::runtime_error("отказ после чужого добавления");
+    }
+
+    ~PickyValue() { --alive; }
+
+    void check() const
+    {
+        if (value < 0)
+        {
+            throw std::invalid_argument("отрицательное значение");
+        }
+    }
+};
+
+int PickyValue::alive = 0;
+
+// Тесты для ConcurrentAppendArray
+class ConcurrentAppendArrayTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+};
+
+TEST_F(ConcurrentAppendArrayTest, SingleThreadAppend)
+{
+    ConcurrentAppendArray<int> arr(mr);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(arr.push_back(i), static_cast<size_t>(i));
+    }
+
+    EXPECT_EQ(arr.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(arr[i], i);
+    }
+    EXPECT_THROW(arr.at(1000), std::out_of_range);
+}
+
+TEST_F(ConcurrentAppendArrayTest, ElementsNeverMove)
+{
+    ConcurrentAppendArray<int> arr(mr);
+    arr.push_back(42);
+    const int *first = &arr[0];
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        arr.push_back(i);
+    }
+
+    // Рост добавляет сегменты, но не перемещает старые элементы
+    EXPECT_EQ(&arr[0], first);
+    EXPECT_EQ(*first, 42);
+    EXPECT_GT(arr.segments_count(), 1);
+}
+
+TEST_F(ConcurrentAppendArrayTest, AppendAcrossSegments)
+{
+    ConcurrentAppendArray<int> arr(mr);
+    std::vector<int> values(300);
+    for (int i = 0; i < 300; ++i)
+    {
+        values[i] = i;
+    }
+
+    arr.push_back(-1);
+    EXPECT_EQ(arr.append(values.data(), values.size()), 1);
+
+    EXPECT_EQ(arr.size(), 301);
+    for (int i = 0; i < 300; ++i)
+    {
+        EXPECT_EQ(arr[i + 1], i);
+    }
+}
+
+TEST_F(ConcurrentAppendArrayTest, ConcurrentAppendKeepsAllElements)
+{
+    ConcurrentAppendArray<long long> arr(mr);
+    const int threads = 4;
+    const int per_thread = 20000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&arr, t]()
+                             {
+                                 for (int i = 0; i < per_thread; ++i)
+                                 {
+                                     arr.push_back(static_cast<long long>(t) * per_thread + i);
+                                 }
+                             });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    DynamicArray<long long> frozen = arr.freeze();
+    ASSERT_EQ(frozen.size(), static_cast<size_t>(threads * per_thread));
+    EXPECT_TRUE(arr.empty());
+
+    // Каждое значение должно встретиться ровно один раз
+    std::sort(frozen.begin(), frozen.end());
+    for (size_t i = 0; i < frozen.size(); ++i)
+    {
+        ASSERT_EQ(frozen[i], static_cast<long long>(i));
+    }
+}
+
+TEST_F(ConcurrentAppendArrayTest, FreezeComplexType)
+{
+    ConcurrentAppendArray<std::string> arr(mr);
+    arr.push_back("first");
+    arr.emplace_back(3, 'x');
+
+    DynamicArray<std::string> frozen = arr.freeze();
+    ASSERT_EQ(frozen.size(), 2);
+    EXPECT_EQ(frozen[0], "first");
+    EXPECT_EQ(frozen[1], "xxx");
+    EXPECT_EQ(frozen.get_allocator().resource(), mr);
+
+    // После freeze контейнер можно использовать заново
+    arr.push_back("again");
+    EXPECT_EQ(arr.size(), 1);
+    EXPECT_EQ(arr[0], "again");
+}
+
+TEST_F(ConcurrentAppendArrayTest, ThrowingConstructorRollsBackSlot)
+{
+    PickyValue::alive = 0;
+    {
+        ConcurrentAppendArray<PickyValue> arr(mr);
+        arr.emplace_back(1);
+        EXPECT_THROW(arr.emplace_back(-1), std::invalid_argument);
+        EXPECT_EQ(arr.size(), 1);
+        EXPECT_EQ(arr.failed_count(), 0);
+
+        // Откатившийся индекс достаётся следующему добавлению
+        EXPECT_EQ(arr.emplace_back(2), 1);
+        DynamicArray<PickyValue> frozen = arr.freeze();
+        ASSERT_EQ(frozen.size(), 2);
+        EXPECT_EQ(frozen[1].value, 2);
+    }
+    EXPECT_EQ(PickyValue::alive, 0);
+}
+
+TEST_F(ConcurrentAppendArrayTest, ThrowingConstructorLeavesHoleBehindOthers)
+{
+    PickyValue::alive = 0;
+    {
+        ConcurrentAppendArray<PickyValue> arr(mr);
+        arr.emplace_back(1);
+        EXPECT_THROW(arr.emplace_back(&arr, 10), std::runtime_error);
+
+        // Индекс 1 не откатить: за ним уже лежит элемент 11
+        EXPECT_EQ(arr.size(), 3);
+        EXPECT_EQ(arr.failed_count(), 1);
+        EXPECT_EQ(arr.at(2).value, 11);
+        EXPECT_THROW(arr.at(1), std::out_of_range);
+
+        DynamicArray<PickyValue> frozen = arr.freeze();
+        ASSERT_EQ(frozen.size(), 2);
+        EXPECT_EQ(frozen[0].value, 1);
+        EXPECT_EQ(frozen[1].value, 11);
+        EXPECT_EQ(arr.failed_count(), 0);
+        frozen.clear();
+        EXPECT_EQ(PickyValue::alive, 0);
+
+        // Пропуск в незамороженном контейнере не разрушается деструктором
+        arr.emplace_back(1);
+        EXPECT_THROW(arr.emplace_back(&arr, 20), std::runtime_error);
+    }
+    EXPECT_EQ(PickyValue::alive, 0);
+}
+
+TEST_F(ConcurrentAppendArrayTest, AppendIsAllOrNothing)
+{
+    PickyValue::alive = 0;
+    {
+        ConcurrentAppendArray<PickyValue> arr(mr);
+        DynamicArray<PickyValue> values(mr);
+        for (int i = 0; i < 100; ++i)
+        {
+            values.push_back(PickyValue(i));
+        }
+        values[90].value = -1;
+
+        arr.emplace_back(0);
+        EXPECT_THROW(arr.append(values.data(), values.size()), std::invalid_argument);
+        EXPECT_EQ(arr.size(), 1);
+        EXPECT_EQ(PickyValue::alive, 101);
+    }
+    EXPECT_EQ(PickyValue::alive, 0);
+}
+
+TEST_F(ConcurrentAppendArrayTest, FailedSegmentAllocationTakesNoSlot)
+{
+    ConcurrentAppendArray<int> arr(std::pmr::null_memory_resource());
+    EXPECT_THROW(arr.push_back(1), std::bad_alloc);
+    EXPECT_EQ(arr.size(), 0);
+    EXPECT_EQ(arr.segments_count(), 0);
+    EXPECT_TRUE(arr.freeze().empty());
+}
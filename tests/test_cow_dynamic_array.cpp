@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "cow_dynamic_array.h"
+#include "custom_memory_resource.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+// Тесты для CowDynamicArray
+class CowDynamicArrayTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+
+    CowDynamicArray<int> make_range(int count)
+    {
+        CowDynamicArray<int> arr(mr);
+        for (int i = 0; i < count; ++i)
+        {
+            arr.push_back(i);
+        }
+        return arr;
+    }
+};
+
+TEST_F(CowDynamicArrayTest, CopySharesBuffer)
+{
+    CowDynamicArray<int> original = make_range(1000);
+    const size_t bytes = mr->get_total_allocated_bytes();
+
+    CowDynamicArray<int> copy(original);
+    EXPECT_EQ(std::as_const(copy).data(), std::as_const(original).data());
+    EXPECT_EQ(original.use_count(), 2u);
+    EXPECT_TRUE(copy.is_shared());
+    EXPECT_EQ(mr->get_total_allocated_bytes(), bytes);
+    EXPECT_EQ(copy.size(), 1000u);
+    EXPECT_EQ(copy[999], 999);
+}
+
+TEST_F(CowDynamicArrayTest, ConstAccessDoesNotDetach)
+{
+    CowDynamicArray<int> original = make_range(100);
+    CowDynamicArray<int> copy(original);
+    const CowDynamicArray<int> &view = copy;
+
+    int sum = 0;
+    for (int value : view)
+    {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 4950);
+    EXPECT_EQ(view.at(10), 10);
+    EXPECT_EQ(copy.get(20), 20);
+    EXPECT_EQ(copy.cbegin()[30], 30);
+    EXPECT_EQ(original.use_count(), 2u);
+}
+
+TEST_F(CowDynamicArrayTest, WriteClonesSharedBuffer)
+{
+    CowDynamicArray<int> original = make_range(100);
+    CowDynamicArray<int> copy(original);
+
+    copy[0] = -1;
+    EXPECT_EQ(copy[0], -1);
+    EXPECT_EQ(std::as_const(original)[0], 0);
+    EXPECT_FALSE(original.is_shared());
+    EXPECT_FALSE(copy.is_shared());
+    EXPECT_NE(std::as_const(copy).data(), std::as_const(original).data());
+}
+
+TEST_F(CowDynamicArrayTest, UniqueWriterDoesNotClone)
+{
+    CowDynamicArray<int> arr = make_range(10);
+    arr.reserve(100);
+    const int *before = std::as_const(arr).data();
+
+    arr[5] = 50;
+    arr.push_back(10);
+    arr.pop_back();
+    EXPECT_EQ(std::as_const(arr).data(), before);
+    EXPECT_EQ(arr.get(5), 50);
+}
+
+TEST_F(CowDynamicArrayTest, MutatorsOnSharedBuffer)
+{
+    CowDynamicArray<int> original = make_range(10);
+
+    CowDynamicArray<int> pushed(original);
+    pushed.push_back(10);
+    EXPECT_EQ(pushed.size(), 11u);
+    EXPECT_EQ(original.size(), 10u);
+
+    CowDynamicArray<int> popped(original);
+    popped.pop_back();
+    EXPECT_EQ(popped.size(), 9u);
+    EXPECT_EQ(original.get(9), 9);
+
+    CowDynamicArray<int> resized(original);
+    resized.resize(3);
+    EXPECT_EQ(resized.size(), 3u);
+    EXPECT_EQ(original.size(), 10u);
+
+    // clear у разделённого буфера только отпускает ссылку
+    CowDynamicArray<int> cleared(original);
+    cleared.clear();
+    EXPECT_TRUE(cleared.empty());
+    EXPECT_EQ(original.use_count(), 1u);
+    EXPECT_EQ(original.get(0), 0);
+}
+
+TEST_F(CowDynamicArrayTest, PushBackOwnElementWhileShared)
+{
+    CowDynamicArray<std::string> original(mr);
+    original.push_back("первый");
+    CowDynamicArray<std::string> copy(original);
+
+    copy.push_back(copy.get(0));
+    EXPECT_EQ(copy.get(1), "первый");
+    EXPECT_EQ(original.size(), 1u);
+}
+
+TEST_F(CowDynamicArrayTest, AssignmentAndMove)
+{
+    CowDynamicArray<int> a = make_range(5);
+    CowDynamicArray<int> b = make_range(7);
+
+    b = a;
+    EXPECT_EQ(b.size(), 5u);
+    EXPECT_EQ(a.use_count(), 2u);
+
+    CowDynamicArray<int> c(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.use_count(), 2u);
+
+    b = std::move(c);
+    EXPECT_EQ(b.size(), 5u);
+    EXPECT_EQ(a.use_count(), 2u);
+
+    b = b;
+    EXPECT_EQ(a.use_count(), 2u);
+}
+
+TEST_F(CowDynamicArrayTest, BufferReturnsToOwningResource)
+{
+    CustomMemoryResource other;
+    {
+        CowDynamicArray<std::string> source(&other);
+        source.push_back("строка, которая не помещается в SSO");
+
+        CowDynamicArray<std::string> target(mr);
+        target = source;
+        EXPECT_EQ(target.get(0), "строка, которая не помещается в SSO");
+        EXPECT_EQ(mr->get_allocated_blocks_count(), 0u);
+
+        // Клон при записи берётся из ресурса самого массива
+        target[0] += "!";
+        EXPECT_EQ(mr->get_allocated_blocks_count(), 1u);
+
+        // Последний владелец возвращает буфер тому ресурсу, из которого он выделен
+        {
+            CowDynamicArray<std::string> keeper(source);
+            source.clear();
+        }
+        EXPECT_EQ(other.get_allocated_blocks_count(), 0u);
+    }
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 0u);
+}
+
+TEST_F(CowDynamicArrayTest, FromDynamicArray)
+{
+    DynamicArray<int> source(mr);
+    source.push_back(1);
+    source.push_back(2);
+
+    CowDynamicArray<int> arr(source);
+    EXPECT_EQ(arr.size(), 2u);
+    EXPECT_EQ(arr.get(1), 2);
+    EXPECT_EQ(arr.get_allocator().resource(), mr);
+    EXPECT_THROW(std::as_const(arr).at(2), std::out_of_range);
+}
+
+TEST_F(CowDynamicArrayTest, SnapshotsAcrossThreads)
+{
+    // CustomMemoryResource не потокобезопасен, а клоны выделяются из ресурса массива
+    CowDynamicArray<int> config(std::pmr::new_delete_resource());
+    for (int i = 0; i < 10000; ++i)
+    {
+        config.push_back(i);
+    }
+    std::vector<std::thread> readers;
+    std::vector<long long> sums(4, 0);
+
+    for (size_t t = 0; t < sums.size(); ++t)
+    {
+        readers.emplace_back([&config, &sums, t]
+                             {
+                                 for (int round = 0; round < 50; ++round)
+                                 {
+                                     CowDynamicArray<int> snapshot(config);
+                                     long long sum = 0;
+                                     for (int value : std::as_const(snapshot))
+                                     {
+                                         sum += value;
+                                     }
+                                     // Каждый второй поток правит свою копию
+                                     if (t % 2 == 1)
+                                     {
+                                         snapshot[0] = 1;
+                                     }
+                                     sums[t] = sum;
+                                 } });
+    }
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+
+    for (long long sum : sums)
+    {
+        EXPECT_EQ(sum, 49995000);
+    }
+    EXPECT_EQ(config.use_count(), 1u);
+    EXPECT_EQ(config.get(0), 0);
+}
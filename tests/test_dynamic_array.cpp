@@ -164,6 +164,47 @@ TEST_F(DynamicArrayTest, MoveConstructor)
     EXPECT_EQ(arr1.size(), 0);
 }
 
+TEST_F(DynamicArrayTest, MoveAssignmentSameResource)
+{
+    DynamicArray<std::string> arr1(mr);
+    arr1.push_back("alpha");
+    arr1.push_back("beta");
+    const std::string *buffer = arr1.data();
+
+    DynamicArray<std::string> arr2(mr);
+    arr2.push_back("old");
+    arr2 = std::move(arr1);
+
+    // Буфер перенят без копирования
+    EXPECT_EQ(arr2.data(), buffer);
+    EXPECT_EQ(arr2.size(), 2);
+    EXPECT_EQ(arr2[1], "beta");
+    EXPECT_EQ(arr1.size(), 0);
+}
+
+TEST_F(DynamicArrayTest, MoveAssignmentKeepsResource)
+{
+    CustomMemoryResource other;
+    DynamicArray<std::string> arr1(&other);
+    arr1.push_back("alpha");
+    arr1.push_back("beta");
+
+    DynamicArray<std::string> arr2(mr);
+    arr2 = std::move(arr1);
+
+    // Ресурс не меняется: элементы перенесены в буфер из mr
+    EXPECT_EQ(arr2.get_allocator().resource(), mr);
+    EXPECT_EQ(arr2.size(), 2);
+    EXPECT_EQ(arr2[0], "alpha");
+    EXPECT_EQ(arr2[1], "beta");
+    EXPECT_EQ(arr1.size(), 0);
+    EXPECT_EQ(arr1.get_allocator().resource(), &other);
+
+    // Исходный массив пригоден к повторному использованию
+    arr1.push_back("gamma");
+    EXPECT_EQ(arr1[0], "gamma");
+}
+
 TEST_F(DynamicArrayTest, AssignmentOperator)
 {
     DynamicArray<int> arr1(mr);
@@ -379,3 +420,96 @@ TEST_F(DynamicArrayTest, AutomaticReallocation)
         EXPECT_EQ(arr[i], i);
     }
 }
+
+TEST_F(DynamicArrayTest, ResizeUninitializedKeepsMemory)
+{
+    DynamicArray<int> arr(mr);
+    arr.resize(64, 0x5A5A5A5A);
+    int *buffer = arr.data();
+    arr.resize(0);
+
+    // Ёмкость сохранилась: элементы не обнуляются, в памяти остаются старые значения
+    arr.resize_uninitialized(64);
+    ASSERT_EQ(arr.data(), buffer);
+    EXPECT_EQ(arr.size(), 64);
+    EXPECT_EQ(arr[10], 0x5A5A5A5A);
+
+    arr.resize_uninitialized(10);
+    EXPECT_EQ(arr.size(), 10);
+}
+
+TEST_F(DynamicArrayTest, ResizeDefaultInitConstructsNonTrivial)
+{
+    DynamicArray<std::string> arr(mr);
+    arr.push_back("первый");
+    arr.resize_default_init(5);
+
+    EXPECT_EQ(arr.size(), 5);
+    EXPECT_EQ(arr[0], "первый");
+    EXPECT_TRUE(arr[4].empty());
+
+    arr.resize_default_init(1);
+    EXPECT_EQ(arr.size(), 1);
+}
+
+TEST_F(DynamicArrayTest, AppendWithWritesTail)
+{
+    DynamicArray<int> arr(mr);
+    arr.push_back(-1);
+
+    size_t added = arr.append_with(4, [](int *tail, size_t count)
+                                   {
+                                       for (size_t i = 0; i < count; ++i)
+                                       {
+                                           tail[i] = static_cast<int>(i * 10);
+                                       } });
+
+    EXPECT_EQ(added, 4);
+    ASSERT_EQ(arr.size(), 5);
+    EXPECT_EQ(arr[0], -1);
+    EXPECT_EQ(arr[4], 30);
+}
+
+TEST_F(DynamicArrayTest, AppendWithShortWrite)
+{
+    DynamicArray<char> arr(mr);
+    const std::string source = "abc";
+
+    // Как короткое чтение: просили 100 байт, записано 3
+    size_t added = arr.append_with(100, [&source](char *tail, size_t)
+                                   {
+                                       std::copy(source.begin(), source.end(), tail);
+                                       return source.size(); });
+
+    EXPECT_EQ(added, 3);
+    EXPECT_EQ(arr.size(), 3);
+    EXPECT_GE(arr.capacity(), 100);
+    EXPECT_EQ(arr[2], 'c');
+}
+
+TEST_F(DynamicArrayTest, AppendWithExceptionKeepsSize)
+{
+    DynamicArray<int> arr(mr);
+    arr.push_back(1);
+    arr.push_back(2);
+
+    EXPECT_THROW(arr.append_with(8, [](int *, size_t)
+                                 { throw std::runtime_error("ошибка чтения"); }),
+                 std::runtime_error);
+    EXPECT_EQ(arr.size(), 2);
+    EXPECT_EQ(arr[1], 2);
+}
+
+TEST_F(DynamicArrayTest, AppendWithGrowsGeometrically)
+{
+    DynamicArray<char> arr(mr);
+    for (int i = 0; i < 1000; ++i)
+    {
+        arr.append_with(3, [](char *tail, size_t count)
+                        { std::fill(tail, tail + count, 'x'); });
+    }
+
+    EXPECT_EQ(arr.size(), 3000);
+    // При удвоении ёмкости выделений порядка log2(3000), а не по одному на вызов
+    EXPECT_LT(mr->get_allocated_blocks_count() + mr->get_free_blocks_count(), 20);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "dynamic_array_batch.h"
+#include <string>
+
+// Тесты для пакетного создания DynamicArray
+class DynamicArrayBatchTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+};
+
+TEST_F(DynamicArrayBatchTest, ArraysShareOneChunk)
+{
+    // В усиленном режиме (сборка с LAB5_HARDENED) у каждого блока свой кусок
+    mr->set_hardening(HardeningOptions());
+    auto arrays = make_dynamic_arrays<int>(*mr, 100, 16);
+
+    ASSERT_EQ(arrays.size(), 100);
+    EXPECT_EQ(mr->get_chunks_count(), 1);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 100);
+
+    for (auto &arr : arrays)
+    {
+        EXPECT_TRUE(arr.empty());
+        EXPECT_EQ(arr.capacity(), 16);
+    }
+}
+
+TEST_F(DynamicArrayBatchTest, ArraysWorkAndReleaseBuffers)
+{
+    {
+        auto arrays = make_dynamic_arrays<std::string>(*mr, 10, 4);
+        for (size_t i = 0; i < arrays.size(); ++i)
+        {
+            for (size_t j = 0; j < 6; ++j)
+            {
+                arrays[i].push_back(std::to_string(i * 10 + j));
+            }
+        }
+
+        EXPECT_EQ(arrays[3][5], "35");
+        EXPECT_GE(arrays[3].capacity(), 6);
+    }
+
+    // Все буферы, включая нарезанные из куска, вернулись в ресурс
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 0);
+}
+
+TEST_F(DynamicArrayBatchTest, ZeroCapacity)
+{
+    auto arrays = make_dynamic_arrays<double>(*mr, 3, 0);
+    ASSERT_EQ(arrays.size(), 3);
+    EXPECT_EQ(mr->get_chunks_count(), 0);
+
+    arrays[0].push_back(1.5);
+    EXPECT_EQ(arrays[0][0], 1.5);
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "dynamic_array_io.h"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    struct Record
+    {
+        std::string name;
+        int value;
+    };
+}
+
+template <>
+struct ElementCodec<Record>
+{
+    static constexpr uint32_t type_tag = 0x52454331; // "REC1"
+
+    static void encode(const Record &record, ByteWriter &out)
+    {
+        out.write_string(record.name);
+        out.write<int32_t>(record.value);
+    }
+
+    static Record decode(ByteReader &in)
+    {
+        Record record;
+        record.name = in.read_string();
+        record.value = in.read<int32_t>();
+        return record;
+    }
+};
+
+// Тесты для сохранения и загрузки DynamicArray
+class DynamicArrayIoTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+    std::string path;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+        path = ::testing::TempDir() + "lab5_array_io_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin";
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+        delete mr;
+    }
+};
+
+TEST_F(DynamicArrayIoTest, RoundTripInt)
+{
+    DynamicArray<int> arr(mr);
+    for (int i = 0; i < 1000; ++i)
+    {
+        arr.push_back(i * 3);
+    }
+    save_array(path, arr);
+
+    DynamicArray<int> loaded(mr);
+    loaded.push_back(-1); // Старое содержимое должно замениться
+    load_array(path, loaded);
+
+    ASSERT_EQ(loaded.size(), arr.size());
+    for (size_t i = 0; i < arr.size(); ++i)
+    {
+        EXPECT_EQ(loaded[i], arr[i]);
+    }
+}
+
+TEST_F(DynamicArrayIoTest, RoundTripEmpty)
+{
+    DynamicArray<double> arr(mr);
+    save_array(path, arr);
+
+    DynamicArray<double> loaded(mr);
+    load_array(path, loaded);
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(DynamicArrayIoTest, MappedArrayZeroCopy)
+{
+    DynamicArray<double> arr(mr);
+    for (int i = 0; i < 100; ++i)
+    {
+        arr.push_back(i * 0.5);
+    }
+    save_array(path, arr);
+
+    MappedArray<double> view(path);
+    ASSERT_EQ(view.size(), 100);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.data()) % alignof(double), 0u);
+    EXPECT_DOUBLE_EQ(view[10], 5.0);
+    EXPECT_DOUBLE_EQ(view.at(99), 49.5);
+    EXPECT_THROW(view.at(100), std::out_of_range);
+
+    double sum = 0;
+    for (double value : view)
+    {
+        sum += value;
+    }
+    EXPECT_DOUBLE_EQ(sum, 2475.0);
+}
+
+TEST_F(DynamicArrayIoTest, RoundTripWithCodec)
+{
+    DynamicArray<Record> arr(mr);
+    arr.push_back({"Иван", 25});
+    arr.push_back({"", 0});
+    arr.push_back({std::string(1000, 'x'), -7});
+    save_array(path, arr);
+
+    DynamicArray<Record> loaded(mr);
+    load_array(path, loaded);
+
+    ASSERT_EQ(loaded.size(), 3);
+    EXPECT_EQ(loaded[0].name, "Иван");
+    EXPECT_EQ(loaded[0].value, 25);
+    EXPECT_EQ(loaded[1].name, "");
+    EXPECT_EQ(loaded[2].name.size(), 1000);
+    EXPECT_EQ(loaded[2].value, -7);
+}
+
+TEST_F(DynamicArrayIoTest, TypeMismatchThrows)
+{
+    DynamicArray<int> arr(mr);
+    arr.push_back(1);
+    save_array(path, arr);
+
+    DynamicArray<float> wrong(mr);
+    EXPECT_THROW(load_array(path, wrong), std::runtime_error);
+    EXPECT_THROW(MappedArray<unsigned int>{path}, std::runtime_error);
+}
+
+TEST_F(DynamicArrayIoTest, CorruptedPayloadThrows)
+{
+    DynamicArray<int> arr(mr);
+    for (int i = 0; i < 16; ++i)
+    {
+        arr.push_back(i);
+    }
+    save_array(path, arr);
+
+    // Портим последний байт payload
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('\x7F');
+    }
+
+    DynamicArray<int> loaded(mr);
+    EXPECT_THROW(load_array(path, loaded), std::runtime_error);
+    EXPECT_THROW(MappedArray<int>{path}, std::runtime_error);
+}
+
+TEST_F(DynamicArrayIoTest, CraftedHeaderThrows)
+{
+    DynamicArray<int> arr(mr);
+    for (int i = 0; i < 16; ++i)
+    {
+        arr.push_back(i);
+    }
+    save_array(path, arr);
+
+    ArrayFileHeader saved{};
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char *>(&saved), sizeof(saved));
+    }
+    auto rewrite = [this](const ArrayFileHeader &header)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    };
+    DynamicArray<int> loaded(mr);
+
+    // count * sizeof(int) переполняется и совпадает с настоящим размером payload
+    ArrayFileHeader header = saved;
+    header.count += uint64_t(1) << 62;
+    rewrite(header);
+    EXPECT_THROW(load_array(path, loaded), std::runtime_error);
+    EXPECT_THROW(MappedArray<int>{path}, std::runtime_error);
+
+    // payload_offset + payload_bytes переполняется
+    header = saved;
+    header.payload_offset = UINT64_MAX - 8;
+    rewrite(header);
+    EXPECT_THROW(load_array(path, loaded), std::runtime_error);
+
+    // Смещение внутри файла, но не то, что пишет save_array (и не кратно alignof(int))
+    header = saved;
+    header.payload_offset = saved.payload_offset - 1;
+    rewrite(header);
+    EXPECT_THROW(MappedArray<int>{path}, std::runtime_error);
+
+    rewrite(saved);
+    load_array(path, loaded);
+    EXPECT_EQ(loaded.size(), 16u);
+}
+
+TEST_F(DynamicArrayIoTest, CodecCountIsNotTrustedForReserve)
+{
+    DynamicArray<Record> arr(mr);
+    arr.push_back({"один", 1});
+    save_array(path, arr);
+
+    ArrayFileHeader header{};
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+        header.count = UINT64_MAX / 2;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    // Без ограничения reserve(count) бросил бы bad_alloc/length_error вместо ошибки формата
+    DynamicArray<Record> loaded(mr);
+    EXPECT_THROW(load_array(path, loaded), std::runtime_error);
+}
+
+TEST_F(DynamicArrayIoTest, MissingFileThrows)
+{
+    DynamicArray<int> loaded(mr);
+    EXPECT_THROW(load_array(path + ".missing", loaded), std::runtime_error);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "dynamic_array_view.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// Тесты для DynamicArrayView
+class DynamicArrayViewTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+    DynamicArray<int> *arr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+        arr = new DynamicArray<int>(mr);
+        for (int i = 0; i < 10; ++i)
+        {
+            arr->push_back(i);
+        }
+    }
+
+    void TearDown() override
+    {
+        delete arr;
+        delete mr;
+    }
+};
+
+TEST_F(DynamicArrayViewTest, ViewOverWholeArray)
+{
+    size_t blocks = mr->get_allocated_blocks_count();
+
+    DynamicArrayView<int> view(*arr);
+
+    EXPECT_EQ(view.size(), 10);
+    EXPECT_EQ(view.data(), arr->data());
+    EXPECT_EQ(view.front(), 0);
+    EXPECT_EQ(view.back(), 9);
+    // Представление не выделяет память
+    EXPECT_EQ(mr->get_allocated_blocks_count(), blocks);
+}
+
+TEST_F(DynamicArrayViewTest, WritesGoToArray)
+{
+    DynamicArrayView<int> view(*arr);
+    view[3] = 100;
+    for (auto &value : view.subspan(5))
+    {
+        value = -1;
+    }
+
+    EXPECT_EQ((*arr)[3], 100);
+    EXPECT_EQ((*arr)[4], 4);
+    EXPECT_EQ((*arr)[9], -1);
+}
+
+TEST_F(DynamicArrayViewTest, ConstView)
+{
+    const DynamicArray<int> &const_arr = *arr;
+    DynamicArrayView view(const_arr);
+
+    static_assert(std::is_same<decltype(view), DynamicArrayView<const int>>::value, "");
+    static_assert(std::is_same<decltype(view.begin()), DynamicArray<int>::ConstIterator>::value, "");
+
+    DynamicArrayView<int> mutable_view(*arr);
+    DynamicArrayView<const int> converted = mutable_view;
+    EXPECT_EQ(std::accumulate(converted.begin(), converted.end(), 0), 45);
+}
+
+TEST_F(DynamicArrayViewTest, FromIterators)
+{
+    DynamicArrayView<int> view(arr->begin() + 2, arr->begin() + 5);
+    EXPECT_EQ(view.size(), 3);
+    EXPECT_EQ(view[0], 2);
+
+    DynamicArrayView<const int> const_view(arr->cbegin() + 8, arr->cend());
+    EXPECT_EQ(const_view.size(), 2);
+    EXPECT_EQ(const_view[1], 9);
+}
+
+TEST_F(DynamicArrayViewTest, Subspan)
+{
+    DynamicArrayView<int> view(*arr);
+
+    auto middle = view.subspan(2, 3);
+    EXPECT_EQ(middle.size(), 3);
+    EXPECT_EQ(middle[0], 2);
+    EXPECT_EQ(middle[2], 4);
+
+    EXPECT_EQ(view.subspan(8, 100).size(), 2);
+    EXPECT_EQ(view.subspan(10).size(), 0);
+    EXPECT_THROW(view.subspan(11), std::out_of_range);
+
+    EXPECT_EQ(view.first(4).back(), 3);
+    EXPECT_EQ(view.last(2).front(), 8);
+    EXPECT_THROW(middle.at(3), std::out_of_range);
+}
+
+TEST_F(DynamicArrayViewTest, Strided)
+{
+    DynamicArrayView<int> view(*arr);
+
+    auto even = view.strided(2);
+    EXPECT_EQ(even.size(), 5);
+    EXPECT_EQ(even[4], 8);
+
+    auto odd = view.strided(3, 1);
+    std::vector<int> values(odd.begin(), odd.end());
+    EXPECT_EQ(values, (std::vector<int>{1, 4, 7}));
+    EXPECT_EQ(odd.end() - odd.begin(), 3);
+
+    EXPECT_TRUE(view.strided(2, 10).empty());
+    EXPECT_THROW(view.strided(0), std::invalid_argument);
+}
+
+TEST_F(DynamicArrayViewTest, Chunks)
+{
+    DynamicArrayView<int> view(*arr);
+    auto chunks = view.chunks(4);
+
+    EXPECT_EQ(chunks.size(), 3);
+    EXPECT_EQ(chunks[0].size(), 4);
+    EXPECT_EQ(chunks[2].size(), 2);
+    EXPECT_EQ(chunks[2][1], 9);
+
+    size_t total = 0;
+    size_t count = 0;
+    for (auto chunk : chunks)
+    {
+        total += chunk.size();
+        ++count;
+    }
+    EXPECT_EQ(total, 10);
+    EXPECT_EQ(count, 3);
+    EXPECT_THROW(view.chunks(0), std::invalid_argument);
+}
+
+TEST_F(DynamicArrayViewTest, ParallelChunks)
+{
+    DynamicArray<long long> big(mr);
+    big.resize(10000);
+    std::iota(big.begin(), big.end(), 0);
+
+    auto chunks = DynamicArrayView<long long>(big).chunks(2500);
+    std::vector<long long> sums(chunks.size());
+    std::vector<std::thread> workers;
+
+    // Каждый поток обрабатывает свой кусок без копирования
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        workers.emplace_back([&, i]()
+                             {
+                                 auto chunk = chunks[i];
+                                 sums[i] = std::accumulate(chunk.begin(), chunk.end(), 0LL);
+                             });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), 0LL), 10000LL * 9999 / 2);
+}
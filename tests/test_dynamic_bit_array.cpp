@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+#include "dynamic_bit_array.h"
+#include "custom_memory_resource.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Тесты для DynamicBitArray
+class DynamicBitArrayTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+
+    // Случайный массив битов и его эталон
+    DynamicBitArray make_random(size_t size, unsigned seed, std::vector<bool> &expected)
+    {
+        std::mt19937 rng(seed);
+        DynamicBitArray bits(mr);
+        expected.clear();
+        for (size_t i = 0; i < size; ++i)
+        {
+            bool value = rng() % 3 == 0;
+            bits.push_back(value);
+            expected.push_back(value);
+        }
+        return bits;
+    }
+};
+
+TEST_F(DynamicBitArrayTest, PushBackAndAccess)
+{
+    std::vector<bool> expected;
+    DynamicBitArray bits = make_random(1000, 1, expected);
+    ASSERT_EQ(bits.size(), 1000u);
+    EXPECT_EQ(bits.words_count(), 16u);
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(bits[i], expected[i]) << "индекс " << i;
+    }
+
+    size_t index = 0;
+    for (bool value : bits)
+    {
+        ASSERT_EQ(value, expected[index++]);
+    }
+    EXPECT_EQ(index, 1000u);
+}
+
+TEST_F(DynamicBitArrayTest, ProxyReference)
+{
+    DynamicBitArray bits(130, false, mr);
+    bits[3] = true;
+    bits[129] = true;
+    bits[64] = bits[3];
+    EXPECT_TRUE(bits[3]);
+    EXPECT_TRUE(bits.test(64));
+    EXPECT_TRUE(bits.test(129));
+
+    bits[3].flip();
+    EXPECT_FALSE(bits.test(3));
+    EXPECT_TRUE(~bits[3]);
+
+    bits.set(10);
+    bits.flip(11);
+    bits.reset(129);
+    EXPECT_EQ(bits.count(), 3u);
+
+    EXPECT_THROW(bits.at(130), std::out_of_range);
+    EXPECT_THROW(std::as_const(bits).at(130), std::out_of_range);
+}
+
+TEST_F(DynamicBitArrayTest, CountMatchesReference)
+{
+    for (size_t size : {0u, 1u, 63u, 64u, 65u, 255u, 256u, 257u, 1000u, 4099u})
+    {
+        std::vector<bool> expected;
+        DynamicBitArray bits = make_random(size, static_cast<unsigned>(size), expected);
+        size_t ones = 0;
+        for (bool value : expected)
+        {
+            ones += value;
+        }
+        EXPECT_EQ(bits.count(), ones) << "размер " << size;
+    }
+}
+
+TEST_F(DynamicBitArrayTest, EveryPopcountPathAgrees)
+{
+    std::mt19937_64 rng(2);
+    std::vector<uint64_t> words(1000);
+    for (uint64_t &word : words)
+    {
+        word = rng();
+    }
+    words[7] = ~uint64_t(0);
+
+    for (PopcountPath path : {PopcountPath::Portable, PopcountPath::Popcnt, PopcountPath::Avx2, PopcountPath::Avx512})
+    {
+        if (!bit_array_detail::popcount_supported(path))
+        {
+            continue;
+        }
+        // Все длины хвоста для векторных путей
+        for (size_t count = 0; count <= 17; ++count)
+        {
+            ASSERT_EQ(bit_array_detail::popcount_words(path, words.data(), count),
+                      bit_array_detail::popcount_portable(words.data(), count));
+        }
+        EXPECT_EQ(bit_array_detail::popcount_words(path, words.data(), words.size()),
+                  bit_array_detail::popcount_portable(words.data(), words.size()));
+    }
+}
+
+TEST_F(DynamicBitArrayTest, FindFirstAndNext)
+{
+    DynamicBitArray bits(300, false, mr);
+    EXPECT_EQ(bits.find_first(), 300u);
+
+    const std::vector<size_t> ones = {5, 63, 64, 200, 299};
+    for (size_t index : ones)
+    {
+        bits.set(index);
+    }
+    std::vector<size_t> found;
+    for (size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i))
+    {
+        found.push_back(i);
+    }
+    EXPECT_EQ(found, ones);
+
+    std::vector<size_t> visited;
+    bits.for_each_set([&visited](size_t index)
+                      { visited.push_back(index); });
+    EXPECT_EQ(visited, ones);
+}
+
+TEST_F(DynamicBitArrayTest, BitwiseOperations)
+{
+    std::vector<bool> ea;
+    std::vector<bool> eb;
+    DynamicBitArray a = make_random(777, 3, ea);
+    DynamicBitArray b = make_random(777, 4, eb);
+
+    DynamicBitArray both = a & b;
+    DynamicBitArray either = a | b;
+    DynamicBitArray diff = a ^ b;
+    for (size_t i = 0; i < ea.size(); ++i)
+    {
+        ASSERT_EQ(both[i], ea[i] && eb[i]);
+        ASSERT_EQ(either[i], ea[i] || eb[i]);
+        ASSERT_EQ(diff[i], ea[i] != eb[i]);
+    }
+    EXPECT_EQ(diff, (a | b) ^ (a & b));
+
+    DynamicBitArray shorter(10, false, mr);
+    EXPECT_THROW(a &= shorter, std::invalid_argument);
+}
+
+TEST_F(DynamicBitArrayTest, TailStaysClear)
+{
+    DynamicBitArray bits(70, true, mr);
+    EXPECT_TRUE(bits.all());
+    EXPECT_EQ(bits.count(), 70u);
+
+    bits.flip_all();
+    EXPECT_TRUE(bits.none());
+
+    bits.set_all();
+    bits.resize(66);
+    EXPECT_EQ(bits.count(), 66u);
+    bits.resize(140);
+    EXPECT_EQ(bits.count(), 66u);
+    EXPECT_FALSE(bits.all());
+    bits.resize(200, true);
+    EXPECT_EQ(bits.count(), 66u + 60u);
+
+    bits.pop_back();
+    EXPECT_EQ(bits.count(), 125u);
+    bits.reset_all();
+    EXPECT_FALSE(bits.any());
+    EXPECT_EQ(bits.find_first(), bits.size());
+}
+
+TEST_F(DynamicBitArrayTest, FromBoolArrayAndResource)
+{
+    DynamicArray<bool> flags(mr);
+    for (int i = 0; i < 100; ++i)
+    {
+        flags.push_back(i % 7 == 0);
+    }
+    DynamicBitArray bits(flags);
+    EXPECT_EQ(bits.size(), 100u);
+    EXPECT_EQ(bits.count(), 15u);
+    EXPECT_TRUE(bits[49]);
+    EXPECT_EQ(bits.get_allocator().resource(), mr);
+
+    // Восьмая часть памяти DynamicArray<bool>
+    const size_t before = mr->get_total_allocated_bytes();
+    DynamicBitArray large(80000, false, mr);
+    EXPECT_EQ(mr->get_total_allocated_bytes() - before, 10000u);
+
+    DynamicBitArray copy(bits);
+    EXPECT_EQ(copy, bits);
+    copy.flip(0);
+    EXPECT_NE(copy, bits);
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+}
+
+TEST_F(DynamicBitArrayTest, MoveLeavesSourceEmpty)
+{
+    std::vector<bool> expected;
+    DynamicBitArray source = make_random(1000, 7, expected);
+    DynamicBitArray moved(std::move(source));
+    EXPECT_EQ(moved.size(), 1000u);
+    EXPECT_EQ(source.size(), 0u);
+    EXPECT_EQ(source.words_count(), 0u);
+    EXPECT_EQ(source.count(), 0u);
+    EXPECT_EQ(source.find_first(), source.size());
+
+    // Тот же ресурс: буфер перенимается без копирования
+    DynamicBitArray target(5, true, mr);
+    const size_t before = mr->get_total_allocated_bytes();
+    target = std::move(moved);
+    EXPECT_EQ(mr->get_total_allocated_bytes(), before);
+    EXPECT_EQ(moved.size(), 0u);
+    EXPECT_EQ(moved.words_count(), 0u);
+    ASSERT_EQ(target.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_EQ(target[i], expected[i]) << "индекс " << i;
+    }
+
+    // Другой ресурс: слова копируются, ресурс массива не меняется
+    CustomMemoryResource other;
+    {
+        DynamicBitArray foreign(&other);
+        foreign = std::move(target);
+        EXPECT_EQ(foreign.get_allocator().resource(), &other);
+        EXPECT_EQ(foreign.size(), expected.size());
+        EXPECT_EQ(foreign.count(), static_cast<size_t>(std::count(expected.begin(), expected.end(), true)));
+        EXPECT_EQ(target.size(), 0u);
+        EXPECT_EQ(target.words_count(), 0u);
+    }
+
+    // Опустевший массив снова пригоден к работе
+    source.push_back(true);
+    EXPECT_EQ(source.size(), 1u);
+    EXPECT_EQ(source.count(), 1u);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "epoch_reclamation.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Тесты для EpochDomain и SnapshotPublisher
+class EpochReclamationTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+};
+
+TEST_F(EpochReclamationTest, RetiredBufferFreedWithoutReaders)
+{
+    EpochDomain domain(mr);
+
+    void *ptr = mr->allocate(128);
+    domain.retire(ptr, 128);
+
+    // Без читателей эпоха продвигается на каждом вызове
+    domain.try_reclaim();
+    domain.try_reclaim();
+
+    EXPECT_EQ(domain.get_retired_count(), 0);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 0);
+    EXPECT_EQ(mr->get_free_blocks_count(), 1);
+}
+
+TEST_F(EpochReclamationTest, PinnedReaderDelaysReclamation)
+{
+    EpochDomain domain(mr);
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&]()
+                       {
+                           auto guard = domain.pin();
+                           pinned = true;
+                           while (!release)
+                           {
+                               std::this_thread::yield();
+                           }
+                       });
+    while (!pinned)
+    {
+        std::this_thread::yield();
+    }
+
+    void *ptr = mr->allocate(64);
+    domain.retire(ptr, 64);
+    for (int i = 0; i < 10; ++i)
+    {
+        domain.try_reclaim();
+    }
+
+    // Читатель застрял в старой эпохе - буфер должен оставаться занятым
+    EXPECT_EQ(domain.get_retired_count(), 1);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 1);
+
+    release = true;
+    reader.join();
+
+    domain.try_reclaim();
+    domain.try_reclaim();
+    EXPECT_EQ(domain.get_retired_count(), 0);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 0);
+}
+
+TEST_F(EpochReclamationTest, NestedPins)
+{
+    EpochDomain domain(mr);
+    {
+        auto outer = domain.pin();
+        {
+            auto inner = domain.pin();
+        }
+        domain.retire(mr->allocate(32), 32);
+        for (int i = 0; i < 5; ++i)
+        {
+            domain.try_reclaim();
+        }
+        // Внешний pin ещё действует
+        EXPECT_EQ(domain.get_retired_count(), 1);
+    }
+    domain.try_reclaim();
+    domain.try_reclaim();
+    EXPECT_EQ(domain.get_retired_count(), 0);
+}
+
+TEST_F(EpochReclamationTest, RetireDynamicArray)
+{
+    EpochDomain domain(mr);
+    {
+        DynamicArray<int> arr(mr);
+        arr.resize(100, 7);
+        domain.retire(std::move(arr));
+    }
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 1);
+
+    domain.try_reclaim();
+    domain.try_reclaim();
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 0);
+}
+
+TEST_F(EpochReclamationTest, SnapshotPublisherWithReaders)
+{
+    EpochDomain domain(mr);
+    SnapshotPublisher<int> publisher(domain);
+
+    {
+        DynamicArray<int> first(mr);
+        first.resize(1000, 0);
+        publisher.publish(std::move(first));
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<long long> reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&]()
+                             {
+                                 while (!stop)
+                                 {
+                                     auto guard = domain.pin();
+                                     const DynamicArray<int> *snapshot = publisher.current();
+                                     // Все элементы снимка одинаковые: читатель не должен увидеть смесь
+                                     int first = (*snapshot)[0];
+                                     int last = (*snapshot)[snapshot->size() - 1];
+                                     EXPECT_EQ(first, last);
+                                     ++reads;
+                                 }
+                             });
+    }
+
+    // Единственный писатель: только он выделяет память из mr
+    for (int version = 1; version <= 200; ++version)
+    {
+        DynamicArray<int> next(mr);
+        next.resize(1000, version);
+        publisher.publish(std::move(next));
+    }
+
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    domain.try_reclaim();
+    domain.try_reclaim();
+    EXPECT_GT(domain.get_reclaimed_count(), 0);
+    EXPECT_EQ(domain.get_retired_count(), 0);
+
+    auto guard = domain.pin();
+    EXPECT_EQ((*publisher.current())[0], 200);
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "flat_map.h"
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// Тесты для FlatMap; каждый тест проверяет обе раскладки
+class FlatMapTest : public ::testing::TestWithParam<FlatMapLayout>
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+};
+
+TEST_P(FlatMapTest, BuildAndFind)
+{
+    FlatMap<int, std::string> map(mr, GetParam());
+    map.insert(30, "тридцать");
+    map.insert(10, "десять");
+    map.insert(20, "двадцать");
+    map.build();
+
+    EXPECT_EQ(map.size(), 3);
+    ASSERT_NE(map.find(20), nullptr);
+    EXPECT_EQ(*map.find(20), "двадцать");
+    EXPECT_EQ(map.at(10), "десять");
+    EXPECT_EQ(map.find(15), nullptr);
+    EXPECT_EQ(map.find(5), nullptr);
+    EXPECT_EQ(map.find(40), nullptr);
+    EXPECT_THROW(map.at(15), std::out_of_range);
+}
+
+TEST_P(FlatMapTest, MatchesStdMap)
+{
+    std::mt19937 rng(7);
+    std::map<uint32_t, uint32_t> reference;
+    FlatMap<uint32_t, uint32_t> map(mr, GetParam());
+    for (int i = 0; i < 5000; ++i)
+    {
+        uint32_t key = rng() % 20000;
+        reference[key] = static_cast<uint32_t>(i);
+        map.insert(key, static_cast<uint32_t>(i));
+    }
+    map.build();
+
+    // Для повторных ключей остаётся последнее значение, как у reference[key] = i
+    ASSERT_EQ(map.size(), reference.size());
+    for (uint32_t key = 0; key < 20000; ++key)
+    {
+        auto it = reference.find(key);
+        const uint32_t *value = map.find(key);
+        if (it == reference.end())
+        {
+            ASSERT_EQ(value, nullptr) << key;
+        }
+        else
+        {
+            ASSERT_NE(value, nullptr) << key;
+            ASSERT_EQ(*value, it->second) << key;
+        }
+    }
+}
+
+TEST_P(FlatMapTest, BatchLookupMatchesSingle)
+{
+    FlatMap<uint64_t, int> map(mr, GetParam());
+    for (int i = 0; i < 1000; ++i)
+    {
+        map.insert(static_cast<uint64_t>(i) * 3, i);
+    }
+    map.build();
+
+    // 37 запросов: две полные группы и неполная
+    std::vector<uint64_t> queries;
+    for (uint64_t q = 0; q < 37; ++q)
+    {
+        queries.push_back(q * 83);
+    }
+    std::vector<const int *> results(queries.size());
+    map.find_batch(queries.data(), queries.size(), results.data());
+
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        EXPECT_EQ(results[i], map.find(queries[i])) << queries[i];
+    }
+}
+
+TEST_P(FlatMapTest, SizesAroundPowersOfTwo)
+{
+    for (size_t n : {0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 100})
+    {
+        FlatMap<int, int> map(mr, GetParam());
+        for (size_t i = 0; i < n; ++i)
+        {
+            map.insert(static_cast<int>(i * 2), static_cast<int>(i));
+        }
+        map.build();
+
+        std::vector<int> queries;
+        for (int q = -1; q <= static_cast<int>(n * 2); ++q)
+        {
+            queries.push_back(q);
+        }
+        std::vector<const int *> results(queries.size());
+        map.find_batch(queries.data(), queries.size(), results.data());
+
+        for (size_t i = 0; i < queries.size(); ++i)
+        {
+            const int q = queries[i];
+            const bool present = q >= 0 && q % 2 == 0 && q < static_cast<int>(n * 2);
+            ASSERT_EQ(map.contains(q), present) << "n=" << n << " q=" << q;
+            ASSERT_EQ(results[i] != nullptr, present) << "n=" << n << " q=" << q;
+            if (present)
+            {
+                ASSERT_EQ(*results[i], q / 2);
+            }
+        }
+    }
+}
+
+TEST_P(FlatMapTest, ForEachIsOrdered)
+{
+    FlatMap<int, int> map(mr, GetParam());
+    for (int key : {5, 3, 9, 1, 7, 2})
+    {
+        map.insert(key, key * 10);
+    }
+    map.build();
+
+    std::vector<int> keys;
+    map.for_each([&keys](int key, int value)
+                 {
+                     EXPECT_EQ(value, key * 10);
+                     keys.push_back(key); });
+    EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 5, 7, 9}));
+}
+
+TEST_P(FlatMapTest, IncrementalBuildOverridesValues)
+{
+    FlatMap<int, int> map(mr, GetParam());
+    map.insert(1, 100);
+    map.insert(2, 200);
+    map.build();
+
+    map.insert(2, 201);
+    map.insert(3, 300);
+    EXPECT_THROW(map.find(1), std::logic_error);
+    map.build();
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.at(1), 100);
+    EXPECT_EQ(map.at(2), 201);
+    EXPECT_EQ(map.at(3), 300);
+}
+
+TEST_P(FlatMapTest, StorageFromResource)
+{
+    size_t before = mr->get_allocated_blocks_count();
+    {
+        std::vector<std::pair<int, double>> source = {{1, 1.5}, {2, 2.5}, {3, 3.5}};
+        FlatMap<int, double> map(source.begin(), source.end(), mr, GetParam());
+        EXPECT_EQ(map.at(2), 2.5);
+        // Ключи и значения - два массива из mr; временный буфер сортировки уже освобождён
+        EXPECT_EQ(mr->get_allocated_blocks_count(), before + 2);
+    }
+    EXPECT_EQ(mr->get_allocated_blocks_count(), before);
+}
+
+INSTANTIATE_TEST_SUITE_P(Layouts, FlatMapTest,
+                         ::testing::Values(FlatMapLayout::Sorted, FlatMapLayout::Eytzinger),
+                         [](const ::testing::TestParamInfo<FlatMapLayout> &info)
+                         { return info.param == FlatMapLayout::Sorted ? "Sorted" : "Eytzinger"; });
+
+TEST(FlatMapLayoutTest, SwitchLayoutKeepsContent)
+{
+    CustomMemoryResource mr;
+    FlatMap<int, int> map(&mr, FlatMapLayout::Sorted);
+    for (int i = 0; i < 100; ++i)
+    {
+        map.insert(i, -i);
+    }
+    map.build();
+
+    map.set_layout(FlatMapLayout::Eytzinger);
+    EXPECT_EQ(map.get_layout(), FlatMapLayout::Eytzinger);
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(map.at(i), -i);
+    }
+
+    map.set_layout(FlatMapLayout::Sorted);
+    EXPECT_EQ(map.at(42), -42);
+    EXPECT_EQ(map.size(), 100);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include "growth_stats.h"
+#include <sstream>
+
+// Тесты для GrowthRegistry. Учёт в самом DynamicArray проверяется только
+// в сборке с -DLAB5_GROWTH_STATS=ON.
+class GrowthStatsTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+};
+
+TEST_F(GrowthStatsTest, CountersAggregate)
+{
+    GrowthCounters &counters = GrowthRegistry::instance().counters("test.aggregate");
+    counters.reset();
+
+    counters.on_allocate(4);
+    counters.on_reallocate(4, 16, 8);
+    counters.on_reallocate(8, 32, 16);
+    counters.on_release(12, 16);
+
+    EXPECT_EQ(counters.get_allocations_count(), 1);
+    EXPECT_EQ(counters.get_reallocations_count(), 2);
+    EXPECT_EQ(counters.get_elements_moved(), 12);
+    EXPECT_EQ(counters.get_bytes_moved(), 48);
+    EXPECT_EQ(counters.get_peak_capacity(), 16);
+    EXPECT_EQ(counters.get_arrays_count(), 1);
+    EXPECT_DOUBLE_EQ(counters.get_wasted_capacity_ratio(), 0.25);
+    EXPECT_DOUBLE_EQ(counters.get_reallocations_per_array(), 2.0);
+    EXPECT_EQ(counters.get_reserve_hint(), 12);
+}
+
+TEST_F(GrowthStatsTest, ReserveHintIgnoresSinglePeak)
+{
+    GrowthCounters &counters = GrowthRegistry::instance().counters("test.peak");
+    counters.reset();
+    counters.on_release(1000, 1024);
+    for (int i = 0; i < 9; ++i)
+    {
+        counters.on_release(10, 16);
+    }
+
+    // Среднее (1000 + 9 * 10) / 10 = 109, а не пик 1000
+    EXPECT_EQ(counters.get_max_final_size(), 1000);
+    EXPECT_EQ(counters.get_reserve_hint(), 109);
+}
+
+TEST_F(GrowthStatsTest, SameTagSameCounters)
+{
+    GrowthRegistry &registry = GrowthRegistry::instance();
+    EXPECT_EQ(&registry.counters("test.same"), &registry.counters("test.same"));
+    EXPECT_NE(&registry.counters("test.same"), &registry.counters("test.other"));
+    EXPECT_EQ(registry.find("test.never_used"), nullptr);
+    EXPECT_EQ(registry.reserve_hint("test.never_used"), 0);
+}
+
+TEST_F(GrowthStatsTest, DumpListsTags)
+{
+    GrowthCounters &counters = GrowthRegistry::instance().counters("test.dump");
+    counters.reset();
+    counters.on_reallocate(3, 12, 6);
+
+    std::ostringstream out;
+    GrowthRegistry::instance().dump(out);
+    EXPECT_NE(out.str().find("test.dump | 0 | 1 | 3 | 12 | 6 |"), std::string::npos);
+}
+
+TEST_F(GrowthStatsTest, TypeTagIsReadable)
+{
+    GrowthCounters &counters = growth_stats_detail::type_counters<double>();
+    EXPECT_EQ(GrowthRegistry::instance().find("double"), &counters);
+}
+
+TEST_F(GrowthStatsTest, TaggingWorksInEveryBuild)
+{
+    DynamicArray<int> arr(mr);
+    arr.set_growth_tag("test.any_build");
+    arr.reserve_growth_hint();
+    arr.push_back(1);
+    EXPECT_EQ(arr[0], 1);
+}
+
+#ifdef LAB5_GROWTH_STATS
+TEST_F(GrowthStatsTest, DynamicArrayRecordsGrowth)
+{
+    GrowthCounters &counters = GrowthRegistry::instance().counters("test.push_back");
+    counters.reset();
+    {
+        DynamicArray<int> arr(mr);
+        arr.set_growth_tag("test.push_back");
+        for (int i = 0; i < 100; ++i)
+        {
+            arr.push_back(i);
+        }
+    }
+
+    // Ёмкость 1, 2, 4, ..., 128: одно выделение и 7 переносов
+    EXPECT_EQ(counters.get_allocations_count(), 1);
+    EXPECT_EQ(counters.get_reallocations_count(), 7);
+    EXPECT_EQ(counters.get_elements_moved(), 1 + 2 + 4 + 8 + 16 + 32 + 64);
+    EXPECT_EQ(counters.get_bytes_moved(), counters.get_elements_moved() * sizeof(int));
+    EXPECT_EQ(counters.get_peak_capacity(), 128);
+    EXPECT_EQ(counters.get_arrays_count(), 1);
+    EXPECT_DOUBLE_EQ(counters.get_wasted_capacity_ratio(), 1.0 - 100.0 / 128.0);
+}
+
+TEST_F(GrowthStatsTest, ReserveHintRemovesReallocations)
+{
+    GrowthCounters &counters = GrowthRegistry::instance().counters("test.hint");
+    counters.reset();
+    for (int round = 0; round < 2; ++round)
+    {
+        DynamicArray<int> arr(mr);
+        arr.set_growth_tag("test.hint");
+        arr.reserve_growth_hint();
+        for (int i = 0; i < 50; ++i)
+        {
+            arr.push_back(i);
+        }
+    }
+
+    // Первый массив рос удвоением, второй сразу получил ёмкость 50
+    EXPECT_EQ(counters.get_reallocations_count(), 6);
+    EXPECT_EQ(counters.get_allocations_count(), 2);
+    EXPECT_EQ(counters.get_reserve_hint(), 50);
+}
+
+TEST_F(GrowthStatsTest, MovedArrayKeepsTag)
+{
+    GrowthCounters &counters = GrowthRegistry::instance().counters("test.moved");
+    counters.reset();
+    {
+        DynamicArray<int> source(mr);
+        source.set_growth_tag("test.moved");
+        source.push_back(1);
+        DynamicArray<int> target(std::move(source));
+        target.push_back(2);
+    }
+
+    EXPECT_EQ(counters.get_reallocations_count(), 1);
+    EXPECT_EQ(counters.get_arrays_count(), 1);
+}
+
+TEST_F(GrowthStatsTest, AdoptedBufferIsCounted)
+{
+    struct Adopted
+    {
+        int value;
+    };
+    GrowthCounters &counters = growth_stats_detail::type_counters<Adopted>();
+    counters.reset();
+    {
+        void *buffer = mr->allocate(8 * sizeof(Adopted), alignof(Adopted));
+        DynamicArray<Adopted> arr(adopt_buffer, static_cast<Adopted *>(buffer), 8, mr);
+        arr.push_back({1});
+    }
+
+    // Принятый буфер - такое же выделение, как собственный
+    EXPECT_EQ(counters.get_allocations_count(), 1);
+    EXPECT_EQ(counters.get_arrays_count(), 1);
+    EXPECT_EQ(counters.get_peak_capacity(), 8);
+}
+#endif
@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include <cstdint>
+
+// Тесты для усиленного режима CustomMemoryResource
+class HeapHardeningTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+        HardeningOptions options;
+        options.canaries = true;
+        options.poison = true;
+        mr->set_hardening(options);
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+
+    // Ожидает HeapCorruptionError нужного вида
+    template <typename F>
+    static void expect_error(HeapErrorKind kind, F &&f)
+    {
+        try
+        {
+            f();
+            FAIL() << "ожидалась ошибка " << heap_error_name(kind);
+        }
+        catch (const HeapCorruptionError &error)
+        {
+            EXPECT_EQ(error.kind(), kind) << error.what();
+        }
+    }
+};
+
+// Освобождение не бросает даже при HardeningAction::Throw: отчёт и abort
+#define EXPECT_RELEASE_ERROR(kind, statement) EXPECT_DEATH(statement, heap_error_name(kind))
+
+TEST_F(HeapHardeningTest, DisabledByDefault)
+{
+    CustomMemoryResource plain;
+#ifndef LAB5_HARDENED
+    EXPECT_FALSE(plain.get_hardening().enabled());
+#else
+    EXPECT_TRUE(plain.get_hardening().enabled());
+#endif
+}
+
+TEST_F(HeapHardeningTest, CleanAllocationPasses)
+{
+    char *ptr = static_cast<char *>(mr->allocate(100));
+    for (int i = 0; i < 100; ++i)
+    {
+        ptr[i] = 'x';
+    }
+    EXPECT_EQ(mr->check_heap(), 0);
+    mr->deallocate(ptr, 100);
+    EXPECT_EQ(mr->get_hardening_errors_count(), 0);
+    EXPECT_EQ(mr->get_free_blocks_count(), 1);
+}
+
+TEST_F(HeapHardeningTest, AlignmentPreserved)
+{
+    void *ptr = mr->allocate(40, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0);
+    mr->deallocate(ptr, 40, 64);
+}
+
+TEST_F(HeapHardeningTest, OverflowDetected)
+{
+    char *ptr = static_cast<char *>(mr->allocate(32));
+    ptr[32] = 'x';
+    EXPECT_RELEASE_ERROR(HeapErrorKind::BufferOverflow, mr->deallocate(ptr, 32));
+}
+
+TEST_F(HeapHardeningTest, UnderflowDetected)
+{
+    char *ptr = static_cast<char *>(mr->allocate(32));
+    ptr[-1] = 'x';
+    EXPECT_RELEASE_ERROR(HeapErrorKind::BufferUnderflow, mr->deallocate(ptr, 32));
+}
+
+TEST_F(HeapHardeningTest, OverflowWithinReusedBlockSlack)
+{
+#if LAB5_ASAN
+    GTEST_SKIP() << "под ASan запись в отравленную память ловит сам санитайзер";
+#endif
+    void *big = mr->allocate(64);
+    mr->deallocate(big, 64);
+
+    // Блок на 64 байта выдаётся под 16: канарейка переезжает на границу 16 байт
+    char *ptr = static_cast<char *>(mr->allocate(16));
+    ASSERT_EQ(ptr, big);
+    ptr[16] = 'x';
+    EXPECT_EQ(mr->get_hardening_errors_count(), 0);
+    EXPECT_RELEASE_ERROR(HeapErrorKind::BufferOverflow, mr->deallocate(ptr, 16));
+}
+
+TEST_F(HeapHardeningTest, DoubleFreeDetected)
+{
+    void *ptr = mr->allocate(32);
+    mr->deallocate(ptr, 32);
+    EXPECT_RELEASE_ERROR(HeapErrorKind::DoubleFree, mr->deallocate(ptr, 32));
+}
+
+TEST_F(HeapHardeningTest, InvalidFreeDetected)
+{
+    alignas(16) char foreign[32];
+    EXPECT_RELEASE_ERROR(HeapErrorKind::InvalidFree, mr->deallocate(foreign, 32));
+}
+
+TEST_F(HeapHardeningTest, SizeMismatchDetected)
+{
+    void *ptr = mr->allocate(32);
+    EXPECT_RELEASE_ERROR(HeapErrorKind::SizeMismatch, mr->deallocate(ptr, 48));
+    mr->deallocate(ptr, 32);
+}
+
+TEST_F(HeapHardeningTest, ReleaseErrorInDestructorDoesNotTerminate)
+{
+    // Под Throw исключение из деструктора DynamicArray привело бы к std::terminate без отчёта
+    EXPECT_RELEASE_ERROR(HeapErrorKind::BufferOverflow, {
+        DynamicArray<int> arr(mr);
+        arr.reserve(4);
+        arr.data()[4] = 42;
+    });
+}
+
+TEST_F(HeapHardeningTest, UseAfterFreeDetectedOnReuse)
+{
+#if LAB5_ASAN
+    GTEST_SKIP() << "под ASan запись в отравленную память ловит сам санитайзер";
+#endif
+    char *ptr = static_cast<char *>(mr->allocate(32));
+    mr->deallocate(ptr, 32);
+    ptr[5] = 'x';
+
+    expect_error(HeapErrorKind::UseAfterFree, [&]()
+                 { mr->check_heap(); });
+    expect_error(HeapErrorKind::UseAfterFree, [&]()
+                 { (void)mr->allocate(32); });
+
+    // Испорченный блок не теряется занятым: он остаётся свободным и выдаётся снова
+    EXPECT_EQ(mr->get_free_blocks_count(), 1);
+    void *again = mr->allocate(32);
+    EXPECT_EQ(again, ptr);
+    mr->deallocate(again, 32);
+}
+
+TEST_F(HeapHardeningTest, QuarantineDelaysReuse)
+{
+    CustomMemoryResource quarantined;
+    HardeningOptions options;
+    options.canaries = true;
+    options.quarantine_size = 2;
+    quarantined.set_hardening(options);
+
+    void *a = quarantined.allocate(32);
+    quarantined.deallocate(a, 32);
+    EXPECT_EQ(quarantined.get_quarantined_blocks_count(), 1);
+
+    // Блок a ещё в карантине - выдаётся новый
+    void *b = quarantined.allocate(32);
+    EXPECT_NE(b, a);
+    quarantined.deallocate(b, 32);
+
+    // Третье освобождение выталкивает a из карантина
+    void *c = quarantined.allocate(32);
+    quarantined.deallocate(c, 32);
+    EXPECT_EQ(quarantined.get_quarantined_blocks_count(), 2);
+
+    EXPECT_EQ(quarantined.allocate(32), a);
+}
+
+TEST_F(HeapHardeningTest, LogActionContinues)
+{
+    CustomMemoryResource logging;
+    HardeningOptions options;
+    options.canaries = true;
+    options.action = HardeningAction::Log;
+    logging.set_hardening(options);
+
+    void *ptr = logging.allocate(16);
+    logging.deallocate(ptr, 16);
+    logging.deallocate(ptr, 16);
+    EXPECT_EQ(logging.get_hardening_errors_count(), 1);
+}
+
+TEST_F(HeapHardeningTest, WritePastDynamicArrayCapacity)
+{
+    CustomMemoryResource logging;
+    HardeningOptions options;
+    options.canaries = true;
+    options.action = HardeningAction::Log;
+    logging.set_hardening(options);
+
+    {
+        DynamicArray<int> arr(&logging);
+        arr.reserve(4);
+        arr.data()[4] = 42; // Запись за capacity
+        EXPECT_EQ(logging.check_heap(), 1);
+    }
+    // Деструктор массива освободил буфер: канарейка проверена ещё раз
+    EXPECT_EQ(logging.get_hardening_errors_count(), 2);
+}
+
+TEST_F(HeapHardeningTest, BatchAllocationIsHardened)
+{
+    void *ptrs[4];
+    mr->allocate_batch(4, 24, 8, ptrs);
+    EXPECT_EQ(mr->get_chunks_count(), 0);
+
+    static_cast<char *>(ptrs[2])[24] = 'x';
+    expect_error(HeapErrorKind::BufferOverflow, [&]()
+                 { mr->check_heap(); });
+    EXPECT_RELEASE_ERROR(HeapErrorKind::BufferOverflow, mr->deallocate_batch(ptrs, 4, 24, 8));
+}
+
+TEST_F(HeapHardeningTest, ChangingModeAfterAllocationThrows)
+{
+    void *ptr = mr->allocate(8);
+    EXPECT_THROW(mr->set_hardening(HardeningOptions()), std::logic_error);
+    mr->deallocate(ptr, 8);
+}
+
+#if LAB5_HAS_MMAP
+TEST_F(HeapHardeningTest, GuardPageEndsLargeBlock)
+{
+    CustomMemoryResource guarded;
+    HardeningOptions options;
+    options.canaries = true;
+    options.guard_pages = true;
+    options.guard_page_threshold = 4096;
+    guarded.set_hardening(options);
+
+    const size_t bytes = 10000;
+    char *ptr = static_cast<char *>(guarded.allocate(bytes, 16));
+    EXPECT_EQ(guarded.get_mapped_blocks_count(), 1);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr + bytes) % PageAllocator::page_size(), 0);
+
+    ptr[bytes - 1] = 'x';
+    EXPECT_DEATH(ptr[bytes] = 'x', "");
+    guarded.deallocate(ptr, bytes, 16);
+}
+
+TEST_F(HeapHardeningTest, QuarantinedGuardedBlockIsInaccessible)
+{
+    CustomMemoryResource guarded;
+    HardeningOptions options;
+    options.guard_pages = true;
+    options.guard_page_threshold = 4096;
+    options.quarantine_size = 4;
+    guarded.set_hardening(options);
+
+    char *ptr = static_cast<char *>(guarded.allocate(8192));
+    guarded.deallocate(ptr, 8192);
+    EXPECT_DEATH(ptr[0] = 'x', "");
+    EXPECT_EQ(guarded.check_heap(), 0);
+}
+#endif
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Тесты для LatencyHistogram
+TEST(LatencyHistogramTest, EmptyHistogram)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.get_count(), 0u);
+    EXPECT_EQ(histogram.get_min(), 0u);
+    EXPECT_EQ(histogram.get_max(), 0u);
+    EXPECT_EQ(histogram.value_at_percentile(99.0), 0u);
+    EXPECT_DOUBLE_EQ(histogram.get_mean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; ++value)
+    {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.get_count(), 100u);
+    EXPECT_EQ(histogram.value_at_percentile(50.0), 50u);
+    EXPECT_EQ(histogram.value_at_percentile(99.0), 99u);
+    EXPECT_EQ(histogram.value_at_percentile(100.0), 100u);
+    EXPECT_EQ(histogram.value_at_percentile(0.0), 1u);
+    EXPECT_DOUBLE_EQ(histogram.get_mean(), 50.5);
+}
+
+TEST(LatencyHistogramTest, BucketsCoverWholeRange)
+{
+    // Корзины идут подряд без пропусков и перекрытий
+    for (size_t i = 1; i < LatencyHistogram::kBucketCount; ++i)
+    {
+        ASSERT_EQ(LatencyHistogram::bucket_lower(i), LatencyHistogram::bucket_upper(i - 1) + 1) << "корзина " << i;
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_upper(LatencyHistogram::kBucketCount - 1), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(LatencyHistogram::bucket_index(std::numeric_limits<uint64_t>::max()), LatencyHistogram::kBucketCount - 1);
+
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < 10000; ++i)
+    {
+        uint64_t value = rng() >> (rng() % 64);
+        size_t index = LatencyHistogram::bucket_index(value);
+        ASSERT_LE(LatencyHistogram::bucket_lower(index), value);
+        ASSERT_GE(LatencyHistogram::bucket_upper(index), value);
+    }
+}
+
+TEST(LatencyHistogramTest, RelativeErrorIsBounded)
+{
+    LatencyHistogram histogram;
+    std::mt19937_64 rng(2);
+    std::vector<uint64_t> values;
+    for (int i = 0; i < 100000; ++i)
+    {
+        // Логнормальное распределение, как у настоящих задержек
+        uint64_t value = static_cast<uint64_t>(std::exp(5.0 + 2.0 * std::normal_distribution<double>()(rng)));
+        values.push_back(value);
+        histogram.record(value);
+    }
+    std::sort(values.begin(), values.end());
+
+    for (double percentile : {50.0, 90.0, 99.0, 99.9})
+    {
+        uint64_t exact = values[static_cast<size_t>(percentile / 100.0 * values.size() + 0.5) - 1];
+        uint64_t approx = histogram.value_at_percentile(percentile);
+        EXPECT_GE(approx, exact);
+        EXPECT_LE(static_cast<double>(approx), static_cast<double>(exact) * (1.0 + 1.0 / 64) + 1.0) << percentile;
+    }
+    EXPECT_EQ(histogram.value_at_percentile(100.0), values.back());
+}
+
+TEST(LatencyHistogramTest, MergeAndReset)
+{
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 0; i < 990; ++i)
+    {
+        fast.record(100);
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        slow.record(1000000);
+    }
+
+    fast.merge(slow);
+    EXPECT_EQ(fast.get_count(), 1000u);
+    EXPECT_EQ(fast.value_at_percentile(50.0), 100u);
+    EXPECT_EQ(fast.value_at_percentile(99.9), 1000000u);
+    EXPECT_EQ(fast.get_min(), 100u);
+    EXPECT_EQ(fast.get_max(), 1000000u);
+
+    fast.reset();
+    EXPECT_EQ(fast.get_count(), 0u);
+    EXPECT_EQ(fast.value_at_percentile(50.0), 0u);
+}
@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include "memory_budget.h"
+#include <new>
+#include <optional>
+
+// Тесты для MemoryBudget и лимитов памяти в CustomMemoryResource
+TEST(MemoryBudgetTest, ChargesAllLevels)
+{
+    MemoryBudget process(1000, nullptr, "процесс");
+    MemoryBudget service(600, &process, "сервис");
+
+    EXPECT_EQ(service.try_charge(400), nullptr);
+    EXPECT_EQ(service.get_used(), 400u);
+    EXPECT_EQ(process.get_used(), 400u);
+
+    service.release(100);
+    EXPECT_EQ(service.get_used(), 300u);
+    EXPECT_EQ(process.get_used(), 300u);
+    EXPECT_EQ(service.get_peak(), 400u);
+    EXPECT_EQ(service.get_available(), 300u);
+}
+
+TEST(MemoryBudgetTest, RejectionRollsBackLowerLevels)
+{
+    MemoryBudget process(500);
+    MemoryBudget service(1000, &process);
+
+    EXPECT_EQ(process.try_charge(300), nullptr);
+    EXPECT_EQ(service.try_charge(300), &process);
+    EXPECT_EQ(service.get_used(), 0u);
+    EXPECT_EQ(process.get_used(), 300u);
+    EXPECT_EQ(process.get_rejections_count(), 1u);
+    EXPECT_EQ(service.get_rejections_count(), 0u);
+}
+
+// Бюджет должен пережить ресурс, поэтому удаляется последним
+class ResourceBudgetTest : public ::testing::Test
+{
+protected:
+    MemoryBudget *budget;
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        budget = new MemoryBudget(1024, nullptr, "тест");
+        mr = new CustomMemoryResource();
+        // Тесты считают байты обычного режима (и в сборке с LAB5_HARDENED)
+        mr->set_hardening(HardeningOptions());
+        mr->set_memory_budget(budget);
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+        delete budget;
+    }
+};
+
+TEST_F(ResourceBudgetTest, ThrowsBadAllocOverBudget)
+{
+    void *p = mr->allocate(512, 8);
+    EXPECT_EQ(budget->get_used(), 512u);
+    EXPECT_THROW((void)mr->allocate(1024, 8), std::bad_alloc);
+    EXPECT_EQ(budget->get_used(), 512u);
+    EXPECT_EQ(mr->get_budget_pressure_events(), 1u);
+
+    mr->deallocate(p, 512, 8);
+}
+
+TEST_F(ResourceBudgetTest, ReusedBlocksAreNotChargedAgain)
+{
+    void *p = mr->allocate(512, 8);
+    mr->deallocate(p, 512, 8);
+    void *q = mr->allocate(512, 8);
+
+    EXPECT_EQ(p, q);
+    EXPECT_EQ(budget->get_used(), 512u);
+    mr->deallocate(q, 512, 8);
+}
+
+TEST_F(ResourceBudgetTest, ReclaimsCachedBlocksFirst)
+{
+    void *small = mr->allocate(256, 8);
+    void *cached = mr->allocate(512, 8);
+    mr->deallocate(cached, 512, 8);
+
+    // Кэшированный блок мал для 700 байт: его нужно вернуть системе, чтобы уложиться в лимит
+    void *big = mr->allocate(700, 8);
+    EXPECT_EQ(mr->get_reclaimed_bytes(), 512u);
+    EXPECT_EQ(budget->get_used(), 256u + 700u);
+    EXPECT_EQ(mr->get_footprint_bytes(), budget->get_used());
+
+    mr->deallocate(big, 700, 8);
+    mr->deallocate(small, 256, 8);
+}
+
+TEST_F(ResourceBudgetTest, PressureHandlerShedsLoad)
+{
+    budget->set_limit(4096);
+
+    std::optional<DynamicArray<char>> cache(std::in_place, mr);
+    cache->resize(3000);
+
+    size_t calls = 0;
+    mr->set_pressure_handler([&](size_t bytes, MemoryBudget &exhausted)
+                             {
+                                 ++calls;
+                                 EXPECT_EQ(bytes, 2000u);
+                                 EXPECT_EQ(&exhausted, budget);
+                                 cache.reset(); });
+
+    void *p = mr->allocate(2000, 8);
+    EXPECT_EQ(calls, 1u);
+    EXPECT_FALSE(cache.has_value());
+    EXPECT_LE(budget->get_used(), budget->get_limit());
+    mr->deallocate(p, 2000, 8);
+}
+
+TEST_F(ResourceBudgetTest, HandlerThatDoesNotHelpEndsInBadAlloc)
+{
+    size_t calls = 0;
+    mr->set_pressure_handler([&calls](size_t, MemoryBudget &)
+                             { ++calls; });
+
+    EXPECT_THROW((void)mr->allocate(2048, 8), std::bad_alloc);
+    EXPECT_EQ(calls, 1u);
+    EXPECT_EQ(budget->get_used(), 0u);
+}
+
+TEST_F(ResourceBudgetTest, ReleaseFreeBlocksReturnsWholeChunks)
+{
+    budget->set_limit(MemoryBudget::kUnlimited);
+    void *ptrs[8];
+    mr->allocate_batch(8, 64, 8, ptrs);
+    const size_t footprint = mr->get_footprint_bytes();
+    EXPECT_EQ(footprint, 8u * 64u);
+
+    // Пока хоть один блок куска занят, кусок не освобождается
+    mr->deallocate_batch(ptrs, 7, 64, 8);
+    EXPECT_EQ(mr->release_free_blocks(), 0u);
+
+    mr->deallocate(ptrs[7], 64, 8);
+    EXPECT_EQ(mr->release_free_blocks(), footprint);
+    EXPECT_EQ(mr->get_footprint_bytes(), 0u);
+    EXPECT_EQ(mr->get_free_blocks_count(), 0u);
+}
+
+TEST_F(ResourceBudgetTest, BatchOverBudgetReturnsCachedBlocksSilently)
+{
+    struct CountingObserver : AllocationObserver
+    {
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        void on_allocate(void *, size_t, size_t) override { ++allocations; }
+        void on_deallocate(void *, size_t, size_t) override { ++deallocations; }
+    };
+
+    void *cached[2] = {mr->allocate(64, 8), mr->allocate(64, 8)};
+    mr->deallocate(cached[0], 64, 8);
+    mr->deallocate(cached[1], 64, 8);
+
+    // Два блока берутся из кэша, а кусок под остальные 18 в бюджет не влезает
+    CountingObserver observer;
+    mr->add_observer(&observer);
+    void *ptrs[20];
+    EXPECT_THROW(mr->allocate_batch(20, 64, 8, ptrs), std::bad_alloc);
+    mr->remove_observer(&observer);
+
+    // Наблюдатель не видел ни выделения, ни отката, а блоки вернулись в кэш
+    EXPECT_EQ(observer.allocations, 0u);
+    EXPECT_EQ(observer.deallocations, 0u);
+    EXPECT_EQ(mr->get_free_blocks_count(), 2u);
+    EXPECT_EQ(budget->get_used(), 128u);
+}
+
+TEST_F(ResourceBudgetTest, AttachingMovesExistingFootprint)
+{
+    void *p = mr->allocate(512, 8);
+
+    MemoryBudget small(256);
+    EXPECT_THROW(mr->set_memory_budget(&small), std::logic_error);
+    EXPECT_EQ(small.get_used(), 0u);
+    EXPECT_EQ(budget->get_used(), 512u);
+
+    MemoryBudget other(4096);
+    mr->set_memory_budget(&other);
+    EXPECT_EQ(budget->get_used(), 0u);
+    EXPECT_EQ(other.get_used(), 512u);
+    mr->set_memory_budget(budget);
+    EXPECT_EQ(other.get_used(), 0u);
+    EXPECT_EQ(budget->get_used(), 512u);
+
+    mr->deallocate(p, 512, 8);
+}
+
+TEST(ResourceBudgetLifetimeTest, DestructorReturnsEverything)
+{
+    MemoryBudget budget(1 << 20);
+    {
+        CustomMemoryResource mr;
+        mr.set_memory_budget(&budget);
+        DynamicArray<int> arr(&mr);
+        for (int i = 0; i < 1000; ++i)
+        {
+            arr.push_back(i);
+        }
+        void *ptrs[4];
+        mr.allocate_batch(4, 32, 8, ptrs);
+        EXPECT_GT(budget.get_used(), 0u);
+        mr.deallocate_batch(ptrs, 4, 32, 8);
+    }
+    EXPECT_EQ(budget.get_used(), 0u);
+}
+
+TEST(ResourceBudgetLifetimeTest, HardenedBlocksAreChargedWithCanaries)
+{
+    MemoryBudget budget(1 << 20);
+    {
+        CustomMemoryResource mr;
+        mr.set_hardening(HardeningOptions::full());
+        mr.set_memory_budget(&budget);
+        void *p = mr.allocate(100, 8);
+        EXPECT_GT(budget.get_used(), 100u);
+        EXPECT_EQ(mr.get_footprint_bytes(), budget.get_used());
+        mr.deallocate(p, 100, 8);
+    }
+    EXPECT_EQ(budget.get_used(), 0u);
+}
+
+TEST(ResourceBudgetLifetimeTest, SharedParentLimitsAllChildren)
+{
+    MemoryBudget process(1500);
+    MemoryBudget first_budget(1000, &process);
+    MemoryBudget second_budget(1000, &process);
+    CustomMemoryResource first;
+    CustomMemoryResource second;
+    first.set_hardening(HardeningOptions());
+    second.set_hardening(HardeningOptions());
+    first.set_memory_budget(&first_budget);
+    second.set_memory_budget(&second_budget);
+
+    void *a = first.allocate(800, 8);
+    EXPECT_THROW((void)second.allocate(800, 8), std::bad_alloc);
+    void *b = second.allocate(600, 8);
+    EXPECT_EQ(process.get_used(), 1400u);
+
+    first.deallocate(a, 800, 8);
+    second.deallocate(b, 600, 8);
+}
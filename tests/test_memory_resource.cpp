@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "custom_memory_resource.h"
+#include "dynamic_array.h"
 
 // Тесты для CustomMemoryResource
 class CustomMemoryResourceTest : public ::testing::Test
@@ -10,6 +11,8 @@ protected:
     void SetUp() override
     {
         mr = new CustomMemoryResource();
+        // Тесты проверяют раскладку блоков обычного режима (и в сборке с LAB5_HARDENED)
+        mr->set_hardening(HardeningOptions());
     }
 
     void TearDown() override
@@ -149,17 +152,272 @@ TEST_F(CustomMemoryResourceTest, ReuseWithSameAlignment)
     mr->deallocate(ptr2, 100, 16);
 }
 
-TEST_F(CustomMemoryResourceTest, NoReuseWithDifferentAlignment)
+TEST_F(CustomMemoryResourceTest, ReuseWithWeakerAlignment)
 {
-    void *ptr1 = mr->allocate(100, 16);
-    mr->deallocate(ptr1, 100, 16);
+    void *ptr1 = mr->allocate(100, 64);
+    mr->deallocate(ptr1, 100, 64);
 
-    // Выделяем с другим выравниванием - не должна переиспользоваться память
-    void *ptr2 = mr->allocate(100, 32);
+    // Блок, выровненный на 64, подходит и для запроса с выравниванием 16
+    void *ptr2 = mr->allocate(100, 16);
 
-    EXPECT_NE(ptr1, ptr2);
+    EXPECT_EQ(ptr1, ptr2);
     EXPECT_EQ(mr->get_allocated_blocks_count(), 1);
+    EXPECT_EQ(mr->get_free_blocks_count(), 0);
+    EXPECT_EQ(mr->get_cross_alignment_hits(), 1);
+    EXPECT_EQ(mr->get_reuse_hits(), 1);
+    EXPECT_EQ(mr->get_reuse_misses(), 1);
+    EXPECT_DOUBLE_EQ(mr->get_reuse_hit_rate(), 0.5);
+
+    // Освобождение с выравниванием запроса; память вернётся с исходным выравниванием блока
+    mr->deallocate(ptr2, 100, 16);
     EXPECT_EQ(mr->get_free_blocks_count(), 1);
+}
 
-    mr->deallocate(ptr2, 100, 32);
+TEST_F(CustomMemoryResourceTest, NoReuseWithDifferentAlignment)
+{
+    // Два соседних нарезанных блока по 16 байт: один из них не выровнен на 32
+    void *ptrs[2];
+    mr->allocate_batch(2, 16, 16, ptrs);
+    void *misaligned = reinterpret_cast<uintptr_t>(ptrs[0]) % 32 != 0 ? ptrs[0] : ptrs[1];
+    mr->deallocate(misaligned, 16, 16);
+
+    // Более строгое выравнивание блок с таким адресом обеспечить не может
+    void *ptr = mr->allocate(16, 32);
+
+    EXPECT_NE(ptr, misaligned);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 32, 0u);
+    EXPECT_EQ(mr->get_free_blocks_count(), 1);
+
+    mr->deallocate(ptr, 16, 32);
+    mr->deallocate(misaligned == ptrs[0] ? ptrs[1] : ptrs[0], 16, 16);
+}
+
+TEST_F(CustomMemoryResourceTest, MixedElementTypesShareBlocks)
+{
+    {
+        DynamicArray<double> values(mr);
+        values.reserve(32);
+    }
+    {
+        // Буфер double (выравнивание 8) переиспользуется массивом char (выравнивание 1)
+        DynamicArray<char> text(mr);
+        text.reserve(200);
+    }
+    EXPECT_EQ(mr->get_allocated_blocks_count() + mr->get_free_blocks_count(), 1);
+    EXPECT_EQ(mr->get_cross_alignment_hits(), 1);
+}
+
+TEST_F(CustomMemoryResourceTest, LargeAllocationPathDisabledByDefault)
+{
+    EXPECT_EQ(mr->get_large_allocation_threshold(), 0);
+
+    void *ptr = mr->allocate(4 * 1024 * 1024);
+    EXPECT_EQ(mr->get_mapped_blocks_count(), 0);
+
+    mr->deallocate(ptr, 4 * 1024 * 1024);
+}
+
+TEST_F(CustomMemoryResourceTest, LargeAllocationUsesHugePageRegion)
+{
+    if (!PageAllocator::supported())
+    {
+        GTEST_SKIP() << "mmap недоступен на этой платформе";
+    }
+
+    const size_t large = 3 * 1024 * 1024;
+    mr->set_large_allocation_threshold(1024 * 1024);
+
+    void *small = mr->allocate(1000);
+    void *ptr = mr->allocate(large, 64);
+
+    EXPECT_EQ(mr->get_mapped_blocks_count(), 1);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % PageAllocator::kHugePageSize, 0u);
+
+    // Память должна быть доступна для записи по всей длине
+    static_cast<char *>(ptr)[0] = 1;
+    static_cast<char *>(ptr)[large - 1] = 2;
+
+    mr->deallocate(ptr, large, 64);
+    EXPECT_EQ(mr->get_free_blocks_count(), 1);
+
+    // Освобождённый большой блок переиспользуется как обычный
+    void *again = mr->allocate(large, 64);
+    EXPECT_EQ(again, ptr);
+    EXPECT_EQ(mr->get_mapped_blocks_count(), 1);
+
+    mr->deallocate(again, large, 64);
+    mr->deallocate(small, 1000);
+}
+
+TEST_F(CustomMemoryResourceTest, BatchAllocationFromOneChunk)
+{
+    void *ptrs[8];
+    mr->allocate_batch(8, 24, 8, ptrs);
+
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 8);
+    EXPECT_EQ(mr->get_chunks_count(), 1);
+    EXPECT_GE(mr->get_total_allocated_bytes(), 8 * 24);
+
+    // Блоки нарезаны подряд с шагом, кратным выравниванию
+    for (int i = 1; i < 8; ++i)
+    {
+        EXPECT_EQ(static_cast<char *>(ptrs[i]) - static_cast<char *>(ptrs[i - 1]), 24);
+    }
+
+    mr->deallocate_batch(ptrs, 8, 24, 8);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 0);
+    EXPECT_EQ(mr->get_free_blocks_count(), 8);
+}
+
+TEST_F(CustomMemoryResourceTest, BatchAllocationReusesFreeBlocks)
+{
+    void *first = mr->allocate(64, 16);
+    void *second = mr->allocate(64, 16);
+    mr->deallocate(first, 64, 16);
+    mr->deallocate(second, 64, 16);
+
+    void *ptrs[5];
+    mr->allocate_batch(5, 64, 16, ptrs);
+
+    // Два блока переиспользованы, три нарезаны из нового куска
+    EXPECT_EQ(ptrs[0], first);
+    EXPECT_EQ(ptrs[1], second);
+    EXPECT_EQ(mr->get_chunks_count(), 1);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 5);
+
+    for (void *ptr : ptrs)
+    {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 16, 0u);
+    }
+
+    // Нарезанный блок освобождается и переиспользуется по отдельности
+    mr->deallocate(ptrs[3], 64, 16);
+    EXPECT_EQ(mr->allocate(64, 16), ptrs[3]);
+
+    mr->deallocate_batch(ptrs, 5, 64, 16);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 0);
+}
+
+TEST_F(CustomMemoryResourceTest, FirstFitIsDefaultPolicy)
+{
+    EXPECT_EQ(mr->get_placement_policy(), PlacementPolicy::FirstFit);
+
+    void *big = mr->allocate(1000);
+    void *small = mr->allocate(100);
+    mr->deallocate(big, 1000);
+    mr->deallocate(small, 100);
+
+    // Первый подходящий по порядку списка - большой блок
+    void *ptr = mr->allocate(80);
+    EXPECT_EQ(ptr, big);
+    EXPECT_EQ(mr->get_internal_waste_bytes(), 920);
+    mr->deallocate(ptr, 80);
+}
+
+TEST_F(CustomMemoryResourceTest, BestFitPicksSmallestBlock)
+{
+    mr->set_placement_policy(PlacementPolicy::BestFit);
+
+    void *big = mr->allocate(1000);
+    void *small = mr->allocate(100);
+    void *medium = mr->allocate(300);
+    mr->deallocate(big, 1000);
+    mr->deallocate(small, 100);
+    mr->deallocate(medium, 300);
+
+    EXPECT_EQ(mr->allocate(80), small);
+    EXPECT_EQ(mr->allocate(200), medium);
+    EXPECT_EQ(mr->allocate(200), big);
+    EXPECT_EQ(mr->get_internal_waste_bytes(), 20 + 100 + 800);
+
+    mr->deallocate(small, 80);
+    mr->deallocate(medium, 200);
+    mr->deallocate(big, 200);
+}
+
+TEST_F(CustomMemoryResourceTest, BestFitRespectsAlignment)
+{
+    mr->set_placement_policy(PlacementPolicy::BestFit);
+
+    // Соседние блоки с шагом 32: ровно один из них не выровнен на 64
+    void *ptrs[2];
+    mr->allocate_batch(2, 32, 32, ptrs);
+    void *misaligned = reinterpret_cast<uintptr_t>(ptrs[0]) % 64 != 0 ? ptrs[0] : ptrs[1];
+    void *strong = mr->allocate(256, 64);
+    mr->deallocate(misaligned, 32, 32);
+    mr->deallocate(strong, 256, 64);
+
+    // Для выравнивания 64 подходит только больший блок
+    EXPECT_EQ(mr->allocate(32, 64), strong);
+    // Для выравнивания 16 - наименьший подходящий, хотя он выделялся с выравниванием 32
+    EXPECT_EQ(mr->allocate(24, 16), misaligned);
+
+    mr->deallocate(strong, 32, 64);
+    mr->deallocate(misaligned, 24, 16);
+    mr->deallocate(misaligned == ptrs[0] ? ptrs[1] : ptrs[0], 32, 32);
+}
+
+TEST_F(CustomMemoryResourceTest, GoodFitRejectsWastefulBlock)
+{
+    mr->set_placement_policy(PlacementPolicy::GoodFit, 0.25);
+
+    void *big = mr->allocate(1000);
+    mr->deallocate(big, 1000);
+
+    // 100 из 1000 байт - потеря 90%, берём новый блок
+    void *small = mr->allocate(100);
+    EXPECT_NE(small, big);
+    EXPECT_EQ(mr->get_free_blocks_count(), 1);
+
+    // 800 из 1000 байт - потеря 20%, блок подходит
+    EXPECT_EQ(mr->allocate(800), big);
+
+    mr->deallocate(small, 100);
+    mr->deallocate(big, 800);
+}
+
+TEST_F(CustomMemoryResourceTest, PolicySwitchIndexesExistingFreeBlocks)
+{
+    void *big = mr->allocate(1000);
+    void *small = mr->allocate(100);
+    mr->deallocate(big, 1000);
+    mr->deallocate(small, 100);
+
+    mr->set_placement_policy(PlacementPolicy::BestFit);
+    EXPECT_EQ(mr->allocate(50), small);
+
+    mr->set_placement_policy(PlacementPolicy::FirstFit);
+    EXPECT_EQ(mr->allocate(50), big);
+
+    mr->deallocate(small, 50);
+    mr->deallocate(big, 50);
+}
+
+TEST_F(CustomMemoryResourceTest, BatchAllocationUsesPlacementPolicy)
+{
+    mr->set_placement_policy(PlacementPolicy::BestFit);
+
+    void *big = mr->allocate(512, 8);
+    void *exact = mr->allocate(32, 8);
+    mr->deallocate(big, 512, 8);
+    mr->deallocate(exact, 32, 8);
+
+    void *ptrs[3];
+    mr->allocate_batch(3, 32, 8, ptrs);
+    EXPECT_EQ(ptrs[0], exact);
+    EXPECT_EQ(ptrs[1], big);
+    EXPECT_EQ(mr->get_chunks_count(), 1);
+
+    mr->deallocate_batch(ptrs, 3, 32, 8);
+    EXPECT_EQ(mr->get_free_blocks_count(), 3);
+    // Любой из двух 32-байтных блоков, но не 512-байтный
+    void *again = mr->allocate(16, 8);
+    EXPECT_NE(again, big);
+    mr->deallocate(again, 16, 8);
+}
+
+TEST_F(CustomMemoryResourceTest, InvalidWasteRatioThrows)
+{
+    EXPECT_THROW(mr->set_placement_policy(PlacementPolicy::GoodFit, 1.5), std::invalid_argument);
+    EXPECT_THROW(mr->set_placement_policy(PlacementPolicy::GoodFit, -0.1), std::invalid_argument);
 }
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "radix_sort.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Employee
+    {
+        int age;
+        int id;
+    };
+
+    struct Person
+    {
+        std::string name;
+        int age;
+    };
+
+    template <typename T>
+    std::vector<T> to_vector(const DynamicArray<T> &arr)
+    {
+        return std::vector<T>(arr.begin(), arr.end());
+    }
+}
+
+// Тесты для radix_sort и parallel_radix_sort
+class RadixSortTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+    }
+
+    template <typename T, typename Gen>
+    void check_against_std_sort(size_t n, Gen gen)
+    {
+        DynamicArray<T> arr(mr);
+        std::vector<T> expected;
+        for (size_t i = 0; i < n; ++i)
+        {
+            T value = gen();
+            arr.push_back(value);
+            expected.push_back(value);
+        }
+        std::sort(expected.begin(), expected.end());
+        radix_sort(arr);
+        EXPECT_EQ(to_vector(arr), expected);
+    }
+};
+
+TEST_F(RadixSortTest, SignedIntegers)
+{
+    std::mt19937 rng(1);
+    check_against_std_sort<int>(10000, [&rng]
+                                { return static_cast<int>(rng()); });
+    check_against_std_sort<int64_t>(10000, [&rng]
+                                    { return static_cast<int64_t>(rng()) * (rng() % 2 ? 1 : -1) * 1000003; });
+    check_against_std_sort<int8_t>(1000, [&rng]
+                                   { return static_cast<int8_t>(rng()); });
+}
+
+TEST_F(RadixSortTest, UnsignedIntegers)
+{
+    std::mt19937_64 rng(2);
+    check_against_std_sort<uint32_t>(10000, [&rng]
+                                     { return static_cast<uint32_t>(rng()); });
+    check_against_std_sort<uint64_t>(10000, [&rng]
+                                     { return rng(); });
+    // Узкий диапазон: большинство проходов пропускается
+    check_against_std_sort<uint64_t>(10000, [&rng]
+                                     { return rng() % 100; });
+}
+
+TEST_F(RadixSortTest, FloatingPoint)
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    check_against_std_sort<double>(10000, [&]
+                                   { return dist(rng); });
+    check_against_std_sort<float>(10000, [&]
+                                  { return static_cast<float>(dist(rng)); });
+
+    DynamicArray<double> special(mr);
+    for (double value : {1.5, -std::numeric_limits<double>::infinity(), 0.0, -2.0,
+                         std::numeric_limits<double>::infinity(), std::numeric_limits<double>::denorm_min()})
+    {
+        special.push_back(value);
+    }
+    radix_sort(special);
+    EXPECT_TRUE(std::is_sorted(special.begin(), special.end()));
+    EXPECT_TRUE(std::isinf(special[0]) && special[0] < 0);
+}
+
+TEST_F(RadixSortTest, EmptyAndSingle)
+{
+    DynamicArray<int> empty(mr);
+    radix_sort(empty);
+    EXPECT_TRUE(empty.empty());
+
+    DynamicArray<int> single(mr);
+    single.push_back(5);
+    radix_sort(single);
+    EXPECT_EQ(single[0], 5);
+}
+
+TEST_F(RadixSortTest, KeyExtractorIsStable)
+{
+    DynamicArray<Employee> staff(mr);
+    std::mt19937 rng(4);
+    for (int i = 0; i < 5000; ++i)
+    {
+        staff.push_back({static_cast<int>(rng() % 50) - 10, i});
+    }
+
+    radix_sort(staff, [](const Employee &e)
+               { return e.age; });
+
+    for (size_t i = 1; i < staff.size(); ++i)
+    {
+        ASSERT_LE(staff[i - 1].age, staff[i].age);
+        if (staff[i - 1].age == staff[i].age)
+        {
+            ASSERT_LT(staff[i - 1].id, staff[i].id) << "порядок равных ключей нарушен";
+        }
+    }
+}
+
+TEST_F(RadixSortTest, NonTrivialRecordsAreMoved)
+{
+    DynamicArray<Person> people(mr);
+    people.push_back({"Анна", 30});
+    people.push_back({"Борис", 25});
+    people.push_back({"Вера", 35});
+    people.push_back({"Глеб", 25});
+    people.push_back({"Дарья", 18});
+
+    radix_sort(people, [](const Person &p)
+               { return p.age; });
+
+    std::vector<std::string> names;
+    for (const Person &p : people)
+    {
+        names.push_back(p.name);
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"Дарья", "Борис", "Глеб", "Анна", "Вера"}));
+}
+
+TEST_F(RadixSortTest, ScratchComesFromArrayResource)
+{
+    DynamicArray<uint32_t> arr(mr);
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        arr.push_back(1000 - i);
+    }
+    const size_t blocks = mr->get_allocated_blocks_count();
+    const size_t bytes = mr->get_total_allocated_bytes();
+
+    radix_sort(arr);
+
+    EXPECT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+    EXPECT_GT(mr->get_total_allocated_bytes(), bytes);
+    EXPECT_EQ(mr->get_allocated_blocks_count(), blocks);
+}
+
+TEST_F(RadixSortTest, ParallelMatchesStdSort)
+{
+    std::mt19937_64 rng(5);
+    DynamicArray<int64_t> arr(mr);
+    std::vector<int64_t> expected;
+    for (size_t i = 0; i < 3 * kParallelRadixThreshold; ++i)
+    {
+        int64_t value = static_cast<int64_t>(rng());
+        arr.push_back(value);
+        expected.push_back(value);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    parallel_radix_sort(arr, 4);
+    EXPECT_EQ(to_vector(arr), expected);
+}
+
+TEST_F(RadixSortTest, ParallelSkewedKeys)
+{
+    // Почти все ключи в одной корзине старшего байта
+    std::mt19937 rng(6);
+    DynamicArray<double> arr(mr);
+    for (size_t i = 0; i < 2 * kParallelRadixThreshold; ++i)
+    {
+        arr.push_back(i % 1000 == 0 ? -1e300 : 1.0 + (rng() % 1000) / 1000.0);
+    }
+
+    parallel_radix_sort(arr, 3);
+    EXPECT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+    EXPECT_EQ(arr[0], -1e300);
+}
+
+TEST_F(RadixSortTest, ParallelSmallFallsBack)
+{
+    DynamicArray<int> arr(mr);
+    for (int i = 0; i < 100; ++i)
+    {
+        arr.push_back(100 - i);
+    }
+    parallel_radix_sort(arr);
+    EXPECT_TRUE(std::is_sorted(arr.begin(), arr.end()));
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "static_dynamic_array.h"
+#include <algorithm>
+#include <string>
+
+// Таблица квадратов, построенная при компиляции
+constexpr StaticDynamicArray<int, 16> make_squares()
+{
+    StaticDynamicArray<int, 16> table;
+    for (int i = 0; i < 16; ++i)
+    {
+        table.push_back(i * i);
+    }
+    return table;
+}
+
+constexpr auto kSquares = make_squares();
+
+static_assert(kSquares.size() == 16, "таблица должна быть заполнена при компиляции");
+static_assert(kSquares[5] == 25, "доступ по индексу в constexpr");
+static_assert(kSquares.back() == 225, "back() в constexpr");
+static_assert(*(kSquares.begin() + 3) == 9, "итераторы в constexpr");
+static_assert(StaticDynamicArray<int, 4>::capacity() == 4, "ёмкость известна при компиляции");
+
+constexpr int sum_of(const StaticDynamicArray<int, 8> &arr)
+{
+    int sum = 0;
+    for (int value : arr)
+    {
+        sum += value;
+    }
+    return sum;
+}
+
+static_assert(sum_of({1, 2, 3, 4}) == 10, "range-based for в constexpr");
+
+TEST(StaticDynamicArrayTest, DefaultConstructor)
+{
+    StaticDynamicArray<int, 8> arr;
+    EXPECT_EQ(arr.size(), 0);
+    EXPECT_TRUE(arr.empty());
+    EXPECT_EQ(arr.capacity(), 8);
+}
+
+TEST(StaticDynamicArrayTest, PushBackAndAccess)
+{
+    StaticDynamicArray<int, 4> arr;
+    arr.push_back(10);
+    arr.push_back(20);
+    arr.emplace_back(30);
+
+    EXPECT_EQ(arr.size(), 3);
+    EXPECT_EQ(arr[0], 10);
+    EXPECT_EQ(arr.at(1), 20);
+    EXPECT_EQ(arr.back(), 30);
+    EXPECT_THROW(arr.at(3), std::out_of_range);
+}
+
+TEST(StaticDynamicArrayTest, OverflowThrows)
+{
+    StaticDynamicArray<int, 2> arr{1, 2};
+    EXPECT_TRUE(arr.full());
+    EXPECT_THROW(arr.push_back(3), std::length_error);
+    EXPECT_THROW(arr.resize(3), std::length_error);
+    EXPECT_EQ(arr.size(), 2);
+}
+
+TEST(StaticDynamicArrayTest, PopBackAndClear)
+{
+    StaticDynamicArray<std::string, 4> arr;
+    arr.push_back("a");
+    arr.push_back("b");
+    arr.pop_back();
+
+    EXPECT_EQ(arr.size(), 1);
+    EXPECT_EQ(arr[0], "a");
+
+    arr.clear();
+    EXPECT_TRUE(arr.empty());
+}
+
+TEST(StaticDynamicArrayTest, Resize)
+{
+    StaticDynamicArray<int, 8> arr;
+    arr.resize(3, 7);
+    EXPECT_EQ(arr.size(), 3);
+    EXPECT_EQ(arr[2], 7);
+
+    arr.resize(1);
+    EXPECT_EQ(arr.size(), 1);
+    EXPECT_EQ(arr[0], 7);
+}
+
+TEST(StaticDynamicArrayTest, IteratorsMatchDynamicArray)
+{
+    // Итераторы совпадают по типу с итераторами DynamicArray
+    static_assert(std::is_same<StaticDynamicArray<int, 4>::iterator, DynamicArray<int>::Iterator>::value, "");
+    static_assert(std::is_same<StaticDynamicArray<int, 4>::const_iterator, DynamicArray<int>::ConstIterator>::value, "");
+
+    StaticDynamicArray<int, 8> arr{30, 10, 20};
+    std::sort(arr.begin(), arr.end());
+
+    EXPECT_EQ(arr[0], 10);
+    EXPECT_EQ(arr[1], 20);
+    EXPECT_EQ(arr[2], 30);
+
+    const auto &const_arr = arr;
+    EXPECT_EQ(const_arr.end() - const_arr.begin(), 3);
+}
+
+TEST(StaticDynamicArrayTest, CompileTimeTableAtRuntime)
+{
+    for (size_t i = 0; i < kSquares.size(); ++i)
+    {
+        EXPECT_EQ(kSquares[i], static_cast<int>(i * i));
+    }
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "streaming_loader.h"
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace
+{
+    bool parse_int(std::string_view line, int &value)
+    {
+        auto result = std::from_chars(line.data(), line.data() + line.size(), value);
+        return result.ec == std::errc() && result.ptr == line.data() + line.size();
+    }
+
+    struct Point
+    {
+        int x;
+        int y;
+    };
+}
+
+// Тесты для конвейерной загрузки файлов
+class StreamingLoaderTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+    std::string path;
+    StreamingLoadOptions options;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+        path = ::testing::TempDir() + "lab5_streaming_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".txt";
+        // Маленькие куски, чтобы строки попадали на границы
+        options.chunk_size = 4096;
+        options.io_threads = 2;
+        options.parse_threads = 3;
+        options.max_chunks_in_flight = 4;
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+        delete mr;
+    }
+
+    void write_file(const std::string &content)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+};
+
+TEST_F(StreamingLoaderTest, LoadsLinesInOrder)
+{
+    std::string content;
+    for (int i = 0; i < 50000; ++i)
+    {
+        content += std::to_string(i * 7) + "\n";
+    }
+    write_file(content);
+
+    DynamicArray<int> arr(mr);
+    StreamingLoadStats stats = load_lines_streaming(path, arr, parse_int, options);
+
+    ASSERT_EQ(arr.size(), 50000);
+    for (int i = 0; i < 50000; ++i)
+    {
+        ASSERT_EQ(arr[i], i * 7) << "строка " << i;
+    }
+    EXPECT_EQ(stats.elements, 50000);
+    EXPECT_EQ(stats.bytes_read, content.size());
+    EXPECT_EQ(stats.chunks, (content.size() + 4095) / 4096);
+    EXPECT_EQ(stats.skipped_lines, 0);
+}
+
+TEST_F(StreamingLoaderTest, LinesLongerThanChunk)
+{
+    std::string content;
+    for (int i = 0; i < 20; ++i)
+    {
+        content += std::string(1000 + i * 1500, 'a') + "\n";
+    }
+    write_file(content);
+
+    DynamicArray<size_t> lengths(mr);
+    load_lines_streaming(path, lengths, [](std::string_view line, size_t &value)
+                         {
+                             value = line.size();
+                             return true; },
+                         options);
+
+    ASSERT_EQ(lengths.size(), 20);
+    for (size_t i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(lengths[i], 1000 + i * 1500);
+    }
+}
+
+TEST_F(StreamingLoaderTest, ParsesCsvRecords)
+{
+    write_file("x,y\r\n1,2\r\n3,4\r\n\r\n5,6");
+
+    DynamicArray<Point> points(mr);
+    StreamingLoadStats stats = load_lines_streaming(path, points, [](std::string_view line, Point &point)
+                                                    {
+                                                        const size_t comma = line.find(',');
+                                                        return comma != std::string_view::npos &&
+                                                               parse_int(line.substr(0, comma), point.x) &&
+                                                               parse_int(line.substr(comma + 1), point.y); },
+                                                    options);
+
+    // Заголовок и пустая строка пропущены; последняя строка без '\n' прочитана
+    ASSERT_EQ(points.size(), 3);
+    EXPECT_EQ(points[0].x, 1);
+    EXPECT_EQ(points[1].y, 4);
+    EXPECT_EQ(points[2].x, 5);
+    EXPECT_EQ(points[2].y, 6);
+    EXPECT_EQ(stats.skipped_lines, 2);
+}
+
+TEST_F(StreamingLoaderTest, EmptyFile)
+{
+    write_file("");
+    DynamicArray<int> arr(mr);
+    StreamingLoadStats stats = load_lines_streaming(path, arr, parse_int, options);
+    EXPECT_TRUE(arr.empty());
+    EXPECT_EQ(stats.chunks, 0);
+}
+
+TEST_F(StreamingLoaderTest, AppendsToExistingContent)
+{
+    write_file("2\n3\n");
+    DynamicArray<int> arr(mr);
+    arr.push_back(1);
+    load_lines_streaming(path, arr, parse_int, options);
+
+    ASSERT_EQ(arr.size(), 3);
+    EXPECT_EQ(arr[0], 1);
+    EXPECT_EQ(arr[2], 3);
+}
+
+TEST_F(StreamingLoaderTest, BuffersComeFromChosenResource)
+{
+    std::string content;
+    for (int i = 0; i < 10000; ++i)
+    {
+        content += std::to_string(i) + "\n";
+    }
+    write_file(content);
+
+    CustomMemoryResource buffers;
+    options.buffer_resource = &buffers;
+    DynamicArray<int> arr(mr);
+    load_lines_streaming(path, arr, parse_int, options);
+
+    EXPECT_EQ(arr.size(), 10000);
+    EXPECT_GT(buffers.get_total_allocated_bytes(), 0);
+    // Все буферы чтения и пакеты возвращены
+    EXPECT_EQ(buffers.get_allocated_blocks_count(), 0);
+    // В ресурсе массива остался только его собственный буфер
+    EXPECT_EQ(mr->get_allocated_blocks_count(), 1);
+}
+
+TEST_F(StreamingLoaderTest, ParseErrorPropagates)
+{
+    std::string content;
+    for (int i = 0; i < 5000; ++i)
+    {
+        content += (i == 3000 ? std::string("bad") : std::to_string(i)) + "\n";
+    }
+    write_file(content);
+
+    DynamicArray<int> arr(mr);
+    EXPECT_THROW(load_lines_streaming(path, arr, [](std::string_view line, int &value)
+                                      {
+                                          if (!parse_int(line, value))
+                                          {
+                                              throw std::invalid_argument("не число");
+                                          }
+                                          return true; },
+                                      options),
+                 std::invalid_argument);
+
+    // Буферы освобождены даже после ошибки
+    EXPECT_LE(mr->get_allocated_blocks_count(), 1);
+}
+
+TEST_F(StreamingLoaderTest, MissingFileThrows)
+{
+    DynamicArray<int> arr(mr);
+    EXPECT_THROW(load_lines_streaming("/nonexistent/lab5.txt", arr, parse_int, options), std::runtime_error);
+}
+
+TEST_F(StreamingLoaderTest, BinaryArrayRoundTrip)
+{
+    DynamicArray<double> arr(mr);
+    for (int i = 0; i < 100000; ++i)
+    {
+        arr.push_back(i * 0.5);
+    }
+    save_array(path, arr);
+
+    DynamicArray<double> loaded(mr);
+    loaded.push_back(-1.0);
+    StreamingLoadStats stats = load_array_streaming(path, loaded, options);
+
+    ASSERT_EQ(loaded.size(), arr.size());
+    for (size_t i = 0; i < arr.size(); ++i)
+    {
+        ASSERT_EQ(loaded[i], arr[i]);
+    }
+    EXPECT_EQ(stats.bytes_read, arr.size() * sizeof(double));
+    EXPECT_EQ(stats.chunks, (arr.size() * sizeof(double) + 4095) / 4096);
+}
+
+TEST_F(StreamingLoaderTest, BinaryChecksumMismatch)
+{
+    DynamicArray<int> arr(mr);
+    for (int i = 0; i < 5000; ++i)
+    {
+        arr.push_back(i);
+    }
+    save_array(path, arr);
+
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-100, std::ios::end);
+        file.put('\x7F');
+    }
+
+    DynamicArray<int> loaded(mr);
+    EXPECT_THROW(load_array_streaming(path, loaded, options), std::runtime_error);
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(StreamingLoaderTest, ChunkedChecksumMatchesWhole)
+{
+    std::string data(10007, 'z');
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>(i * 31);
+    }
+
+    ArrayChecksum checksum(data.size());
+    checksum.update(data.data(), 4096);
+    checksum.update(data.data() + 4096, 4096);
+    checksum.update(data.data() + 8192, data.size() - 8192);
+    EXPECT_EQ(checksum.finish(), array_checksum(data.data(), data.size()));
+}
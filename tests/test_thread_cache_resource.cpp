@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "dynamic_array.h"
+#include "thread_cache_resource.h"
+#include <thread>
+#include <vector>
+
+// Тесты для ThreadCacheResource
+class ThreadCacheResourceTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *upstream;
+
+    void SetUp() override
+    {
+        upstream = new CustomMemoryResource();
+    }
+
+    void TearDown() override
+    {
+        delete upstream;
+    }
+};
+
+TEST_F(ThreadCacheResourceTest, ReusesBlocksFromThreadCache)
+{
+    ThreadCacheResource cache(upstream);
+
+    void *ptr = cache.allocate(40);
+    cache.deallocate(ptr, 40);
+
+    // Тот же класс размера (64 байта) - блок берётся из магазина потока
+    void *again = cache.allocate(50);
+    EXPECT_EQ(again, ptr);
+    cache.deallocate(again, 50);
+
+    ThreadCacheStats stats = cache.get_total_stats();
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.hits, 1);
+}
+
+TEST_F(ThreadCacheResourceTest, RefillsInBatches)
+{
+    // Пачка нарезается одним куском только без усиленного режима (сборка с LAB5_HARDENED)
+    upstream->set_hardening(HardeningOptions());
+    ThreadCacheResource cache(upstream);
+
+    void *ptr = cache.allocate(16);
+
+    // Один промах забирает из upstream целую пачку блоков одним allocate_batch
+    EXPECT_EQ(upstream->get_allocated_blocks_count(), ThreadCacheResource::kBatchSize);
+    EXPECT_EQ(upstream->get_chunks_count(), 1);
+
+    for (size_t i = 1; i < ThreadCacheResource::kBatchSize; ++i)
+    {
+        (void)cache.allocate(16);
+    }
+    EXPECT_EQ(cache.get_total_stats().misses, 1);
+
+    cache.deallocate(ptr, 16);
+}
+
+TEST_F(ThreadCacheResourceTest, FlushesOverflowToUpstream)
+{
+    {
+        ThreadCacheResource cache(upstream);
+        std::vector<void *> blocks;
+        for (size_t i = 0; i < 3 * ThreadCacheResource::kMagazineSize; ++i)
+        {
+            blocks.push_back(cache.allocate(128));
+        }
+        for (void *ptr : blocks)
+        {
+            cache.deallocate(ptr, 128);
+        }
+
+        // В магазине остаётся не больше kMagazineSize блоков, остальное вернулось в upstream
+        EXPECT_LE(upstream->get_allocated_blocks_count(), ThreadCacheResource::kMagazineSize);
+    }
+
+    // Деструктор возвращает всё содержимое кэшей
+    EXPECT_EQ(upstream->get_allocated_blocks_count(), 0);
+}
+
+TEST_F(ThreadCacheResourceTest, LargeAndOveralignedBypassCache)
+{
+    ThreadCacheResource cache(upstream);
+
+    void *large = cache.allocate(100000);
+    void *aligned = cache.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0u);
+    EXPECT_EQ(upstream->get_allocated_blocks_count(), 2);
+
+    cache.deallocate(large, 100000);
+    cache.deallocate(aligned, 64, 64);
+    EXPECT_EQ(upstream->get_allocated_blocks_count(), 0);
+    EXPECT_EQ(cache.get_total_stats().hits + cache.get_total_stats().misses, 0);
+}
+
+TEST_F(ThreadCacheResourceTest, CrossThreadFree)
+{
+    ThreadCacheResource cache(upstream);
+
+    std::vector<void *> blocks;
+    std::thread producer([&]()
+                         {
+                             for (int i = 0; i < 1000; ++i)
+                             {
+                                 blocks.push_back(cache.allocate(32));
+                             }
+                         });
+    producer.join();
+
+    // Освобождаем в другом потоке: блоки попадают в магазин этого потока
+    for (void *ptr : blocks)
+    {
+        cache.deallocate(ptr, 32);
+    }
+
+    void *reused = cache.allocate(32);
+    EXPECT_NE(std::find(blocks.begin(), blocks.end(), reused), blocks.end());
+    cache.deallocate(reused, 32);
+
+    // Кэш завершившегося producer перешёл к текущему потоку
+    auto stats = cache.get_thread_stats();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_EQ(stats[0].thread, std::this_thread::get_id());
+}
+
+TEST_F(ThreadCacheResourceTest, PerThreadStats)
+{
+    ThreadCacheResource cache(upstream);
+
+    auto worker = [&cache]()
+    {
+        for (int round = 0; round < 100; ++round)
+        {
+            DynamicArray<int> arr(&cache);
+            for (int i = 0; i < 100; ++i)
+            {
+                arr.push_back(i);
+            }
+        }
+    };
+
+    std::thread first(worker);
+    first.join();
+    std::thread second(worker);
+    second.join();
+
+    // Кэш завершившегося потока переходит к новому, поэтому записей одна
+    auto stats = cache.get_thread_stats();
+    ASSERT_EQ(stats.size(), 1);
+    EXPECT_GT(stats[0].hit_rate(), 0.9);
+}
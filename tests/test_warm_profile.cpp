@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "custom_memory_resource.h"
+#include "dynamic_array.h"
+#include "warm_profile.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Тесты для WarmProfile и CustomMemoryResource::prewarm
+class WarmProfileTest : public ::testing::Test
+{
+protected:
+    CustomMemoryResource *mr;
+    std::string path;
+
+    void SetUp() override
+    {
+        mr = new CustomMemoryResource();
+        // Усиленный режим (по умолчанию в сборке с LAB5_HARDENED) отключает прогрев
+        mr->set_hardening(HardeningOptions());
+        path = ::testing::TempDir() + "lab5_warm_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".txt";
+    }
+
+    void TearDown() override
+    {
+        delete mr;
+        std::remove(path.c_str());
+    }
+};
+
+TEST_F(WarmProfileTest, AddMergesClasses)
+{
+    WarmProfile profile;
+    profile.add(64, 8, 3);
+    profile.add(64, 8, 2);
+    profile.add(64, 16);
+    profile.add(128, 8, 0);
+
+    std::vector<WarmProfileEntry> entries = profile.entries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].count, 5u);
+    EXPECT_EQ(entries[1].alignment, 16u);
+    EXPECT_EQ(profile.get_blocks_count(), 6u);
+    EXPECT_EQ(profile.get_total_bytes(), 6u * 64u);
+}
+
+TEST_F(WarmProfileTest, SaveLoadRoundTrip)
+{
+    WarmProfile profile;
+    profile.add(24, 8, 100);
+    profile.add(4096, 64, 2);
+    profile.save(path);
+
+    WarmProfile loaded = WarmProfile::load(path);
+    std::vector<WarmProfileEntry> entries = loaded.entries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].size, 24u);
+    EXPECT_EQ(entries[0].count, 100u);
+    EXPECT_EQ(entries[1].size, 4096u);
+    EXPECT_EQ(entries[1].alignment, 64u);
+}
+
+TEST_F(WarmProfileTest, LoadRejectsBadFiles)
+{
+    EXPECT_THROW(WarmProfile::load(path), std::runtime_error);
+
+    {
+        std::ofstream file(path);
+        file << "что-то другое\n";
+    }
+    EXPECT_THROW(WarmProfile::load(path), std::runtime_error);
+
+    {
+        std::ofstream file(path);
+        file << "LAB5WARM 1\n64 3 10\n";
+    }
+    EXPECT_THROW(WarmProfile::load(path), std::runtime_error);
+
+    // size * count переполняет size_t, а сумма двух честных строк превышает предел региона
+    {
+        std::ofstream file(path);
+        file << "LAB5WARM 1\n" << (SIZE_MAX / 2 + 1) << " 8 2\n";
+    }
+    EXPECT_THROW(WarmProfile::load(path), std::runtime_error);
+    {
+        std::ofstream file(path);
+        file << "LAB5WARM 1\n4096 8 " << WarmProfile::kMaxRegionBytes / 4096 << "\n64 8 1\n";
+    }
+    EXPECT_THROW(WarmProfile::load(path), std::runtime_error);
+}
+
+TEST_F(WarmProfileTest, CaptureCountsAllBlocks)
+{
+    void *a = mr->allocate(64, 8);
+    void *b = mr->allocate(64, 8);
+    void *c = mr->allocate(256, 16);
+    mr->deallocate(b, 64, 8);
+
+    std::vector<WarmProfileEntry> entries = mr->capture_warm_profile().entries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].size, 64u);
+    EXPECT_EQ(entries[0].count, 2u);
+    EXPECT_EQ(entries[1].size, 256u);
+    EXPECT_EQ(entries[1].alignment, 16u);
+
+    mr->deallocate(a, 64, 8);
+    mr->deallocate(c, 256, 16);
+}
+
+TEST_F(WarmProfileTest, PrewarmedBlocksServeFirstRequests)
+{
+    WarmProfile profile;
+    profile.add(48, 8, 10);
+    profile.add(1000, 64, 3);
+
+    EXPECT_EQ(mr->prewarm(profile), 13u);
+    EXPECT_EQ(mr->get_free_blocks_count(), 13u);
+    EXPECT_EQ(mr->get_chunks_count(), 1u);
+    const size_t footprint = mr->get_footprint_bytes();
+
+    std::vector<void *> small;
+    for (int i = 0; i < 10; ++i)
+    {
+        small.push_back(mr->allocate(48, 8));
+        std::memset(small.back(), 0xAB, 48);
+    }
+    void *big = mr->allocate(1000, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(big) % 64, 0u);
+
+    EXPECT_EQ(mr->get_reuse_misses(), 0u);
+    EXPECT_EQ(mr->get_footprint_bytes(), footprint);
+
+    for (void *p : small)
+    {
+        mr->deallocate(p, 48, 8);
+    }
+    mr->deallocate(big, 1000, 64);
+}
+
+TEST_F(WarmProfileTest, PrewarmTopsUpOnlyMissingBlocks)
+{
+    void *busy = mr->allocate(32, 8);
+    void *cached = mr->allocate(32, 8);
+    mr->deallocate(cached, 32, 8);
+
+    // Занятый блок первые запросы не обслужит: добираются только свободные
+    WarmProfile profile;
+    profile.add(32, 8, 4);
+    EXPECT_EQ(mr->prewarm(profile), 3u);
+    EXPECT_EQ(mr->prewarm(profile), 0u);
+    EXPECT_EQ(mr->get_free_blocks_count(), 4u);
+
+    mr->deallocate(busy, 32, 8);
+}
+
+TEST_F(WarmProfileTest, PrewarmRejectsHugeProfile)
+{
+    WarmProfile profile;
+    profile.add(64, 8, 1);
+    profile.add(SIZE_MAX / 2 + 1, 8, 2);
+    EXPECT_THROW(mr->prewarm(profile), std::length_error);
+    EXPECT_EQ(mr->get_free_blocks_count(), 0u);
+    EXPECT_EQ(mr->get_footprint_bytes(), 0u);
+}
+
+TEST_F(WarmProfileTest, ProfileFromOneResourceWarmsAnother)
+{
+    {
+        DynamicArray<int> arr(mr);
+        for (int i = 0; i < 1000; ++i)
+        {
+            arr.push_back(i);
+        }
+    }
+    mr->capture_warm_profile().save(path);
+
+    CustomMemoryResource restarted;
+    restarted.set_hardening(HardeningOptions());
+    EXPECT_GT(restarted.prewarm(WarmProfile::load(path)), 0u);
+
+    DynamicArray<int> arr(&restarted);
+    for (int i = 0; i < 1000; ++i)
+    {
+        arr.push_back(i);
+    }
+    EXPECT_EQ(restarted.get_reuse_misses(), 0u);
+}
+
+TEST_F(WarmProfileTest, PrewarmRegionIsChargedAndReleasable)
+{
+    MemoryBudget budget;
+    mr->set_memory_budget(&budget);
+
+    WarmProfile profile;
+    profile.add(100, 8, 50);
+    mr->prewarm(profile);
+    const size_t charged = budget.get_used();
+    EXPECT_GE(charged, 50u * 104u);
+
+    EXPECT_EQ(mr->release_free_blocks(), charged);
+    EXPECT_EQ(budget.get_used(), 0u);
+    EXPECT_EQ(mr->get_chunks_count(), 0u);
+    mr->set_memory_budget(nullptr);
+}
+
+TEST_F(WarmProfileTest, HardenedModeSkipsPrewarm)
+{
+    CustomMemoryResource hardened;
+    hardened.set_hardening(HardeningOptions::full());
+
+    WarmProfile profile;
+    profile.add(64, 8, 10);
+    EXPECT_EQ(hardened.prewarm(profile), 0u);
+    EXPECT_EQ(hardened.get_free_blocks_count(), 0u);
+}